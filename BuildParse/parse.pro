@@ -2,7 +2,7 @@
 # Configuration Settings
 TEMPLATE = lib
 CONFIG += staticlib
-QT += widgets network
+QT += widgets network sql
 QMAKE_CXXFLAGS += -std=c++11
 QMAKE_CXXFLAGS += -stdlib=libc++
 HEADERS = ../Parse/*.h
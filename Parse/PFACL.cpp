@@ -8,6 +8,7 @@
 
 // Parse headers
 #include "PFACL.h"
+#include "PFLogging.h"
 #include "PFUser.h"
 
 // Qt headers
@@ -27,12 +28,12 @@ static bool gDefaultCurrentUserAccess = false;
 
 PFACL::PFACL()
 {
-	qDebug().nospace() << "Created PFACL(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFACL(" << QString().sprintf("%8p", this) << ")";
 }
 
 PFACL::~PFACL()
 {
-	qDebug().nospace() << "Destroyed PFACL(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFACL(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
@@ -0,0 +1,552 @@
+//
+//  PFBinaryEncoding.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFBinaryEncoding.h"
+#include "PFConversion.h"
+
+// Qt headers
+#include <QDateTime>
+#include <QDebug>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QVector>
+#include <QtEndian>
+
+// C++ headers
+#include <cmath>
+#include <cstring>
+
+namespace parse {
+
+namespace PFBinaryEncoding {
+
+// Static Globals
+static const char gMagic[] = { 'P', 'F', 'B' };
+static const int gMagicSize = 3;
+static const int gFormatVersion = 1;
+static const int gMaxDepth = 512;
+static QString gParseDateFormat = "yyyy-MM-ddTHH:mm:ss.zzzZ";
+
+// Value tags
+enum Tag
+{
+	kTagNull = 0,
+	kTagFalse = 1,
+	kTagTrue = 2,
+	kTagInteger = 3,		// zigzag varint
+	kTagDouble = 4,			// 8 byte little endian IEEE 754
+	kTagString = 5,			// string table index
+	kTagArray = 6,			// count, values
+	kTagObject = 7,			// count, (key index, value) pairs
+	kTagDateString = 8,		// zigzag varint msecs since epoch of a parse date string
+	kTagDate = 9,			// {"__type":"Date","iso":...} as zigzag varint msecs since epoch
+	kTagPointer = 10,		// {"__type":"Pointer","className":...,"objectId":...} as two string indexes
+	kTagFile = 11			// {"__type":"File","name":...,"url":...} as two string indexes
+};
+
+#ifdef __APPLE__
+#pragma mark - Encoding Helpers
+#endif
+
+struct Encoder
+{
+	QByteArray				body;
+	QHash<QString, quint32>	stringIndexes;
+	QVector<QString>		strings;
+};
+
+static void writeVarint(QByteArray& data, quint64 value)
+{
+	while (value >= 0x80)
+	{
+		data.append(char((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	data.append(char(value));
+}
+
+static void writeSignedVarint(QByteArray& data, qint64 value)
+{
+	writeVarint(data, (quint64(value) << 1) ^ quint64(value >> 63));
+}
+
+static void writeStringIndex(Encoder& encoder, const QString& string)
+{
+	QHash<QString, quint32>::const_iterator iter = encoder.stringIndexes.constFind(string);
+	if (iter != encoder.stringIndexes.constEnd())
+	{
+		writeVarint(encoder.body, iter.value());
+		return;
+	}
+
+	quint32 index = encoder.strings.size();
+	encoder.stringIndexes.insert(string, index);
+	encoder.strings.append(string);
+	writeVarint(encoder.body, index);
+}
+
+// Parse date strings are only given the compact date form when formatting the msecs gives back the exact string
+static bool parseDateMSecs(const QString& string, qint64& msecs)
+{
+	if (string.size() != 24 || string.at(4) != QChar('-') || string.at(10) != QChar('T') || string.at(23) != QChar('Z'))
+		return false;
+
+	QDateTime dateTime = QDateTime::fromString(string, gParseDateFormat);
+	if (!dateTime.isValid())
+		return false;
+
+	dateTime.setTimeSpec(Qt::UTC);
+	msecs = dateTime.toMSecsSinceEpoch();
+
+	return QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC).toString(gParseDateFormat) == string;
+}
+
+static bool isStringValue(const QJsonObject& jsonObject, const QString& key)
+{
+	return jsonObject.value(key).isString();
+}
+
+static void encodeValue(Encoder& encoder, const QJsonValue& jsonValue);
+
+static void encodeObject(Encoder& encoder, const QJsonObject& jsonObject)
+{
+	// Some PF* class
+	QJsonObject::const_iterator typeIter = jsonObject.constFind("__type");
+	if (typeIter != jsonObject.constEnd() && jsonObject.size() <= 3)
+	{
+		QString objectType = typeIter.value().toString();
+		qint64 msecs = 0;
+		if (objectType == "Date" && jsonObject.size() == 2 && isStringValue(jsonObject, "iso") &&
+			parseDateMSecs(jsonObject.value("iso").toString(), msecs))
+		{
+			encoder.body.append(char(kTagDate));
+			writeSignedVarint(encoder.body, msecs);
+			return;
+		}
+		else if (objectType == "Pointer" && jsonObject.size() == 3 && isStringValue(jsonObject, "className") &&
+				 isStringValue(jsonObject, "objectId"))
+		{
+			encoder.body.append(char(kTagPointer));
+			writeStringIndex(encoder, jsonObject.value("className").toString());
+			writeStringIndex(encoder, jsonObject.value("objectId").toString());
+			return;
+		}
+		else if (objectType == "File" && jsonObject.size() == 3 && isStringValue(jsonObject, "name") &&
+				 isStringValue(jsonObject, "url"))
+		{
+			encoder.body.append(char(kTagFile));
+			writeStringIndex(encoder, jsonObject.value("name").toString());
+			writeStringIndex(encoder, jsonObject.value("url").toString());
+			return;
+		}
+	}
+
+	encoder.body.append(char(kTagObject));
+	writeVarint(encoder.body, jsonObject.size());
+	for (QJsonObject::const_iterator iter = jsonObject.constBegin(); iter != jsonObject.constEnd(); ++iter)
+	{
+		writeStringIndex(encoder, iter.key());
+		encodeValue(encoder, iter.value());
+	}
+}
+
+static void encodeValue(Encoder& encoder, const QJsonValue& jsonValue)
+{
+	switch (jsonValue.type())
+	{
+		case QJsonValue::Bool:
+		{
+			encoder.body.append(char(jsonValue.toBool() ? kTagTrue : kTagFalse));
+			break;
+		}
+		case QJsonValue::Double:
+		{
+			// Integral numbers that a double holds exactly are written as varints (negative zero keeps its sign)
+			double number = jsonValue.toDouble();
+			if (number == std::floor(number) && std::fabs(number) <= 9007199254740992.0 && !(number == 0.0 && std::signbit(number)))
+			{
+				encoder.body.append(char(kTagInteger));
+				writeSignedVarint(encoder.body, qint64(number));
+			}
+			else
+			{
+				quint64 bits;
+				std::memcpy(&bits, &number, sizeof(bits));
+				uchar bytes[8];
+				qToLittleEndian<quint64>(bits, bytes);
+				encoder.body.append(char(kTagDouble));
+				encoder.body.append(reinterpret_cast<const char*>(bytes), 8);
+			}
+			break;
+		}
+		case QJsonValue::String:
+		{
+			QString string = jsonValue.toString();
+			qint64 msecs = 0;
+			if (parseDateMSecs(string, msecs))
+			{
+				encoder.body.append(char(kTagDateString));
+				writeSignedVarint(encoder.body, msecs);
+			}
+			else
+			{
+				encoder.body.append(char(kTagString));
+				writeStringIndex(encoder, string);
+			}
+			break;
+		}
+		case QJsonValue::Array:
+		{
+			QJsonArray jsonArray = jsonValue.toArray();
+			encoder.body.append(char(kTagArray));
+			writeVarint(encoder.body, jsonArray.size());
+			for (QJsonArray::const_iterator iter = jsonArray.constBegin(); iter != jsonArray.constEnd(); ++iter)
+				encodeValue(encoder, *iter);
+			break;
+		}
+		case QJsonValue::Object:
+		{
+			encodeObject(encoder, jsonValue.toObject());
+			break;
+		}
+		default:
+		{
+			encoder.body.append(char(kTagNull));
+			break;
+		}
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Decoding Helpers
+#endif
+
+struct Decoder
+{
+	const uchar*		data;
+	int					size;
+	int					position;
+	QVector<QString>	strings;
+};
+
+static bool readVarint(Decoder& decoder, quint64& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (decoder.position >= decoder.size)
+			return false;
+
+		uchar byte = decoder.data[decoder.position++];
+		value |= quint64(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+static bool readSignedVarint(Decoder& decoder, qint64& value)
+{
+	quint64 zigzag;
+	if (!readVarint(decoder, zigzag))
+		return false;
+
+	value = qint64(zigzag >> 1) ^ -qint64(zigzag & 1);
+	return true;
+}
+
+// Counts are bounded by the remaining bytes since every entry takes at least one byte
+static bool readCount(Decoder& decoder, int& count)
+{
+	quint64 value;
+	if (!readVarint(decoder, value) || value > quint64(decoder.size - decoder.position))
+		return false;
+
+	count = int(value);
+	return true;
+}
+
+static bool readString(Decoder& decoder, QString& string)
+{
+	quint64 index;
+	if (!readVarint(decoder, index) || index >= quint64(decoder.strings.size()))
+		return false;
+
+	string = decoder.strings.at(int(index));
+	return true;
+}
+
+static bool readDateString(Decoder& decoder, QString& string)
+{
+	qint64 msecs;
+	if (!readSignedVarint(decoder, msecs))
+		return false;
+
+	QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+	if (!dateTime.isValid())
+		return false;
+
+	string = dateTime.toString(gParseDateFormat);
+	return true;
+}
+
+static bool decodeValue(Decoder& decoder, QJsonValue& jsonValue, int depth)
+{
+	if (depth > gMaxDepth || decoder.position >= decoder.size)
+		return false;
+
+	uchar tag = decoder.data[decoder.position++];
+	switch (tag)
+	{
+		case kTagNull:
+		{
+			jsonValue = QJsonValue(QJsonValue::Null);
+			return true;
+		}
+		case kTagFalse:
+		case kTagTrue:
+		{
+			jsonValue = QJsonValue(tag == kTagTrue);
+			return true;
+		}
+		case kTagInteger:
+		{
+			qint64 number;
+			if (!readSignedVarint(decoder, number))
+				return false;
+
+			jsonValue = QJsonValue(double(number));
+			return true;
+		}
+		case kTagDouble:
+		{
+			if (decoder.size - decoder.position < 8)
+				return false;
+
+			quint64 bits = qFromLittleEndian<quint64>(decoder.data + decoder.position);
+			decoder.position += 8;
+			double number;
+			std::memcpy(&number, &bits, sizeof(number));
+			jsonValue = QJsonValue(number);
+			return true;
+		}
+		case kTagString:
+		{
+			QString string;
+			if (!readString(decoder, string))
+				return false;
+
+			jsonValue = QJsonValue(string);
+			return true;
+		}
+		case kTagDateString:
+		{
+			QString string;
+			if (!readDateString(decoder, string))
+				return false;
+
+			jsonValue = QJsonValue(string);
+			return true;
+		}
+		case kTagArray:
+		{
+			int count;
+			if (!readCount(decoder, count))
+				return false;
+
+			QJsonArray jsonArray;
+			for (int i = 0; i < count; ++i)
+			{
+				QJsonValue element;
+				if (!decodeValue(decoder, element, depth + 1))
+					return false;
+				jsonArray.append(element);
+			}
+
+			jsonValue = QJsonValue(jsonArray);
+			return true;
+		}
+		case kTagObject:
+		{
+			int count;
+			if (!readCount(decoder, count))
+				return false;
+
+			QJsonObject jsonObject;
+			for (int i = 0; i < count; ++i)
+			{
+				QString key;
+				QJsonValue value;
+				if (!readString(decoder, key) || !decodeValue(decoder, value, depth + 1))
+					return false;
+				jsonObject.insert(key, value);
+			}
+
+			jsonValue = QJsonValue(jsonObject);
+			return true;
+		}
+		case kTagDate:
+		{
+			QString iso;
+			if (!readDateString(decoder, iso))
+				return false;
+
+			QJsonObject jsonObject;
+			jsonObject["__type"] = QString("Date");
+			jsonObject["iso"] = iso;
+			jsonValue = QJsonValue(jsonObject);
+			return true;
+		}
+		case kTagPointer:
+		{
+			QString className, objectId;
+			if (!readString(decoder, className) || !readString(decoder, objectId))
+				return false;
+
+			QJsonObject jsonObject;
+			jsonObject["__type"] = QString("Pointer");
+			jsonObject["className"] = className;
+			jsonObject["objectId"] = objectId;
+			jsonValue = QJsonValue(jsonObject);
+			return true;
+		}
+		case kTagFile:
+		{
+			QString name, url;
+			if (!readString(decoder, name) || !readString(decoder, url))
+				return false;
+
+			QJsonObject jsonObject;
+			jsonObject["__type"] = QString("File");
+			jsonObject["name"] = name;
+			jsonObject["url"] = url;
+			jsonValue = QJsonValue(jsonObject);
+			return true;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Format Methods
+#endif
+
+int formatVersion()
+{
+	return gFormatVersion;
+}
+
+bool isBinaryEncoded(const QByteArray& data)
+{
+	return data.size() > gMagicSize && std::memcmp(data.constData(), gMagic, gMagicSize) == 0;
+}
+
+#ifdef __APPLE__
+#pragma mark - Json Encoding Methods
+#endif
+
+QByteArray encodeJson(const QJsonValue& jsonValue)
+{
+	Encoder encoder;
+	encodeValue(encoder, jsonValue);
+
+	// Header, then the string table, then the value
+	QByteArray data;
+	data.reserve(encoder.body.size() + encoder.strings.size() * 16 + 8);
+	data.append(gMagic, gMagicSize);
+	data.append(char(gFormatVersion));
+	writeVarint(data, encoder.strings.size());
+	for (QVector<QString>::const_iterator iter = encoder.strings.constBegin(); iter != encoder.strings.constEnd(); ++iter)
+	{
+		QByteArray utf8 = iter->toUtf8();
+		writeVarint(data, utf8.size());
+		data.append(utf8);
+	}
+	data.append(encoder.body);
+
+	return data;
+}
+
+bool decodeJson(const QByteArray& data, QJsonValue& jsonValue)
+{
+	if (!isBinaryEncoded(data))
+	{
+		qWarning() << "PFBinaryEncoding::decodeJson failed because the data is missing the binary encoding header";
+		return false;
+	}
+
+	Decoder decoder;
+	decoder.data = reinterpret_cast<const uchar*>(data.constData());
+	decoder.size = data.size();
+	decoder.position = gMagicSize;
+
+	int version = decoder.data[decoder.position++];
+	if (version != gFormatVersion)
+	{
+		qWarning() << "PFBinaryEncoding::decodeJson failed because the data was written with format version" << version;
+		return false;
+	}
+
+	// String table
+	int stringCount;
+	bool succeeded = readCount(decoder, stringCount);
+	if (succeeded)
+	{
+		decoder.strings.reserve(stringCount);
+		for (int i = 0; i < stringCount && succeeded; ++i)
+		{
+			int length;
+			succeeded = readCount(decoder, length);
+			if (succeeded)
+			{
+				decoder.strings.append(QString::fromUtf8(reinterpret_cast<const char*>(decoder.data + decoder.position), length));
+				decoder.position += length;
+			}
+		}
+	}
+
+	// Value (trailing bytes mean the data is corrupt)
+	QJsonValue decodedValue;
+	succeeded = succeeded && decodeValue(decoder, decodedValue, 0) && decoder.position == decoder.size;
+	if (!succeeded)
+	{
+		qWarning() << "PFBinaryEncoding::decodeJson failed because the data is corrupt";
+		return false;
+	}
+
+	jsonValue = decodedValue;
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Variant Encoding Methods
+#endif
+
+QByteArray encodeVariant(const QVariant& variant)
+{
+	return encodeJson(PFConversion::convertVariantToJson(variant));
+}
+
+QVariant decodeVariant(const QByteArray& data)
+{
+	QJsonValue jsonValue;
+	if (!decodeJson(data, jsonValue))
+		return QVariant();
+
+	return PFConversion::convertJsonToVariant(jsonValue);
+}
+
+}	// End of PFBinaryEncoding namespace
+
+}	// End of parse namespace
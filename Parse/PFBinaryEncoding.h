@@ -0,0 +1,44 @@
+//
+//  PFBinaryEncoding.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFBINARYENCODING_H
+#define PARSE_PFBINARYENCODING_H
+
+// Qt headers
+#include <QByteArray>
+#include <QJsonValue>
+#include <QVariant>
+
+namespace parse {
+
+// A compact, versioned binary form of the json the SDK persists locally. Every string (keys as well as values)
+// is written once into a string table at the front and referenced by index afterwards, integral numbers are
+// written as varints, and Date, Pointer and File objects along with createdAt / updatedAt style date strings
+// get tags of their own. Decoding gives back exactly the json that was encoded, so the binary form can be used
+// anywhere the json form is.
+namespace PFBinaryEncoding {
+
+// The version written into the header, decoding fails for data written with any other version
+int formatVersion();
+
+// Returns whether the data starts with the binary encoding header
+bool isBinaryEncoded(const QByteArray& data);
+
+// Json Encoding Methods
+QByteArray encodeJson(const QJsonValue& jsonValue);
+bool decodeJson(const QByteArray& data, QJsonValue& jsonValue);
+
+// Variant Encoding Methods - these go through the PFConversion json conversion (invalid variant on failure)
+QByteArray encodeVariant(const QVariant& variant);
+QVariant decodeVariant(const QByteArray& data);
+
+}	// End of PFBinaryEncoding namespace
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFBINARYENCODING_H
@@ -0,0 +1,159 @@
+//
+//  PFCircuitBreaker.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFCircuitBreaker.h"
+#include "PFLogging.h"
+
+// Qt headers
+#include <QDebug>
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFCircuitBreaker::PFCircuitBreaker()
+{
+	// No-op
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+void PFCircuitBreaker::setRetryPolicy(const PFRetryPolicy& retryPolicy)
+{
+	_retryPolicy = retryPolicy;
+	if (!_retryPolicy.circuitBreakerEnabled())
+		reset();
+}
+
+bool PFCircuitBreaker::allowRequest(const QString& host, qint64 nowMsecs)
+{
+	if (!_retryPolicy.circuitBreakerEnabled())
+		return true;
+
+	QHash<QString, HostState>::iterator iter = _hostStates.find(host);
+	if (iter == _hostStates.end() || iter->state == Closed)
+		return true;
+
+	if (iter->state == Open && nowMsecs - iter->openedMsecs >= _retryPolicy.openDuration())
+	{
+		qCDebug(PFLogManager) << "Circuit for" << host << "is half open, sending a trial request";
+		iter->state = HalfOpen;
+		return true;
+	}
+
+	return false;
+}
+
+void PFCircuitBreaker::recordSuccess(const QString& host)
+{
+	if (!_retryPolicy.circuitBreakerEnabled())
+		return;
+
+	HostState& hostState = _hostStates[host];
+	if (hostState.state == HalfOpen)
+	{
+		qCDebug(PFLogManager) << "Circuit for" << host << "closed";
+		hostState = HostState();
+	}
+	else if (hostState.state == Closed)
+	{
+		recordOutcome(hostState, false);
+	}
+}
+
+void PFCircuitBreaker::recordFailure(const QString& host, qint64 nowMsecs)
+{
+	if (!_retryPolicy.circuitBreakerEnabled())
+		return;
+
+	HostState& hostState = _hostStates[host];
+	if (hostState.state == HalfOpen)
+	{
+		openCircuit(hostState, nowMsecs);
+	}
+	else if (hostState.state == Closed)
+	{
+		recordOutcome(hostState, true);
+		int requestCount = hostState.outcomes.count();
+		if (requestCount >= _retryPolicy.minimumRequestCount() &&
+			hostState.failureCount >= _retryPolicy.failureRateThreshold() * requestCount)
+		{
+			qCDebug(PFLogManager) << "Circuit for" << host << "opened after" << hostState.failureCount << "failures in" << requestCount << "requests";
+			openCircuit(hostState, nowMsecs);
+		}
+	}
+}
+
+void PFCircuitBreaker::recordCanceled(const QString& host)
+{
+	QHash<QString, HostState>::iterator iter = _hostStates.find(host);
+	if (iter != _hostStates.end() && iter->state == HalfOpen)
+		iter->state = Open;
+}
+
+PFCircuitBreaker::State PFCircuitBreaker::stateForHost(const QString& host, qint64 nowMsecs)
+{
+	QHash<QString, HostState>::const_iterator iter = _hostStates.constFind(host);
+	if (iter == _hostStates.constEnd())
+		return Closed;
+
+	// Open circuits that waited long enough let the next request through
+	if (iter->state == Open && nowMsecs - iter->openedMsecs >= _retryPolicy.openDuration())
+		return HalfOpen;
+
+	return iter->state;
+}
+
+void PFCircuitBreaker::reset()
+{
+	_hostStates.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Circuit Helper Methods
+#endif
+
+void PFCircuitBreaker::recordOutcome(HostState& hostState, bool failed)
+{
+	// A policy with a smaller window starts over
+	int windowSize = _retryPolicy.failureWindowSize();
+	if (hostState.outcomes.count() > windowSize)
+		hostState = HostState();
+
+	// Once the window is full the oldest outcome makes room
+	if (hostState.outcomes.count() < windowSize)
+	{
+		hostState.outcomes.append(failed);
+	}
+	else
+	{
+		if (hostState.outcomes.at(hostState.nextIndex))
+			--hostState.failureCount;
+		hostState.outcomes[hostState.nextIndex] = failed;
+		hostState.nextIndex = (hostState.nextIndex + 1) % windowSize;
+	}
+
+	if (failed)
+		++hostState.failureCount;
+}
+
+void PFCircuitBreaker::openCircuit(HostState& hostState, qint64 nowMsecs)
+{
+	hostState.state = Open;
+	hostState.openedMsecs = nowMsecs;
+	hostState.outcomes.clear();
+	hostState.nextIndex = 0;
+	hostState.failureCount = 0;
+}
+
+}	// End of parse namespace
@@ -0,0 +1,86 @@
+//
+//  PFCircuitBreaker.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFCIRCUITBREAKER_H
+#define PARSE_PFCIRCUITBREAKER_H
+
+// Parse headers
+#include "PFRetryPolicy.h"
+
+// Qt headers
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace parse {
+
+// Tracks the outcome of the last requests to every host and decides whether new ones get sent, following the
+// circuit breaker settings of the PFRetryPolicy. Times are msecs on whatever clock the caller uses.
+class PFCircuitBreaker
+{
+public:
+
+	// The states of the circuit of a single host
+	enum State
+	{
+		Closed,		// Requests go through
+		Open,		// Requests fail right away
+		HalfOpen	// A single trial request is on its way
+	};
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Constructor
+	PFCircuitBreaker();
+
+	// Replaces the settings, the recorded outcomes are kept
+	void setRetryPolicy(const PFRetryPolicy& retryPolicy);
+
+	// Returns whether a request to the host can be sent now. Once the open duration passed this lets a single
+	// trial request through, which the caller has to report back with one of the recording methods.
+	bool allowRequest(const QString& host, qint64 nowMsecs);
+
+	// Recording Methods - canceled requests only release the trial request of a half open circuit
+	void recordSuccess(const QString& host);
+	void recordFailure(const QString& host, qint64 nowMsecs);
+	void recordCanceled(const QString& host);
+
+	// Returns the current state of the circuit of the host
+	State stateForHost(const QString& host, qint64 nowMsecs);
+
+	// Closes every circuit and forgets the recorded outcomes
+	void reset();
+
+protected:
+
+	// The circuit of a single host
+	struct HostState
+	{
+		HostState() : state(Closed), nextIndex(0), failureCount(0), openedMsecs(0) {}
+
+		State				state;
+		QVector<bool>		outcomes;		// Ring buffer of the last requests, true for failures
+		int					nextIndex;
+		int					failureCount;
+		qint64				openedMsecs;
+	};
+
+	// Circuit Helper Methods
+	void recordOutcome(HostState& hostState, bool failed);
+	void openCircuit(HostState& hostState, qint64 nowMsecs);
+
+	// Instance members
+	PFRetryPolicy					_retryPolicy;
+	QHash<QString, HostState>		_hostStates;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFCIRCUITBREAKER_H
@@ -21,120 +21,148 @@ namespace parse {
 
 namespace PFConversion {
 
-#ifdef __APPLE__
-#pragma mark - Recursive Conversion Methods
-#endif
+// Container Conversion Helpers - these walk the containers in place with const iterators rather than
+// copying them out of the variants or building key lists first
+static QJsonValue convertVariantListToJson(const QVariantList& variantList)
+{
+	QJsonArray jsonArray;
+	for (QVariantList::const_iterator iter = variantList.constBegin(); iter != variantList.constEnd(); ++iter)
+		jsonArray.append(convertVariantToJson(*iter));
 
-QJsonValue convertVariantToJson(const QVariant& variant)
+	return QJsonValue(jsonArray);
+}
+
+static QJsonValue convertVariantMapToJson(const QVariantMap& variantMap)
 {
-	if ((QMetaType::Type) variant.type() == QMetaType::QVariantList)
-	{
-		QJsonArray jsonArray;
-		foreach (const QVariant& dataObject, variant.toList())
-		{
-			QJsonValue jsonValue = convertVariantToJson(dataObject);
-			jsonArray.append(jsonValue);
-		}
+	QJsonObject jsonObject;
+	for (QVariantMap::const_iterator iter = variantMap.constBegin(); iter != variantMap.constEnd(); ++iter)
+		jsonObject.insert(iter.key(), convertVariantToJson(iter.value()));
 
-		return QJsonValue(jsonArray);
-	}
-	else if ((QMetaType::Type) variant.type() == QMetaType::QVariantMap)
-	{
-		QJsonObject jsonObject;
-		QVariantMap dataMap = variant.toMap();
-		foreach (const QString& key, dataMap.keys())
-		{
-			QVariant dataObject = dataMap[key];
-			jsonObject[key] = convertVariantToJson(dataObject);
-		}
+	return QJsonValue(jsonObject);
+}
 
-		return QJsonValue(jsonObject);
-	}
-	else if ((QMetaType::Type) variant.type() == QMetaType::QVariantHash)
-	{
-		QJsonObject jsonObject;
-		QVariantHash dataHash;
-		foreach (const QString& key, dataHash.keys())
-		{
-			QVariant dataObject = dataHash[key];
-			jsonObject[key] = convertVariantToJson(dataObject);
-		}
+static QJsonValue convertVariantHashToJson(const QVariantHash& variantHash)
+{
+	QJsonObject jsonObject;
+	for (QVariantHash::const_iterator iter = variantHash.constBegin(); iter != variantHash.constEnd(); ++iter)
+		jsonObject.insert(iter.key(), convertVariantToJson(iter.value()));
 
-		return QJsonValue(jsonObject);
-	}
-	else if (variant.canConvert<PFSerializablePtr>())	// PFSerializablePtr
-	{
-		PFSerializablePtr serializable = variant.value<PFSerializablePtr>();
-		QJsonObject jsonObject;
+	return QJsonValue(jsonObject);
+}
+
+static QJsonValue convertSerializableToJson(const PFSerializablePtr& serializable)
+{
+	QJsonObject jsonObject;
+	if (!serializable.isNull())
 		serializable->toJson(jsonObject);
-		return QJsonValue(jsonObject);
-	}
-	else
-	{
-		return QJsonValue::fromVariant(variant);
-	}
+
+	return QJsonValue(jsonObject);
 }
 
-QVariant convertJsonToVariant(const QJsonValue& jsonValue)
+static QVariant convertJsonArrayToVariant(const QJsonArray& jsonArray)
 {
-	if (jsonValue.type() == QJsonValue::Array)
+	QVariantList variantList;
+	variantList.reserve(jsonArray.size());
+	for (QJsonArray::const_iterator iter = jsonArray.constBegin(); iter != jsonArray.constEnd(); ++iter)
+		variantList.append(convertJsonToVariant(*iter));
+
+	return variantList;
+}
+
+static QVariant convertJsonObjectToVariant(const QJsonObject& jsonObject)
+{
+	// Some PF* class
+	QJsonObject::const_iterator typeIter = jsonObject.constFind("__type");
+	if (typeIter != jsonObject.constEnd())
 	{
-		QVariantList variantList;
-		QJsonArray jsonArray = jsonValue.toArray();
-		foreach (const QJsonValue& arrayJsonValue, jsonArray)
+		QString objectType = typeIter.value().toString();
+		if (objectType == "Date")
 		{
-			QVariant arrayVariant = convertJsonToVariant(arrayJsonValue);
-			variantList.append(arrayVariant);
+			return PFDateTime::fromJson(jsonObject);
 		}
-
-		return variantList;
-	}
-	else if (jsonValue.type() == QJsonValue::Object)
-	{
-		QJsonObject jsonObject = jsonValue.toObject();
-		if (jsonObject.contains("__type")) // Some PF* class
+		else if (objectType == "File")
 		{
-			QString objectType = jsonObject["__type"].toString();
-			if (objectType == "Date")
-			{
-				return PFDateTime::fromJson(jsonObject);
-			}
-			else if (objectType == "File")
-			{
-				return PFFile::fromJson(jsonObject);
-			}
-			else if (objectType == "Pointer" || objectType == "Object")
-			{
-				QString className = jsonObject["className"].toString();
-				if (className == "_User")
-				{
-					return PFUser::fromJson(jsonObject);
-				}
-				else
-				{
-					return PFObject::fromJson(jsonObject);
-				}
-			}
+			return PFFile::fromJson(jsonObject);
+		}
+		else if (objectType == "Pointer" || objectType == "Object")
+		{
+			if (jsonObject.value("className").toString() == "_User")
+				return PFUser::fromJson(jsonObject);
 			else
-			{
-				return QVariant();
-			}
+				return PFObject::fromJson(jsonObject);
 		}
-		else // Contains a map of stuff so recursively convert it some more
+		else
 		{
-			QVariantMap variantMap;
-			foreach (const QString& jsonKey, jsonObject.keys())
-			{
-				QJsonValue dictionaryJsonValue = jsonObject[jsonKey];
-				variantMap[jsonKey] = convertJsonToVariant(dictionaryJsonValue);
-			}
-
-			return variantMap;
+			return QVariant();
 		}
 	}
-	else
+
+	// Contains a map of stuff so recursively convert it some more. The json keys are already sorted so
+	// each key gets appended to the end of the map rather than searched for.
+	QVariantMap variantMap;
+	for (QJsonObject::const_iterator iter = jsonObject.constBegin(); iter != jsonObject.constEnd(); ++iter)
+		variantMap.insert(variantMap.constEnd(), iter.key(), convertJsonToVariant(iter.value()));
+
+	return variantMap;
+}
+
+#ifdef __APPLE__
+#pragma mark - Recursive Conversion Methods
+#endif
+
+QJsonValue convertVariantToJson(const QVariant& variant)
+{
+	// Dispatch on the type id once (the switch compiles down to a jump table), the containers are read
+	// straight out of the variant's storage
+	int type = variant.userType();
+	switch (type)
+	{
+		case QMetaType::QVariantList:
+			return convertVariantListToJson(*static_cast<const QVariantList*>(variant.constData()));
+		case QMetaType::QVariantMap:
+			return convertVariantMapToJson(*static_cast<const QVariantMap*>(variant.constData()));
+		case QMetaType::QVariantHash:
+			return convertVariantHashToJson(*static_cast<const QVariantHash*>(variant.constData()));
+		case QMetaType::Bool:
+			return QJsonValue(variant.toBool());
+		case QMetaType::Int:
+		case QMetaType::UInt:
+		case QMetaType::LongLong:
+		case QMetaType::ULongLong:
+		case QMetaType::Double:
+		case QMetaType::Float:
+			return QJsonValue(variant.toDouble());
+		case QMetaType::QString:
+			return QJsonValue(*static_cast<const QString*>(variant.constData()));
+		default:
+			break;
+	}
+
+	// PFSerializablePtr (the meta type id isn't a compile time constant)
+	if (type == qMetaTypeId<PFSerializablePtr>())
+		return convertSerializableToJson(*static_cast<const PFSerializablePtr*>(variant.constData()));
+	else if (variant.canConvert<PFSerializablePtr>())
+		return convertSerializableToJson(variant.value<PFSerializablePtr>());
+
+	return QJsonValue::fromVariant(variant);
+}
+
+QVariant convertJsonToVariant(const QJsonValue& jsonValue)
+{
+	switch (jsonValue.type())
 	{
-		return jsonValue.toVariant();
+		case QJsonValue::Array:
+			return convertJsonArrayToVariant(jsonValue.toArray());
+		case QJsonValue::Object:
+			return convertJsonObjectToVariant(jsonValue.toObject());
+		case QJsonValue::Bool:
+			return QVariant(jsonValue.toBool());
+		case QJsonValue::Double:
+			return QVariant(jsonValue.toDouble());
+		case QJsonValue::String:
+			return QVariant(jsonValue.toString());
+		default:
+			return jsonValue.toVariant();
 	}
 }
 
@@ -142,28 +170,74 @@ QVariant convertJsonToVariant(const QJsonValue& jsonValue)
 #pragma mark - Conversion Methods
 #endif
 
-bool areEqual(const QVariant& variant1, const QVariant& variant2)
+QString equalityKey(const QVariant& variant)
 {
-	// First try the default comparison
-	if (variant1 == variant2)
-		return true;
-
-	// Compare the JSON values if we have serializables
-	PFSerializablePtr serializable1 = variant1.value<PFSerializablePtr>();
-	PFSerializablePtr serializable2 = variant2.value<PFSerializablePtr>();
-	if (!serializable1.isNull() && !serializable2.isNull())
+	// Scalars are tagged with their type so a string never collides with a number or a bool
+	switch (variant.userType())
+	{
+		case QMetaType::UnknownType:
+			return QString("Null");
+		case QMetaType::Bool:
+			return variant.toBool() ? QString("Bool:true") : QString("Bool:false");
+		case QMetaType::Int:
+		case QMetaType::UInt:
+		case QMetaType::LongLong:
+		case QMetaType::ULongLong:
+		case QMetaType::Double:
+		case QMetaType::Float:
+			return QString("Number:") + QString::number(variant.toDouble(), 'g', 17);
+		case QMetaType::QString:
+			return QString("String:") + *static_cast<const QString*>(variant.constData());
+		default:
+			break;
+	}
+
+	// Serializables are keyed by the same fields that identify them in the cloud
+	PFSerializablePtr serializable;
+	if (variant.userType() == qMetaTypeId<PFSerializablePtr>())
+		serializable = *static_cast<const PFSerializablePtr*>(variant.constData());
+	else if (variant.canConvert<PFSerializablePtr>())
+		serializable = variant.value<PFSerializablePtr>();
+
+	if (!serializable.isNull())
 	{
-		// Make sure that they're the same class before converting to JSON
-		if (serializable1->pfClassName() == serializable2->pfClassName())
+		// Unsaved objects and dirty files have no identity in the cloud yet, so they're only ever equal to themselves
+		QString unsavedKey = QString("Unsaved:") + QString::number((quintptr) serializable.data(), 16);
+		const QString pfClassName = serializable->pfClassName();
+		if (pfClassName == "PFObject" || pfClassName == "PFUser")
+		{
+			PFObjectPtr object = serializable.objectCast<PFObject>();
+			if (object->objectId().isEmpty())
+				return unsavedKey;
+			return QString("Pointer:%1:%2").arg(object->className(), object->objectId());
+		}
+		else if (pfClassName == "PFFile")
 		{
-			QJsonObject jsonVariant1, jsonVariant2;
-			serializable1->toJson(jsonVariant1);
-			serializable2->toJson(jsonVariant2);
-			return (jsonVariant1 == jsonVariant2);
+			PFFilePtr file = serializable.objectCast<PFFile>();
+			if (file->isDirty())
+				return unsavedKey;
+			return QString("File:%1:%2").arg(file->name(), file->url());
 		}
+		else if (pfClassName == "PFDateTime")
+		{
+			return QString("Date:") + serializable.objectCast<PFDateTime>()->toParseString();
+		}
+
+		QJsonObject jsonObject;
+		serializable->toJson(jsonObject);
+		return pfClassName + ":" + QString::fromUtf8(QJsonDocument(jsonObject).toJson(QJsonDocument::Compact));
 	}
 
-	return false;
+	// Containers fall back to their compact json representation
+	QJsonArray jsonArray;
+	jsonArray.append(convertVariantToJson(variant));
+	return QString("Json:") + QString::fromUtf8(QJsonDocument(jsonArray).toJson(QJsonDocument::Compact));
+}
+
+bool areEqual(const QVariant& variant1, const QVariant& variant2)
+{
+	// QVariant::operator== converts between types (1 == "1"), the equality keys keep them apart
+	return equalityKey(variant1) == equalityKey(variant2);
 }
 
 }	// End of PFConversion namespace
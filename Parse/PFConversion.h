@@ -11,6 +11,7 @@
 
 // Qt headers
 #include <QJsonValue>
+#include <QString>
 #include <QVariant>
 
 namespace parse {
@@ -21,7 +22,9 @@ namespace PFConversion {
 QJsonValue convertVariantToJson(const QVariant& variant);
 QVariant convertJsonToVariant(const QJsonValue& jsonValue);
 
-// Comparison Methods
+// Comparison Methods - the equality key is a canonical string for the value (a type tag plus the objectId,
+// iso date, url or scalar) so values can be compared through hashed containers instead of pairwise
+QString equalityKey(const QVariant& variant);
 bool areEqual(const QVariant& variant1, const QVariant& variant2);
 
 }	// End of PFConversion namespace
@@ -8,6 +8,7 @@
 
 // Parse headers
 #include "PFDateTime.h"
+#include "PFLogging.h"
 
 namespace parse {
 
@@ -21,12 +22,12 @@ static QString gParseDateFormat = "yyyy-MM-ddTHH:mm:ss.zzzZ";
 PFDateTime::PFDateTime(const QDateTime& dateTime) :
 	_dateTime(dateTime)
 {
-	qDebug().nospace() << "Created PFDateTime(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFDateTime(" << QString().sprintf("%8p", this) << ")";
 }
 
 PFDateTime::~PFDateTime()
 {
-	qDebug().nospace() << "Destroyed PFDateTime(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFDateTime(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
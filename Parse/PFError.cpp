@@ -8,6 +8,7 @@
 
 // Parse headers
 #include "PFError.h"
+#include "PFLogging.h"
 
 // Qt headers
 #include <QDebug>
@@ -68,6 +69,9 @@ extern int const kPFErrorFacebookInvalidSession = 251;
 extern int const kPFErrorInvalidLinkedSession = 251;
 
 extern int const kPFErrorFileDownloadConnectionFailed = 300;
+extern int const kPFErrorFileUploadReadFailed = 301;
+extern int const kPFErrorLocalDatastoreFailed = 302;
+extern int const kPFErrorFileCacheWriteFailed = 303;
 
 namespace parse {
 
@@ -79,12 +83,12 @@ PFError::PFError(int errorCode, const QString& errorMessage) :
 	_errorCode(errorCode),
 	_errorMessage(errorMessage)
 {
-	qDebug().nospace() << "Created PFError(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFError(" << QString().sprintf("%8p", this) << ")";
 }
 
 PFError::~PFError()
 {
-	qDebug().nospace() << "Destroyed PFError(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFError(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
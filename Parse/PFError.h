@@ -126,6 +126,12 @@ extern int const kPFErrorInvalidLinkedSession;
 
 /** Error 300: File download failed due to connection issue */
 extern int const kPFErrorFileDownloadConnectionFailed;
+/** Error 301: File upload failed because the file on disk could not be read */
+extern int const kPFErrorFileUploadReadFailed;
+/** Error 302: The local datastore could not be read or written */
+extern int const kPFErrorLocalDatastoreFailed;
+/** Error 303: File download failed because it could not be written to the cache */
+extern int const kPFErrorFileCacheWriteFailed;
 
 namespace parse {
 
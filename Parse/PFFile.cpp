@@ -9,21 +9,85 @@
 // Parse headers
 #include "PFError.h"
 #include "PFFile.h"
+#include "PFFileCache.h"
+#include "PFImageLoader.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
+#include "PFMimeTypeResolver.h"
+#include "PFTransferManager.h"
+#include "PFUploadIndex.h"
 
 // Qt headers
 #include <QEventLoop>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QMimeDatabase>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QNetworkRequest>
+#include <QRunnable>
+#include <QThreadPool>
 #include <QUrl>
 
 namespace parse {
 
 // Static Globals
 static QString gDefaultName = "parse_file-no_name";
+static const qint64 gDownloadReadBufferSize = 64 * 1024;
+static const int gMaximumDownloadRetries = 3;
+static const int gDownloadRetryDelay = 1000;
+
+// Owns the mapping behind mapped data, the data is released before the memory it points into gets unmapped
+struct PFFileMappedDataDeleter
+{
+	PFFileMappedDataDeleter(QFile* file) : file(file) {}
+
+	void operator()(QByteArray* data)
+	{
+		delete data;
+		delete file;
+	}
+
+	QFile* file;
+};
+
+// Shared between a file and the background task hashing its contents. The file detaches itself when the
+// upload gets cancelled so the task never reports back to a file that's gone.
+struct PFFile::ContentHashRequest
+{
+	QMutex		mutex;
+	PFFile*		file;
+	bool		finished;
+	QString		hash;
+};
+
+// Streams the contents of a file off disk into the upload hash so large files never block the main thread
+class PFFile::ContentHashTask : public QRunnable
+{
+public:
+
+	ContentHashTask(const QString& filepath, QSharedPointer<ContentHashRequest> request) : _filepath(filepath), _request(request) {}
+
+	void run()
+	{
+		QString hash;
+		QFile file(_filepath);
+		if (file.open(QIODevice::ReadOnly))
+			hash = PFUploadIndex::hashForDevice(&file);
+
+		QMutexLocker lock(&_request->mutex);
+		_request->hash = hash;
+		_request->finished = true;
+		if (_request->file)
+			QMetaObject::invokeMethod(_request->file, "handleContentHashed", Qt::QueuedConnection);
+	}
+
+protected:
+
+	QString								_filepath;
+	QSharedPointer<ContentHashRequest>	_request;
+};
 
 #ifdef __APPLE__
 #pragma mark - Memory Management Methods
@@ -31,27 +95,45 @@ static QString gDefaultName = "parse_file-no_name";
 
 PFFile::PFFile()
 {
-	qDebug().nospace() << "Created PFFile(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFFile(" << QString().sprintf("%8p", this) << ")";
 
 	_filepath = "";
 	_mimeType = "";
 	_name = "";
 	_url = "";
 	_data = QByteArrayPtr();
-	_tempDownloadData = QByteArrayPtr();
+	_downloadFile = NULL;
+	_downloadOffset = 0;
+	_downloadRetryCount = 0;
+	_isDataMapped = false;
+	_transferPriority = PFTransferManager::PriorityNormal;
+	_transferGroup = "";
+	_transferProgress = 0.0;
+	_hasPendingTransferProgress = false;
 	_isDirty = false;
 	_isUploading = false;
 	_isDownloading = false;
 	_isDeleting = false;
+	_isLoadingImage = false;
 	_saveReply = NULL;
 	_checkUrlReply = NULL;
 	_getDataReply = NULL;
 	_deleteReply = NULL;
+
+	// Failed downloads get retried after a short delay
+	_downloadRetryTimer.setSingleShot(true);
+	QObject::connect(&_downloadRetryTimer, SIGNAL(timeout()), this, SLOT(handleDownloadRetryTimeout()));
 }
 
 PFFile::~PFFile()
 {
-	qDebug().nospace() << "Destroyed PFFile(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFFile(" << QString().sprintf("%8p", this) << ")";
+
+	// Pull any queued or running transfers (a partial download is left behind to be resumed later)
+	cancel();
+
+	// Mapped data stays around as long as someone still holds on to it (see getSharedData)
+	_data.clear();
 }
 
 #ifdef __APPLE__
@@ -75,8 +157,7 @@ PFFilePtr PFFile::fileWithData(QByteArrayPtr data)
 		file->_isDirty = true;
 
 		// Grab the mime type
-		QMimeDatabase mimeDatabase;
-		QMimeType mimeType = mimeDatabase.mimeTypeForData(*(data.data()));
+		QMimeType mimeType = PFMimeTypeResolver::sharedResolver()->mimeTypeForData(*(data.data()));
 		file->_mimeType = mimeType.filterString();
 
 		// Set the name to upload
@@ -108,8 +189,7 @@ PFFilePtr PFFile::fileWithNameAndData(const QString& name, QByteArrayPtr data)
 		file->_isDirty = true;
 
 		// Grab the mime type
-		QMimeDatabase mimeDatabase;
-		QMimeType mimeType = mimeDatabase.mimeTypeForData(*(data.data()));
+		QMimeType mimeType = PFMimeTypeResolver::sharedResolver()->mimeTypeForData(*(data.data()));
 		file->_mimeType = mimeType.filterString();
 
 		// Set the name to upload
@@ -139,22 +219,16 @@ PFFilePtr PFFile::fileWithNameAndContentsAtPath(const QString& name, const QStri
 		// Mark the file as dirty because it needs to be uploaded
 		file->_isDirty = true;
 
-		// Grab the mime type
-		QMimeDatabase mimeDatabase;
-		QMimeType mimeType = mimeDatabase.mimeTypeForFile(fileInfo);
+		// Grab the mime type from the file extension, only falling back to the header of the file if the
+		// extension is ambiguous. The contents are streamed from disk during the upload so large files
+		// never get loaded into memory.
+		QMimeType mimeType = PFMimeTypeResolver::sharedResolver()->mimeTypeForFile(fileInfo.fileName(), filepath);
 		file->_mimeType = mimeType.filterString();
 
 		// Store the name and filepath
 		file->_name = name;
 		file->_filepath = filepath;
 
-		// Load the data out of the file and store it in data
-		QFile fileData(filepath);
-		fileData.open(QIODevice::ReadOnly);
-		file->_data = QByteArrayPtr(new QByteArray());
-		file->_data->append(fileData.readAll());
-		fileData.close();
-
 		return file;
 	}
 }
@@ -241,6 +315,17 @@ bool PFFile::save(PFErrorPtr& error)
 		return false;
 	}
 
+	// Early out if the file is downloading (a file only runs one transfer at a time)
+	if (_isDownloading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is downloading, save it once the download completes";
+		return false;
+	}
+
+	// Skip the upload entirely if the exact same contents were uploaded before
+	if (reusePreviousUpload())
+		return true;
+
 	// Update the ivar
 	_isUploading = true;
 
@@ -248,8 +333,13 @@ bool PFFile::save(PFErrorPtr& error)
 	QNetworkRequest request = createSaveNetworkRequest();
 
 	// Execute the request and connect the callbacks
-	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	QNetworkReply* networkReply = networkAccessManager->post(request, *(_data.data()));
+	QNetworkReply* networkReply = postSaveNetworkRequest(request);
+	if (!networkReply)
+	{
+		_isUploading = false;
+		error = PFError::errorWithCodeAndMessage(kPFErrorFileUploadReadFailed, "File upload failed because the file could not be opened");
+		return false;
+	}
 
 	// Block the async nature of the request using our own event loop until the reply finishes
 	QEventLoop eventLoop;
@@ -293,24 +383,25 @@ bool PFFile::saveInBackground(QObject *saveProgressTarget, const char *saveProgr
 		return false;
 	}
 
+	// Early out if the file is downloading (a file only runs one transfer at a time)
+	if (_isDownloading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is downloading, save it once the download completes";
+		return false;
+	}
+
 	// Update the ivar
 	_isUploading = true;
 
-	// Create a network request
-	QNetworkRequest request = createSaveNetworkRequest();
-
-	// Execute the request and connect the callbacks
-	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	_saveReply = networkAccessManager->post(request, *(_data.data()));
-	QObject::connect(_saveReply, SIGNAL(uploadProgress(qint64, qint64)), this, SLOT(handleSaveProgressUpdated(qint64, qint64)));
-	QObject::connect(_saveReply, SIGNAL(finished()), this, SLOT(handleSaveCompleted()));
-
 	// Connect the callbacks from this object to the target actions
 	if (saveProgressTarget)
 		QObject::connect(this, SIGNAL(saveProgressUpdated(double)), saveProgressTarget, saveProgressAction);
 	if (saveCompleteTarget)
 		QObject::connect(this, SIGNAL(saveCompleted(bool, PFErrorPtr)), saveCompleteTarget, saveCompleteAction);
 
+	// Queue up the upload, the transfer manager starts it once a slot opens up
+	PFTransferManager::sharedManager()->enqueue(this, true);
+
 	return true;
 }
 
@@ -377,9 +468,27 @@ bool PFFile::checkUrlForFileInBackground(QObject *target, const char *action)
 
 bool PFFile::isDataAvailable()
 {
+	// The source file may have been moved or deleted since the file was created
 	bool isInMemory = !_data.isNull();
-	bool isInCache = QFileInfo(PFManager::sharedManager()->cacheDirectory().filePath(_name)).isFile();
-	return (isInMemory || isInCache);
+	bool isOnDisk = !_filepath.isEmpty() && QFileInfo(_filepath).isFile();
+	bool isInCache = !_url.isEmpty() && PFManager::sharedManager()->fileCache()->contains(cacheKey());
+	return (isInMemory || isOnDisk || isInCache);
+}
+
+QString PFFile::dataFilepath()
+{
+	if (!_filepath.isEmpty() && QFileInfo(_filepath).isFile())
+		return _filepath;
+
+	// Mark the cache entry as recently used so it's the last to be evicted
+	PFFileCache* fileCache = PFManager::sharedManager()->fileCache();
+	if (!_url.isEmpty() && fileCache->contains(cacheKey()))
+	{
+		fileCache->touch(cacheKey());
+		return cacheFilepath();
+	}
+
+	return QString();
 }
 
 QByteArray* PFFile::getData()
@@ -388,13 +497,25 @@ QByteArray* PFFile::getData()
 	if (!_data.isNull())
 		return _data.data();
 
-	// If the data is available, then we need to load it out of the cache
+	// If the data is available, then we need to load it out of the source file or the cache
 	if (isDataAvailable())
 	{
-		QString filepath = PFManager::sharedManager()->cacheDirectory().filePath(_name);
+		// Cached files are never rewritten in place (new data is renamed into place), so it's safe to map them
+		QString filepath = dataFilepath();
+		if (filepath == cacheFilepath() && mapFile(filepath))
+			return _data.data();
+
 		QFile file(filepath);
-		file.open(QIODevice::ReadOnly);
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			// The cached file was removed behind our back so forget about it
+			if (filepath == cacheFilepath())
+				PFManager::sharedManager()->fileCache()->remove(cacheKey());
+			return NULL;
+		}
+
 		_data = QByteArrayPtr(new QByteArray());
+		_isDataMapped = false;
 		_data->append(file.readAll());
 		file.close();
 		return _data.data();
@@ -403,6 +524,19 @@ QByteArray* PFFile::getData()
 	return NULL;
 }
 
+QByteArrayPtr PFFile::getSharedData()
+{
+	if (!getData())
+		return QByteArrayPtr();
+
+	return _data;
+}
+
+bool PFFile::isDataMapped()
+{
+	return (!_data.isNull() && _isDataMapped);
+}
+
 bool PFFile::getDataInBackground(QObject *target, const char *action)
 {
 	return getDataInBackground(0, 0, target, action);
@@ -418,6 +552,13 @@ bool PFFile::getDataInBackground(QObject *getDataProgressTarget, const char *get
 		return false;
 	}
 
+	// Early out if the file is uploading (a file only runs one transfer at a time)
+	if (_isUploading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is uploading, download it once the save completes";
+		return false;
+	}
+
 	// Early out if the file has already been downloaded
 	if (isDataAvailable())
 	{
@@ -428,25 +569,135 @@ bool PFFile::getDataInBackground(QObject *getDataProgressTarget, const char *get
 	// Update the ivar
 	_isDownloading = true;
 
-	// Create a new temp data object to sequentially write the data into
-	_tempDownloadData = QByteArrayPtr(new QByteArray());
+	// Connect the callbacks from this object to the target actions
+	if (getDataProgressTarget)
+		QObject::connect(this, SIGNAL(getDataProgressUpdated(double)), getDataProgressTarget, getDataProgressAction);
+	if (getDataCompleteTarget)
+		QObject::connect(this, SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr)), getDataCompleteTarget, getDataCompleteAction);
 
-	// Create a network request
-	QUrl url = QUrl(_url);
-	QNetworkRequest request(url);
+	// Queue up the download, the transfer manager starts it once a slot opens up
+	PFTransferManager::sharedManager()->enqueue(this, false);
 
-	// Execute the request and connect the callbacks
-	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	_getDataReply = networkAccessManager->get(request);
-	QObject::connect(_getDataReply, SIGNAL(readyRead()), this, SLOT(handleGetDataReadyRead()));
-	QObject::connect(_getDataReply, SIGNAL(downloadProgress(qint64, qint64)), this, SLOT(handleGetDataProgressUpdated(qint64, qint64)));
-	QObject::connect(_getDataReply, SIGNAL(finished()), this, SLOT(handleGetDataCompleted()));
+	return true;
+}
+
+bool PFFile::getDataPathInBackground(QObject *target, const char *action)
+{
+	return getDataPathInBackground(0, 0, target, action);
+}
+
+bool PFFile::getDataPathInBackground(QObject *getDataProgressTarget, const char *getDataProgressAction,
+									 QObject *getDataPathCompleteTarget, const char *getDataPathCompleteAction)
+{
+	// Early out if the file is already downloading
+	if (_isDownloading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is already downloading";
+		return false;
+	}
+
+	// Early out if the file is uploading (a file only runs one transfer at a time)
+	if (_isUploading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is uploading, download it once the save completes";
+		return false;
+	}
+
+	// Early out if the file has already been downloaded
+	if (isDataAvailable())
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is already downloaded, use PFFile::dataFilepath() method instead";
+		return false;
+	}
+
+	// Update the ivar
+	_isDownloading = true;
 
 	// Connect the callbacks from this object to the target actions
 	if (getDataProgressTarget)
 		QObject::connect(this, SIGNAL(getDataProgressUpdated(double)), getDataProgressTarget, getDataProgressAction);
-	if (getDataCompleteTarget)
-		QObject::connect(this, SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr)), getDataCompleteTarget, getDataCompleteAction);
+	if (getDataPathCompleteTarget)
+		QObject::connect(this, SIGNAL(getDataPathCompleted(QString, PFErrorPtr)), getDataPathCompleteTarget, getDataPathCompleteAction);
+
+	// Queue up the download, the transfer manager starts it once a slot opens up
+	PFTransferManager::sharedManager()->enqueue(this, false);
+
+	return true;
+}
+
+bool PFFile::revalidateDataInBackground(QObject *target, const char *action)
+{
+	// Early out if we don't have a url
+	if (_url.isEmpty())
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" does not have a url to revalidate";
+		return false;
+	}
+
+	// Early out if the file is already downloading
+	if (_isDownloading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is already downloading";
+		return false;
+	}
+
+	// Early out if the file is uploading (a file only runs one transfer at a time)
+	if (_isUploading)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is uploading, download it once the save completes";
+		return false;
+	}
+
+	// Update the ivar
+	_isDownloading = true;
+
+	// Connect the callbacks from this object to the target action
+	if (target)
+		QObject::connect(this, SIGNAL(getDataPathCompleted(QString, PFErrorPtr)), target, action);
+
+	// Queue up the download, it turns into a conditional request if the file is in the cache
+	PFTransferManager::sharedManager()->enqueue(this, false);
+
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Get Image Methods
+#endif
+
+bool PFFile::getImageInBackground(QObject *target, const char *action)
+{
+	return getImageInBackground(QSize(), target, action);
+}
+
+bool PFFile::getImageInBackground(const QSize& size, QObject *target, const char *action)
+{
+	// Early out if the image is already loading
+	if (_isLoadingImage)
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" is already loading an image";
+		return false;
+	}
+
+	// Download the data first if we don't have it, the decode starts once it's in the cache
+	bool isDataAvailable = this->isDataAvailable();
+	if (!isDataAvailable && !getDataPathInBackground(this, SLOT(handleImageDataPathCompleted(QString, PFErrorPtr))))
+		return false;
+
+	// Update the ivars
+	_isLoadingImage = true;
+	_imageSize = size;
+
+	// Connect the callbacks from this object to the target action
+	if (target)
+		QObject::connect(this, SIGNAL(getImageCompleted(QImage, PFErrorPtr)), target, action);
+
+	// Hand out the image from the memory cache if it has already been decoded (still asynchronously)
+	QImage image;
+	if (isDataAvailable && PFImageLoader::sharedLoader()->cachedImage(PFImageLoader::keyForImage(imageKey(), size), image))
+		QMetaObject::invokeMethod(this, "finishImageLoad", Qt::QueuedConnection, Q_ARG(QImage, image));
+	else if (isDataAvailable)
+		startImageDecode();
 
 	return true;
 }
@@ -547,26 +798,83 @@ void PFFile::cancel()
 	// Cancel upload if active
 	if (_isUploading)
 	{
-		qDebug() << "Cancelling save operation";
+		qCDebug(PFLogFile) << "Cancelling save operation";
 		disconnect(SIGNAL(saveProgressUpdated(double)));
 		disconnect(SIGNAL(saveCompleted(bool, PFErrorPtr)));
-		_saveReply->disconnect();
-		_saveReply->abort();
-		_saveReply->deleteLater();
+		if (_saveReply)
+		{
+			_saveReply->disconnect();
+			_saveReply->abort();
+			_saveReply->deleteLater();
+			_saveReply = NULL;
+		}
+		if (_contentHashRequest)
+		{
+			QMutexLocker lock(&_contentHashRequest->mutex);
+			_contentHashRequest->file = NULL;
+		}
+		_contentHashRequest.clear();
+		PFTransferManager::sharedManager()->remove(this);
 		_isUploading = false;
 	}
 
 	// Cancel download if active
 	if (_isDownloading)
 	{
-		qDebug() << "Cancelling get data operation";
+		qCDebug(PFLogFile) << "Cancelling get data operation";
 		disconnect(SIGNAL(getDataProgressUpdated(double)));
 		disconnect(SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr)));
-		_getDataReply->disconnect();
-		_getDataReply->abort();
-		_getDataReply->deleteLater();
+		disconnect(SIGNAL(getDataPathCompleted(QString, PFErrorPtr)));
+		if (_getDataReply)
+		{
+			_getDataReply->disconnect();
+			_getDataReply->abort();
+			_getDataReply->deleteLater();
+			_getDataReply = NULL;
+		}
+		// Leave the partial download behind so the next attempt can resume it
+		if (_downloadFile)
+		{
+			delete _downloadFile;
+			_downloadFile = NULL;
+		}
+		_downloadRetryTimer.stop();
+		PFTransferManager::sharedManager()->remove(this);
 		_isDownloading = false;
 	}
+
+	// Cancel image load if active (a decode that's already running just gets ignored)
+	if (_isLoadingImage)
+	{
+		qCDebug(PFLogFile) << "Cancelling get image operation";
+		disconnect(SIGNAL(getImageCompleted(QImage, PFErrorPtr)));
+		_isLoadingImage = false;
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Transfer Scheduling Methods
+#endif
+
+void PFFile::setTransferPriority(int priority)
+{
+	_transferPriority = priority;
+	PFTransferManager::sharedManager()->updatePriority(this);
+}
+
+int PFFile::transferPriority()
+{
+	return _transferPriority;
+}
+
+void PFFile::setTransferGroup(const QString& group)
+{
+	_transferGroup = group;
+}
+
+const QString& PFFile::transferGroup()
+{
+	return _transferGroup;
 }
 
 #ifdef __APPLE__
@@ -609,14 +917,20 @@ const QString PFFile::pfClassName() const
 
 void PFFile::handleSaveProgressUpdated(qint64 bytesSent, qint64 bytesTotal)
 {
+	// Hold on to the latest progress, the transfer manager flushes it out at a fixed rate
 	double percentDone = 100.0;
 	if (bytesSent != bytesTotal)
 		percentDone = ((double) bytesSent / bytesTotal) * 100.0;
-	emit saveProgressUpdated(percentDone);
+	_transferProgress = percentDone;
+	_hasPendingTransferProgress = true;
 }
 
 void PFFile::handleSaveCompleted()
 {
+	// Deliver the final progress and free up the transfer slot
+	flushTransferProgress();
+	PFTransferManager::sharedManager()->remove(this);
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -639,6 +953,7 @@ void PFFile::handleSaveCompleted()
 
 	// Clean up
 	_saveReply->deleteLater();
+	_saveReply = NULL;
 }
 
 #ifdef __APPLE__
@@ -662,22 +977,90 @@ void PFFile::handleCheckUrlForFileCompleted()
 #pragma mark - Protected Get Data Slots
 #endif
 
+void PFFile::handleGetDataMetaDataChanged()
+{
+	// Start over if the server sent the whole file back instead of the range we asked for (the file
+	// changed since the partial download or the server doesn't support ranges)
+	int statusCode = _getDataReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if (_downloadOffset > 0 && statusCode == 200)
+	{
+		qCDebug(PFLogFile).nospace() << "PFFile \"" << _name << "\" could not resume the download, starting over";
+		_downloadFile->resize(0);
+		_downloadOffset = 0;
+	}
+
+	// Hold on to the validators so a failed download can be resumed later on and the cached file can be
+	// revalidated once it's done
+	if (statusCode == 200 || statusCode == 206)
+	{
+		_downloadEtag = QString::fromUtf8(_getDataReply->rawHeader("ETag"));
+		_downloadLastModified = QString::fromUtf8(_getDataReply->rawHeader("Last-Modified"));
+		QJsonObject validatorsObject;
+		validatorsObject["url"] = _url;
+		validatorsObject["etag"] = _downloadEtag;
+		validatorsObject["lastModified"] = _downloadLastModified;
+		QFile validatorsFile(partialDownloadFilepath() + ".json");
+		if (validatorsFile.open(QIODevice::WriteOnly))
+			validatorsFile.write(QJsonDocument(validatorsObject).toJson(QJsonDocument::Compact));
+	}
+}
+
 void PFFile::handleGetDataReadyRead()
 {
-	// Append the data
-	_tempDownloadData->append(_getDataReply->readAll());
+	// Write the chunk straight through to the partial download file (error pages stay out of it)
+	QByteArray chunk = _getDataReply->readAll();
+	int statusCode = _getDataReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if (statusCode == 200 || statusCode == 206)
+		_downloadFile->write(chunk);
 }
 
 void PFFile::handleGetDataProgressUpdated(qint64 bytesSent, qint64 bytesTotal)
 {
+	// Include the bytes we already had from a previous attempt
+	if (bytesTotal > 0)
+	{
+		bytesSent += _downloadOffset;
+		bytesTotal += _downloadOffset;
+	}
+
+	// Hold on to the latest progress, the transfer manager flushes it out at a fixed rate
 	double percentDone = 100.0;
 	if (bytesSent != bytesTotal)
 		percentDone = ((double) bytesSent / bytesTotal) * 100.0;
-	emit getDataProgressUpdated(percentDone);
+	_transferProgress = percentDone;
+	_hasPendingTransferProgress = true;
 }
 
 void PFFile::handleGetDataCompleted()
 {
+	// Flush whatever made it to us before closing the partial download
+	QNetworkReply::NetworkError networkError = _getDataReply->error();
+	int statusCode = _getDataReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if (networkError == QNetworkReply::NoError)
+		_downloadFile->write(_getDataReply->readAll());
+	bool isWriteFailure = (!_downloadFile->flush() || _downloadFile->error() != QFileDevice::NoError);
+	qint64 size = _downloadFile->size();
+	delete _downloadFile;
+	_downloadFile = NULL;
+	_getDataReply->deleteLater();
+	_getDataReply = NULL;
+
+	// Retry connection failures (the next attempt picks up where this one left off). We hold on to the
+	// transfer slot in the meantime.
+	bool isConnectionFailure = (networkError != QNetworkReply::NoError && networkError < QNetworkReply::ContentAccessDenied &&
+								networkError != QNetworkReply::OperationCanceledError);
+	if (isConnectionFailure && _downloadRetryCount < gMaximumDownloadRetries)
+	{
+		++_downloadRetryCount;
+		qCDebug(PFLogFile).nospace() << "PFFile \"" << _name << "\" download failed, retrying (attempt " << _downloadRetryCount << ")";
+		_downloadRetryTimer.start(gDownloadRetryDelay * _downloadRetryCount);
+		return;
+	}
+
+	// Deliver the final progress and free up the transfer slot
+	flushTransferProgress();
+	PFTransferManager::sharedManager()->remove(this);
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -686,34 +1069,154 @@ void PFFile::handleGetDataCompleted()
 	// Update our ivar
 	_isDownloading = false;
 
-	// Extract the JSON payload
-	if (_getDataReply->error() == QNetworkReply::NoError) // SUCCESS
+	// Move the finished download into place in the cache
+	bool success = false;
+	bool isCacheFailure = false;
+	QString partialFilepath = partialDownloadFilepath();
+	PFFileCache* fileCache = PFManager::sharedManager()->fileCache();
+	if (networkError == QNetworkReply::NoError && statusCode == 304) // NOT MODIFIED
 	{
-		// Move the data from the temp download data object to the final data object
-		_data = _tempDownloadData;
-		_tempDownloadData.clear();
-
-		// Write the data out to the cache
-		QString filepath = PFManager::sharedManager()->cacheDirectory().filePath(_name);
-		QFile file(filepath);
-		file.open(QIODevice::WriteOnly);
-		file.write(*(_data.data()));
-		file.close();
+		// The cached file is still current so there's nothing to move
+		QFile::remove(partialFilepath);
+		fileCache->touch(cacheKey());
+		success = true;
+	}
+	else if (networkError == QNetworkReply::NoError && isWriteFailure) // FAILURE
+	{
+		// Some of the data never made it to disk (e.g. the disk is full), so the download has to start over
+		QFile::remove(partialFilepath);
+		QFile::remove(partialFilepath + ".json");
+		isCacheFailure = true;
+	}
+	else if (networkError == QNetworkReply::NoError) // SUCCESS
+	{
+		// Replace a stale cached file (and stop using our mapping of it and the images decoded from it)
+		QFile::remove(partialFilepath + ".json");
+		if (QFile::exists(cacheFilepath()))
+		{
+			if (_isDataMapped)
+			{
+				_data.clear();
+				_isDataMapped = false;
+			}
+			QFile::remove(cacheFilepath());
+			PFImageLoader::sharedLoader()->removeCachedImages(cacheKey());
+			PFFileCache::removePathsInBackground(QStringList() << fileCache->thumbnailDirectoryForKey(cacheKey()));
+		}
+		success = QFile::rename(partialFilepath, cacheFilepath());
+		isCacheFailure = !success;
+
+		// Let the cache know about the new entry so it can keep track of its size and revalidate it later on
+		if (success)
+			fileCache->insert(cacheKey(), size, _downloadEtag, _downloadLastModified);
+	}
+	else if (statusCode == 416 || !QFileInfo(partialFilepath + ".json").isFile()) // FAILURE
+	{
+		// The partial download can't be resumed so there's no point in keeping it around
+		QFile::remove(partialFilepath);
+		QFile::remove(partialFilepath + ".json");
+	}
 
-		emit getDataCompleted(_data.data(), PFErrorPtr());
+	// Notify the targets
+	if (success)
+	{
+		// Only pull the data off disk if someone actually asked for the data rather than the path
+		if (receivers(SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr))) > 0)
+			emit getDataCompleted(getData(), PFErrorPtr());
+		emit getDataPathCompleted(cacheFilepath(), PFErrorPtr());
 	}
-	else // FAILURE
+	else if (isCacheFailure)
+	{
+		// The data made it to us fine, the disk is what failed
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" could not write the download to the cache";
+		int errorCode = kPFErrorFileCacheWriteFailed;
+		QString errorMessage = "File download failed because it could not be written to the cache";
+		PFErrorPtr error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
+		emit getDataCompleted(NULL, error);
+		emit getDataPathCompleted(QString(), error);
+	}
+	else
 	{
 		int errorCode = kPFErrorFileDownloadConnectionFailed;
 		QString errorMessage = "File download connection failed";
-		emit getDataCompleted(NULL, PFError::errorWithCodeAndMessage(errorCode, errorMessage));
+		PFErrorPtr error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
+		emit getDataCompleted(NULL, error);
+		emit getDataPathCompleted(QString(), error);
 	}
 
-	// Disconnect the save completed signal
+	// Disconnect the completed signals
 	this->disconnect(SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr)));
+	this->disconnect(SIGNAL(getDataPathCompleted(QString, PFErrorPtr)));
+}
 
-	// Clean up
-	_getDataReply->deleteLater();
+void PFFile::handleDownloadRetryTimeout()
+{
+	if (_isDownloading)
+		startDownload();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Upload Deduplication Slots
+#endif
+
+void PFFile::handleContentHashed()
+{
+	// Early out if the upload was cancelled in the meantime or this is a stale notification
+	QSharedPointer<ContentHashRequest> request = _contentHashRequest;
+	if (request.isNull() || !_isUploading)
+		return;
+
+	{
+		QMutexLocker lock(&request->mutex);
+		if (!request->finished)
+			return;
+		_contentHash = request->hash;
+	}
+
+	// Go on with the upload even if the file couldn't be hashed, reading it for the upload reports the error
+	_contentHashRequest.clear();
+	continueUpload();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Get Image Slots
+#endif
+
+void PFFile::handleImageDataPathCompleted(QString filepath, PFErrorPtr error)
+{
+	Q_UNUSED(filepath);
+
+	// Early out if the image load was cancelled in the meantime
+	if (!_isLoadingImage)
+		return;
+
+	if (error.isNull())
+	{
+		startImageDecode();
+	}
+	else
+	{
+		_isLoadingImage = false;
+		emit getImageCompleted(QImage(), error);
+		this->disconnect(SIGNAL(getImageCompleted(QImage, PFErrorPtr)));
+	}
+}
+
+void PFFile::finishImageLoad(QImage image)
+{
+	// Early out if the image load was cancelled in the meantime
+	if (!_isLoadingImage)
+		return;
+
+	// Update our ivar
+	_isLoadingImage = false;
+
+	// Emit the signal that the image has been loaded and then disconnect it
+	PFErrorPtr error;
+	if (image.isNull())
+		error = PFError::errorWithCodeAndMessage(kPFErrorInvalidImageData, "File data could not be decoded into an image");
+	emit getImageCompleted(image, error);
+	this->disconnect(SIGNAL(getImageCompleted(QImage, PFErrorPtr)));
 }
 
 #ifdef __APPLE__
@@ -737,6 +1240,290 @@ void PFFile::handleDeleteCompleted()
 	_deleteReply->deleteLater();
 }
 
+#ifdef __APPLE__
+#pragma mark - Cache Helper Methods
+#endif
+
+QString PFFile::cacheKey()
+{
+	// Hash the url once rather than on every availability check
+	if (_cacheKey.isEmpty())
+		_cacheKey = PFFileCache::keyForUrl(_url);
+
+	return _cacheKey;
+}
+
+QString PFFile::cacheFilepath()
+{
+	return PFManager::sharedManager()->fileCache()->filepathForKey(cacheKey());
+}
+
+QString PFFile::contentHash()
+{
+	// Hash the contents once, streaming them off disk if they aren't in memory
+	if (_contentHash.isEmpty())
+	{
+		if (!_data.isNull())
+		{
+			_contentHash = PFUploadIndex::hashForData(*_data);
+		}
+		else if (!_filepath.isEmpty())
+		{
+			QFile file(_filepath);
+			if (file.open(QIODevice::ReadOnly))
+				_contentHash = PFUploadIndex::hashForDevice(&file);
+		}
+	}
+
+	return _contentHash;
+}
+
+void PFFile::hashContentInBackground()
+{
+	_contentHashRequest = QSharedPointer<ContentHashRequest>(new ContentHashRequest());
+	_contentHashRequest->file = this;
+	_contentHashRequest->finished = false;
+	QThreadPool::globalInstance()->start(new ContentHashTask(_filepath, _contentHashRequest));
+}
+
+bool PFFile::reusePreviousUpload()
+{
+	QString hash = contentHash();
+	if (hash.isEmpty())
+		return false;
+
+	QString name;
+	QString url;
+	PFManager* manager = PFManager::sharedManager();
+	if (!manager->uploadIndex()->lookup(manager->applicationId(), hash, _mimeType, name, url))
+		return false;
+
+	qCDebug(PFLogFile).nospace() << "PFFile \"" << _name << "\" was already uploaded as \"" << name << "\", skipping the upload";
+	_name = name;
+	_url = url;
+	_cacheKey.clear();
+	_isDirty = false;
+
+	return true;
+}
+
+bool PFFile::mapFile(const QString& filepath)
+{
+	QFile* file = new QFile(filepath);
+	if (!file->open(QIODevice::ReadOnly) || file->size() == 0)
+	{
+		delete file;
+		return false;
+	}
+
+	uchar* memory = file->map(0, file->size());
+	if (!memory)
+	{
+		delete file;
+		return false;
+	}
+
+	// Wrap the mapped pages without copying them. The mapping lives as long as the last pointer to the data.
+	QByteArray* data = new QByteArray(QByteArray::fromRawData(reinterpret_cast<const char*>(memory), file->size()));
+	_data = QByteArrayPtr(data, PFFileMappedDataDeleter(file));
+	_isDataMapped = true;
+
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Image Helper Methods
+#endif
+
+QString PFFile::imageKey()
+{
+	// Only files backed by a url or a source file can share their images
+	if (!_url.isEmpty())
+		return cacheKey();
+	if (!_filepath.isEmpty())
+		return "file:" + _filepath;
+
+	return QString();
+}
+
+void PFFile::startImageDecode()
+{
+	// Decode straight off disk if we can, otherwise out of the data in memory
+	QString filepath = dataFilepath();
+	QByteArray data;
+	if (filepath.isEmpty() && !_data.isNull())
+		data = *_data;
+
+	// Thumbnails of cached files can be persisted along with the cache entry
+	QString thumbnailPath;
+	if (!_url.isEmpty() && filepath == cacheFilepath() && _imageSize.isValid())
+	{
+		QString thumbnailDirectory = PFManager::sharedManager()->fileCache()->thumbnailDirectoryForKey(cacheKey());
+		thumbnailPath = QString("%1/%2x%3.png").arg(thumbnailDirectory).arg(_imageSize.width()).arg(_imageSize.height());
+	}
+
+	QString key = PFImageLoader::keyForImage(imageKey(), _imageSize);
+	PFImageLoader::sharedLoader()->decodeInBackground(this, key, filepath, data, _imageSize, thumbnailPath);
+}
+
+#ifdef __APPLE__
+#pragma mark - Transfer Helper Methods
+#endif
+
+void PFFile::startTransfer()
+{
+	if (_isUploading)
+	{
+		startUpload();
+	}
+	else if (_isDownloading)
+	{
+		_downloadRetryCount = 0;
+		startDownload();
+	}
+}
+
+void PFFile::flushTransferProgress()
+{
+	if (!_hasPendingTransferProgress)
+		return;
+
+	_hasPendingTransferProgress = false;
+	if (_isUploading)
+		emit saveProgressUpdated(_transferProgress);
+	else if (_isDownloading)
+		emit getDataProgressUpdated(_transferProgress);
+}
+
+void PFFile::startUpload()
+{
+	// Hash the contents of files on disk on a worker thread first, the upload continues once the hash is back
+	if (_contentHash.isEmpty() && _data.isNull() && !_filepath.isEmpty())
+	{
+		hashContentInBackground();
+		return;
+	}
+
+	continueUpload();
+}
+
+void PFFile::continueUpload()
+{
+	// Skip the upload entirely if the exact same contents were uploaded before
+	if (reusePreviousUpload())
+	{
+		PFTransferManager::sharedManager()->remove(this);
+		_isUploading = false;
+		emit saveProgressUpdated(100.0);
+		this->disconnect(SIGNAL(saveProgressUpdated(double)));
+		emit saveCompleted(true, PFErrorPtr());
+		this->disconnect(SIGNAL(saveCompleted(bool, PFErrorPtr)));
+		return;
+	}
+
+	// Create a network request
+	QNetworkRequest request = createSaveNetworkRequest();
+
+	// Execute the request and connect the callbacks
+	_saveReply = postSaveNetworkRequest(request);
+	if (!_saveReply)
+	{
+		PFTransferManager::sharedManager()->remove(this);
+		_isUploading = false;
+		this->disconnect(SIGNAL(saveProgressUpdated(double)));
+
+		PFErrorPtr error = PFError::errorWithCodeAndMessage(kPFErrorFileUploadReadFailed, "File upload failed because the file could not be opened");
+		emit saveCompleted(false, error);
+		this->disconnect(SIGNAL(saveCompleted(bool, PFErrorPtr)));
+		return;
+	}
+
+	QObject::connect(_saveReply, SIGNAL(uploadProgress(qint64, qint64)), this, SLOT(handleSaveProgressUpdated(qint64, qint64)));
+	QObject::connect(_saveReply, SIGNAL(finished()), this, SLOT(handleSaveCompleted()));
+}
+
+QString PFFile::partialDownloadFilepath()
+{
+	return cacheFilepath() + ".partial";
+}
+
+void PFFile::startDownload()
+{
+	// Download into a partial file next to the cache file that only gets moved into place once the download
+	// succeeds. If a previous attempt left one behind, we append to it.
+	QString partialFilepath = partialDownloadFilepath();
+	_downloadFile = new QFile(partialFilepath);
+	if (!_downloadFile->open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _name << "\" could not open the cache file for the download";
+		delete _downloadFile;
+		_downloadFile = NULL;
+
+		PFTransferManager::sharedManager()->remove(this);
+		_isDownloading = false;
+		this->disconnect(SIGNAL(getDataProgressUpdated(double)));
+
+		PFErrorPtr error = PFError::errorWithCodeAndMessage(kPFErrorFileCacheWriteFailed, "File download failed because the cache file could not be opened");
+		emit getDataCompleted(NULL, error);
+		emit getDataPathCompleted(QString(), error);
+		this->disconnect(SIGNAL(getDataCompleted(QByteArray*, PFErrorPtr)));
+		this->disconnect(SIGNAL(getDataPathCompleted(QString, PFErrorPtr)));
+		return;
+	}
+
+	// Create a network request
+	QUrl url = QUrl(_url);
+	QNetworkRequest request(url);
+
+	// Make the request conditional if we're revalidating a cached file, the server answers with a 304 and
+	// no body if it hasn't changed
+	_downloadEtag.clear();
+	_downloadLastModified.clear();
+	QString etag;
+	QString lastModified;
+	if (PFManager::sharedManager()->fileCache()->validatorsForKey(cacheKey(), etag, lastModified))
+	{
+		if (!etag.isEmpty())
+			request.setRawHeader("If-None-Match", etag.toUtf8());
+		if (!lastModified.isEmpty())
+			request.setRawHeader("If-Modified-Since", lastModified.toUtf8());
+	}
+
+	// Ask for the rest of the file if we have a partial download along with the validators it was downloaded
+	// with. The If-Range header makes the server send the whole file instead if it changed in the meantime.
+	_downloadOffset = 0;
+	QFile validatorsFile(partialFilepath + ".json");
+	if (_downloadFile->size() > 0 && validatorsFile.open(QIODevice::ReadOnly))
+	{
+		QJsonObject validatorsObject = QJsonDocument::fromJson(validatorsFile.readAll()).object();
+		QString validator = validatorsObject["etag"].toString();
+		if (validator.isEmpty())
+			validator = validatorsObject["lastModified"].toString();
+
+		if (validatorsObject["url"].toString() == _url && !validator.isEmpty())
+		{
+			_downloadOffset = _downloadFile->size();
+			request.setRawHeader("Range", QString("bytes=%1-").arg(_downloadOffset).toUtf8());
+			request.setRawHeader("If-Range", validator.toUtf8());
+			qCDebug(PFLogFile).nospace() << "PFFile \"" << _name << "\" resuming download at byte " << _downloadOffset;
+		}
+	}
+
+	// Without a way to validate the partial download we have to start from scratch
+	if (_downloadOffset == 0)
+		_downloadFile->resize(0);
+
+	// Execute the request and connect the callbacks. The read buffer is capped so a fast connection
+	// can't pile up more than a chunk in memory before it gets written out to disk.
+	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+	_getDataReply = networkAccessManager->get(request);
+	_getDataReply->setReadBufferSize(gDownloadReadBufferSize);
+	QObject::connect(_getDataReply, SIGNAL(metaDataChanged()), this, SLOT(handleGetDataMetaDataChanged()));
+	QObject::connect(_getDataReply, SIGNAL(readyRead()), this, SLOT(handleGetDataReadyRead()));
+	QObject::connect(_getDataReply, SIGNAL(downloadProgress(qint64, qint64)), this, SLOT(handleGetDataProgressUpdated(qint64, qint64)));
+	QObject::connect(_getDataReply, SIGNAL(finished()), this, SLOT(handleGetDataCompleted()));
+}
+
 #ifdef __APPLE__
 #pragma mark - Network Request Builder Methods
 #endif
@@ -752,11 +1539,49 @@ QNetworkRequest PFFile::createSaveNetworkRequest()
 	return request;
 }
 
+QNetworkReply* PFFile::postSaveNetworkRequest(QNetworkRequest& request)
+{
+	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+
+	// Post the data directly if it's already in memory
+	if (!_data.isNull())
+		return networkAccessManager->post(request, *(_data.data()));
+
+	// Otherwise stream the contents from disk. The network access manager pulls the data out of the
+	// device in small chunks as it sends it, so memory use stays flat regardless of the file size.
+	QFile* uploadFile = new QFile(_filepath);
+	if (!uploadFile->open(QIODevice::ReadOnly))
+	{
+		qWarning().nospace() << "WARNING: PFFile \"" << _filepath << "\" could not be opened for upload";
+		delete uploadFile;
+		return NULL;
+	}
+
+	request.setHeader(QNetworkRequest::ContentLengthHeader, uploadFile->size());
+	QNetworkReply* networkReply = networkAccessManager->post(request, uploadFile);
+
+	// The device needs to stay open until the upload finishes so tie its lifetime to the reply
+	uploadFile->setParent(networkReply);
+
+	return networkReply;
+}
+
 QNetworkRequest PFFile::createCheckUrlForFileNetworkRequest()
 {
 	QUrl url = QUrl(_url);
 	QNetworkRequest request(url);
 
+	// Revalidate the cached file along the way if we have one
+	QString etag;
+	QString lastModified;
+	if (PFManager::sharedManager()->fileCache()->validatorsForKey(cacheKey(), etag, lastModified))
+	{
+		if (!etag.isEmpty())
+			request.setRawHeader("If-None-Match", etag.toUtf8());
+		if (!lastModified.isEmpty())
+			request.setRawHeader("If-Modified-Since", lastModified.toUtf8());
+	}
+
 	return request;
 }
 
@@ -777,7 +1602,7 @@ QNetworkRequest PFFile::createDeleteNetworkRequest()
 bool PFFile::deserializeSaveNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
@@ -785,6 +1610,11 @@ bool PFFile::deserializeSaveNetworkReply(QNetworkReply* networkReply, PFErrorPtr
 	{
 		_url = jsonObject["url"].toString();
 		_name = jsonObject["name"].toString();
+		_cacheKey.clear();
+
+		// Remember the upload so the same contents never have to be sent again
+		PFManager* manager = PFManager::sharedManager();
+		manager->uploadIndex()->insert(manager->applicationId(), contentHash(), _mimeType, _name, _url);
 
 		return true;
 	}
@@ -800,18 +1630,51 @@ bool PFFile::deserializeSaveNetworkReply(QNetworkReply* networkReply, PFErrorPtr
 
 bool PFFile::deserializeCheckUrlForFileNetworkReply(QNetworkReply* networkReply)
 {
-	return (networkReply->error() == QNetworkReply::NoError);
+	if (networkReply->error() != QNetworkReply::NoError)
+		return false;
+
+	// A 304 means the cached file is still current. Otherwise compare the validators ourselves (some servers
+	// ignore conditional HEAD requests) and drop the cached copy if the file changed on the server.
+	PFFileCache* fileCache = PFManager::sharedManager()->fileCache();
+	QString etag;
+	QString lastModified;
+	if (!fileCache->validatorsForKey(cacheKey(), etag, lastModified))
+		return true;
+
+	int statusCode = networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	bool isStale = false;
+	if (statusCode != 304)
+	{
+		if (!etag.isEmpty() && networkReply->hasRawHeader("ETag"))
+			isStale = (QString::fromUtf8(networkReply->rawHeader("ETag")) != etag);
+		else if (!lastModified.isEmpty() && networkReply->hasRawHeader("Last-Modified"))
+			isStale = (QString::fromUtf8(networkReply->rawHeader("Last-Modified")) != lastModified);
+	}
+
+	if (isStale)
+	{
+		qCDebug(PFLogFile).nospace() << "PFFile \"" << _name << "\" changed on the server, dropping the cached copy";
+		fileCache->remove(cacheKey());
+	}
+	else
+	{
+		fileCache->touch(cacheKey());
+	}
+
+	return true;
 }
 
 bool PFFile::deserializeDeleteNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
 	{
+		// The url is gone so it can't be handed out for new uploads anymore
+		PFManager::sharedManager()->uploadIndex()->removeUrl(_url);
 		return true;
 	}
 	else // FAILURE
@@ -14,8 +14,12 @@
 
 // Qt headers
 #include <QFile>
+#include <QImage>
 #include <QNetworkReply>
+#include <QSharedPointer>
+#include <QSize>
 #include <QString>
+#include <QTimer>
 
 namespace parse {
 
@@ -32,6 +36,7 @@ public:
 	// Creation Methods for Upload
 	static PFFilePtr fileWithData(QByteArrayPtr data);
 	static PFFilePtr fileWithNameAndData(const QString& name, QByteArrayPtr data);
+	// NOTE: the contents are streamed from disk when saving rather than being loaded into memory
 	static PFFilePtr fileWithNameAndContentsAtPath(const QString& name, const QString& filepath);
 	static PFFilePtr fileFromVariant(const QVariant& variant);
 
@@ -55,6 +60,7 @@ public:
 	bool save(PFErrorPtr& error);
 
 	// Saves the data asynchronously to the server (use the second method for receiving progress updates).
+	// NOTE: a file only runs one transfer at a time, so saving it while it downloads returns false.
 	//   @param saveProgressTarget The target to be notified when the save progress changes.
 	//   @param saveProgressAction The slot to be notified when the save progress changes - SLOT(saveProgressUpdated(double)).
 	//   @param saveCompleteTarget The target to be notified when the save completes.
@@ -68,7 +74,8 @@ public:
 	//     Check File Methods
 	////////////////////////////////
 
-	// Checks the url synchronously to see if the data exists on the server
+	// Checks the url synchronously to see if the data exists on the server. If the data is cached, the check
+	// doubles as a revalidation and a cached copy that changed on the server gets dropped.
 	bool checkUrlForFile();
 
 	// Checks the url asynchronously to see if the data exists on the server
@@ -81,16 +88,27 @@ public:
 	//     Get Data Methods
 	////////////////////////////////
 
-	// Returns whether the data is available in memory or in the cache.
+	// Returns whether the data is available in memory, in the source file or in the cache (only the source file
+	// is checked on disk, cache lookups never touch the filesystem).
 	// NOTE: if it is not available, then it needs to be downloaded from the server.
 	bool isDataAvailable();
 
-	// Gets the data from memory or from the cache.
+	// Gets the data from memory, from the source file or from the cache.
 	// NOTE: if the data is not available, then this method returns NULL. If this happens,
 	// then use the getDataInBackground() method to download the data from the server.
+	// NOTE: cached data is memory mapped rather than copied, so the data (and any shallow copies
+	// of it) are only valid while the file is alive.
 	QByteArray* getData();
 
+	// Same as getData(), but the returned pointer keeps mapped data alive after the file is gone (shallow
+	// copies of the QByteArray still don't).
+	QByteArrayPtr getSharedData();
+
+	// Returns whether the data in memory is mapped from the cached file rather than copied
+	bool isDataMapped();
+
 	// Gets the data from the server, saves it to the cache then delivers the data to the target slot.
+	// NOTE: a file only runs one transfer at a time, so downloading it while it saves returns false.
 	//   @param getDataProgressTarget The target to be notified when the get data progress changes.
 	//   @param getDataProgressAction The slot to be notified when the get data progress changes - SLOT(getDataProgressUpdated(double)).
 	//   @param getDataCompleteTarget The target to be notified when the get data completes.
@@ -100,6 +118,42 @@ public:
 	bool getDataInBackground(QObject *getDataProgressTarget, const char *getDataProgressAction,
 							 QObject *getDataCompleteTarget, const char *getDataCompleteAction);
 
+	// Gets the data from the server and saves it to the cache without loading it into memory, then delivers
+	// the path of the cached file to the target slot. Use this for large files that should be streamed off disk.
+	//   @param getDataPathCompleteTarget The target to be notified when the get data completes.
+	//   @param getDataPathCompleteAction The slot to be notified when the get data completes - SLOT(getDataPathCompleted(QString, PFErrorPtr)).
+	//   @return True if the async get data process was started, false otherwise.
+	bool getDataPathInBackground(QObject *target = 0, const char *action = 0);
+	bool getDataPathInBackground(QObject *getDataProgressTarget, const char *getDataProgressAction,
+								 QObject *getDataPathCompleteTarget, const char *getDataPathCompleteAction);
+
+	// Returns the path of the file on disk holding the data (the source file if it still exists or the cached
+	// file), or an empty string if the data is not on disk.
+	QString dataFilepath();
+
+	// Checks the cached data against the server with a conditional request (If-None-Match / If-Modified-Since)
+	// and only downloads it again if it changed, then delivers the path of the cached file to the target slot.
+	// If the data isn't cached yet, it simply gets downloaded.
+	// NOTE: if the data changed, data previously returned by getData() is no longer valid.
+	//   @param target The target to be notified when the revalidation completes.
+	//   @param action The slot to be notified when the revalidation completes - SLOT(getDataPathCompleted(QString, PFErrorPtr)).
+	//   @return True if the async revalidation process was started, false otherwise.
+	bool revalidateDataInBackground(QObject *target = 0, const char *action = 0);
+
+	////////////////////////////////
+	//      Get Image Methods
+	////////////////////////////////
+
+	// Decodes the data into an image on a background thread (downloading it first if needed) and delivers
+	// it to the target slot. With a valid size, the image is downscaled to fit it while decoding. Decoded
+	// images are shared through the memory cache of the PFImageLoader.
+	//   @param size The size to fit the image into, or an invalid size for the full size image.
+	//   @param target The target to be notified when the image is ready.
+	//   @param action The slot to be notified when the image is ready - SLOT(getImageCompleted(QImage, PFErrorPtr)).
+	//   @return True if the async image load was started, false otherwise.
+	bool getImageInBackground(QObject *target = 0, const char *action = 0);
+	bool getImageInBackground(const QSize& size, QObject *target, const char *action);
+
 	////////////////////////////////
 	//       Delete Methods
 	////////////////////////////////
@@ -121,6 +175,18 @@ public:
 	// Cancels the current request (whether uploading or downloading the file data
 	void cancel();
 
+	////////////////////////////////
+	//    Transfer Scheduling
+	////////////////////////////////
+
+	// Background uploads and downloads are scheduled by the PFTransferManager. The priority decides which
+	// queued transfers start first (PFTransferManager::Priority, defaults to PriorityNormal) and can be changed
+	// while the transfer is queued. The group lets related transfers be cancelled together.
+	void setTransferPriority(int priority);
+	int transferPriority();
+	void setTransferGroup(const QString& group);
+	const QString& transferGroup();
+
 	//=================================================================================
 	//                                BACKEND API
 	//=================================================================================
@@ -140,9 +206,18 @@ protected slots:
 	void handleCheckUrlForFileCompleted();
 
 	// Get Data Slots
+	void handleGetDataMetaDataChanged();
 	void handleGetDataReadyRead();
 	void handleGetDataProgressUpdated(qint64 bytesSent, qint64 bytesTotal);
 	void handleGetDataCompleted();
+	void handleDownloadRetryTimeout();
+
+	// Upload Deduplication Slots
+	void handleContentHashed();
+
+	// Get Image Slots
+	void handleImageDataPathCompleted(QString filepath, PFErrorPtr error);
+	void finishImageLoad(QImage image);
 
 	// Delete Slots
 	void handleDeleteCompleted();
@@ -159,6 +234,10 @@ signals:
 	// Get Data Signals
 	void getDataProgressUpdated(double percentDone);
 	void getDataCompleted(QByteArray* data, PFErrorPtr error);
+	void getDataPathCompleted(QString filepath, PFErrorPtr error);
+
+	// Get Image Signals
+	void getImageCompleted(QImage image, PFErrorPtr error);
 
 	// Delete Signals
 	void deleteCompleted(bool succeeded, PFErrorPtr error);
@@ -169,8 +248,35 @@ protected:
 	PFFile();
 	~PFFile();
 
+	// Cache Helper Methods
+	QString cacheKey();
+	QString cacheFilepath();
+	QString partialDownloadFilepath();
+	bool mapFile(const QString& filepath);
+
+	// Image Helper Methods (the PFImageLoader hands the decoded images back)
+	friend class PFImageLoader;
+	QString imageKey();
+	void startImageDecode();
+
+	// Upload Deduplication Helper Methods - files on disk get hashed on a worker thread before a background upload
+	struct ContentHashRequest;
+	class ContentHashTask;
+	QString contentHash();
+	void hashContentInBackground();
+	bool reusePreviousUpload();
+
+	// Transfer Helper Methods (called by the PFTransferManager)
+	friend class PFTransferManager;
+	void startTransfer();
+	void flushTransferProgress();
+	void startUpload();
+	void continueUpload();
+	void startDownload();
+
 	// Network Request Builder Methods
 	QNetworkRequest createSaveNetworkRequest();
+	QNetworkReply* postSaveNetworkRequest(QNetworkRequest& request);
 	QNetworkRequest createCheckUrlForFileNetworkRequest();
 	QNetworkRequest createDeleteNetworkRequest();
 
@@ -184,12 +290,27 @@ protected:
 	QString				_mimeType;
 	QString				_name;
 	QString				_url;
+	QString				_cacheKey;
+	QString				_contentHash;
+	QSharedPointer<ContentHashRequest>	_contentHashRequest;
 	QByteArrayPtr		_data;
-	QByteArrayPtr		_tempDownloadData;
+	QFile*				_downloadFile;
+	qint64				_downloadOffset;
+	int					_downloadRetryCount;
+	QTimer				_downloadRetryTimer;
+	QString				_downloadEtag;
+	QString				_downloadLastModified;
+	bool				_isDataMapped;
+	int					_transferPriority;
+	QString				_transferGroup;
+	double				_transferProgress;
+	bool				_hasPendingTransferProgress;
 	bool				_isDirty;
 	bool				_isUploading;
 	bool				_isDownloading;
 	bool				_isDeleting;
+	bool				_isLoadingImage;
+	QSize				_imageSize;
 	QNetworkReply*		_saveReply;
 	QNetworkReply*		_checkUrlReply;
 	QNetworkReply*		_getDataReply;
@@ -0,0 +1,530 @@
+//
+//  PFFileCache.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFFileCache.h"
+#include "PFLogging.h"
+
+// Qt headers
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QPair>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QUuid>
+#include <QVector>
+#include <algorithm>
+
+namespace parse {
+
+// Static Globals
+static const QString gIndexFilename = "index.json";
+static const qint64 gDefaultMaximumSize = 256 * 1024 * 1024;
+static const int gSaveIndexDelay = 1000;
+static const QString gThumbnailDirectoryName = "thumbnails";
+static const QString gTombstoneSuffix = ".deleted-";
+static const QString gPartialDownloadSuffix = ".partial";
+static const qint64 gPartialDownloadMaximumAge = Q_INT64_C(7) * 24 * 60 * 60 * 1000;
+
+// Deletes files and directories off the main thread so eviction never blocks the UI
+class PFFileCacheRemovalTask : public QRunnable
+{
+public:
+
+	PFFileCacheRemovalTask(const QStringList& paths) : _paths(paths) {}
+
+	void run()
+	{
+		foreach (const QString& path, _paths)
+		{
+			QFileInfo fileInfo(path);
+			if (fileInfo.isDir())
+				QDir(path).removeRecursively();
+			else
+				QFile::remove(path);
+		}
+	}
+
+protected:
+
+	QStringList _paths;
+};
+
+// Shared between the cache and the background task loading its index
+struct PFFileCache::IndexLoad
+{
+	QMutex					mutex;
+	QWaitCondition			finishedCondition;
+	bool					finished;
+	bool					changed;
+	QHash<QString, Entry>	entries;
+};
+
+// Reads the index and lists the cache directory off the main thread so startup never waits on the disk
+class PFFileCache::IndexLoadTask : public QRunnable
+{
+public:
+
+	IndexLoadTask(const QDir& directory, QSharedPointer<IndexLoad> indexLoad) : _directory(directory), _indexLoad(indexLoad) {}
+
+	void run()
+	{
+		QHash<QString, Entry> entries;
+		bool changed = PFFileCache::readIndex(_directory, entries);
+
+		QMutexLocker lock(&_indexLoad->mutex);
+		_indexLoad->entries = entries;
+		_indexLoad->changed = changed;
+		_indexLoad->finished = true;
+		_indexLoad->finishedCondition.wakeAll();
+	}
+
+protected:
+
+	QDir						_directory;
+	QSharedPointer<IndexLoad>	_indexLoad;
+};
+
+// Sorts entries from least to most recently used
+static bool lessRecentlyUsed(const QPair<qint64, QString>& left, const QPair<qint64, QString>& right)
+{
+	return left.first < right.first;
+}
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFFileCache::PFFileCache() :
+	_maximumSize(gDefaultMaximumSize),
+	_totalSize(0),
+	_lastAccess(0),
+	_evictionScheduled(false)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFFileCache(" << QString().sprintf("%8p", this) << ")";
+
+	_saveIndexTimer.setSingleShot(true);
+	QObject::connect(&_saveIndexTimer, SIGNAL(timeout()), this, SLOT(handleSaveIndexTimeout()));
+}
+
+PFFileCache::~PFFileCache()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFFileCache(" << QString().sprintf("%8p", this) << ")";
+
+	// Flush any pending index changes
+	if (_saveIndexTimer.isActive())
+		saveIndex();
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFFileCachePtr PFFileCache::fileCacheWithDirectory(const QDir& directory)
+{
+	PFFileCachePtr fileCache = PFFileCachePtr(new PFFileCache(), &QObject::deleteLater);
+	fileCache->_directory = directory;
+	fileCache->_directory.mkpath(fileCache->_directory.absolutePath());
+	fileCache->loadIndexInBackground();
+
+	return fileCache;
+}
+
+QString PFFileCache::keyForUrl(const QString& url)
+{
+	return QString::fromUtf8(QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+#ifdef __APPLE__
+#pragma mark - Entry Methods
+#endif
+
+QString PFFileCache::filepathForKey(const QString& key)
+{
+	return _directory.filePath(key);
+}
+
+QString PFFileCache::thumbnailDirectoryForKey(const QString& key)
+{
+	return _directory.filePath(gThumbnailDirectoryName + "/" + key);
+}
+
+bool PFFileCache::contains(const QString& key)
+{
+	waitForIndex();
+	return _entries.contains(key);
+}
+
+void PFFileCache::touch(const QString& key)
+{
+	waitForIndex();
+	QHash<QString, Entry>::iterator iter = _entries.find(key);
+	if (iter == _entries.end())
+		return;
+
+	iter->lastAccess = nextAccessTime();
+	setNeedsSaveIndex();
+}
+
+void PFFileCache::insert(const QString& key, qint64 size, const QString& etag, const QString& lastModified)
+{
+	waitForIndex();
+	// Replace the existing entry if there is one
+	QHash<QString, Entry>::iterator iter = _entries.find(key);
+	if (iter != _entries.end())
+		_totalSize -= iter->size;
+
+	Entry entry;
+	entry.size = size;
+	entry.lastAccess = nextAccessTime();
+	entry.etag = etag;
+	entry.lastModified = lastModified;
+	_entries.insert(key, entry);
+	_totalSize += size;
+	setNeedsSaveIndex();
+
+	// Coalesce several inserts into a single eviction pass
+	if (_maximumSize > 0 && _totalSize > _maximumSize && !_evictionScheduled)
+	{
+		_evictionScheduled = true;
+		QTimer::singleShot(0, this, SLOT(handleEvictionTimeout()));
+	}
+}
+
+void PFFileCache::remove(const QString& key)
+{
+	waitForIndex();
+	QHash<QString, Entry>::iterator iter = _entries.find(key);
+	if (iter == _entries.end())
+		return;
+
+	_totalSize -= iter->size;
+	_entries.erase(iter);
+	setNeedsSaveIndex();
+
+	removePathsInBackground(QStringList() << filepathForKey(key) << thumbnailDirectoryForKey(key));
+}
+
+bool PFFileCache::validatorsForKey(const QString& key, QString& etag, QString& lastModified)
+{
+	waitForIndex();
+	QHash<QString, Entry>::const_iterator iter = _entries.constFind(key);
+	if (iter == _entries.constEnd() || (iter->etag.isEmpty() && iter->lastModified.isEmpty()))
+		return false;
+
+	etag = iter->etag;
+	lastModified = iter->lastModified;
+	return true;
+}
+
+void PFFileCache::clear()
+{
+	waitForIndex();
+	QStringList filepaths;
+	foreach (const QString& key, _entries.keys())
+		filepaths.append(filepathForKey(key));
+
+	// Partial downloads, leftover tombstones and thumbnails aren't tracked by the index but should go too
+	QStringList untrackedFilters = QStringList() << "*.partial*" << "*" + gTombstoneSuffix + "*";
+	foreach (const QString& filename, _directory.entryList(untrackedFilters, QDir::Files))
+		filepaths.append(_directory.filePath(filename));
+	filepaths.append(_directory.filePath(gThumbnailDirectoryName));
+
+	_entries.clear();
+	_totalSize = 0;
+	setNeedsSaveIndex();
+
+	removePathsInBackground(filepaths);
+}
+
+#ifdef __APPLE__
+#pragma mark - Size Methods
+#endif
+
+void PFFileCache::setMaximumSize(qint64 maximumSize)
+{
+	_maximumSize = qMax(Q_INT64_C(0), maximumSize);
+
+	// Don't block on the index load, the new budget gets applied once the index is loaded
+	if (_indexLoad.isNull())
+		evict();
+}
+
+qint64 PFFileCache::maximumSize()
+{
+	return _maximumSize;
+}
+
+qint64 PFFileCache::totalSize()
+{
+	waitForIndex();
+	return _totalSize;
+}
+
+int PFFileCache::count()
+{
+	waitForIndex();
+	return _entries.count();
+}
+
+bool PFFileCache::isIndexLoaded()
+{
+	if (_indexLoad.isNull())
+		return true;
+
+	QMutexLocker lock(&_indexLoad->mutex);
+	return _indexLoad->finished;
+}
+
+void PFFileCache::evict()
+{
+	waitForIndex();
+	_evictionScheduled = false;
+
+	// Early out if we're within the budget
+	if (_maximumSize == 0 || _totalSize <= _maximumSize)
+		return;
+
+	// Sort the entries from least to most recently used
+	QVector<QPair<qint64, QString> > accessOrder;
+	accessOrder.reserve(_entries.count());
+	for (QHash<QString, Entry>::const_iterator iter = _entries.constBegin(); iter != _entries.constEnd(); ++iter)
+		accessOrder.append(qMakePair(iter->lastAccess, iter.key()));
+	std::sort(accessOrder.begin(), accessOrder.end(), lessRecentlyUsed);
+
+	// Drop entries from the index right away and leave the file deletion to the background
+	QStringList filepaths;
+	int evictedCount = 0;
+	for (; evictedCount < accessOrder.count() && _totalSize > _maximumSize; ++evictedCount)
+	{
+		const QString& key = accessOrder.at(evictedCount).second;
+		_totalSize -= _entries.value(key).size;
+		_entries.remove(key);
+		filepaths.append(filepathForKey(key));
+		filepaths.append(thumbnailDirectoryForKey(key));
+	}
+
+	qCDebug(PFLogFile) << "PFFileCache evicted" << evictedCount << "entries";
+	setNeedsSaveIndex();
+	removePathsInBackground(filepaths);
+
+	// The index doesn't know about partial downloads, so the abandoned ones go whenever space is tight
+	removeStalePartialDownloads(gPartialDownloadMaximumAge);
+}
+
+void PFFileCache::removeStalePartialDownloads(qint64 maximumAge)
+{
+	removeStalePartialDownloadsInDirectory(_directory, maximumAge);
+}
+
+void PFFileCache::saveIndex()
+{
+	waitForIndex();
+	_saveIndexTimer.stop();
+
+	QJsonObject entriesObject;
+	for (QHash<QString, Entry>::const_iterator iter = _entries.constBegin(); iter != _entries.constEnd(); ++iter)
+	{
+		QJsonObject entryObject;
+		entryObject["size"] = static_cast<double>(iter->size);
+		entryObject["lastAccess"] = static_cast<double>(iter->lastAccess);
+		if (!iter->etag.isEmpty())
+			entryObject["etag"] = iter->etag;
+		if (!iter->lastModified.isEmpty())
+			entryObject["lastModified"] = iter->lastModified;
+		entriesObject[iter.key()] = entryObject;
+	}
+
+	QJsonObject rootObject;
+	rootObject["entries"] = entriesObject;
+
+	QSaveFile file(_directory.filePath(gIndexFilename));
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "PFFileCache::saveIndex failed because the index file could not be opened";
+		return;
+	}
+
+	file.write(QJsonDocument(rootObject).toJson(QJsonDocument::Compact));
+	file.commit();
+}
+
+void PFFileCache::removePathsInBackground(const QStringList& paths)
+{
+	// Move the paths out of the way right away so a download writing the same key before the background task
+	// gets to run never has its file deleted. Paths that can't be renamed get deleted in place.
+	QStringList tombstonePaths;
+	foreach (const QString& path, paths)
+	{
+		QFileInfo fileInfo(path);
+		if (!fileInfo.exists())
+			continue;
+
+		QString tombstonePath = path + gTombstoneSuffix + QUuid::createUuid().toString().mid(1, 36);
+		if (QDir().rename(path, tombstonePath))
+			tombstonePaths.append(tombstonePath);
+		else if (fileInfo.isDir())
+			QDir(path).removeRecursively();
+		else
+			QFile::remove(path);
+	}
+
+	if (tombstonePaths.isEmpty())
+		return;
+
+	QThreadPool::globalInstance()->start(new PFFileCacheRemovalTask(tombstonePaths));
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Timer Slots
+#endif
+
+void PFFileCache::handleSaveIndexTimeout()
+{
+	saveIndex();
+}
+
+void PFFileCache::handleEvictionTimeout()
+{
+	evict();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Index Helper Methods
+#endif
+
+void PFFileCache::loadIndexInBackground()
+{
+	_indexLoad = QSharedPointer<IndexLoad>(new IndexLoad());
+	_indexLoad->finished = false;
+	QThreadPool::globalInstance()->start(new IndexLoadTask(_directory, _indexLoad));
+}
+
+void PFFileCache::waitForIndex()
+{
+	// Early out if the index has already been loaded
+	if (_indexLoad.isNull())
+		return;
+
+	// Block until the background load is done. This only ever happens if the cache is used right after
+	// it was created, before the load had a chance to finish.
+	QSharedPointer<IndexLoad> indexLoad = _indexLoad;
+	_indexLoad.clear();
+	QMutexLocker lock(&indexLoad->mutex);
+	while (!indexLoad->finished)
+		indexLoad->finishedCondition.wait(&indexLoad->mutex);
+
+	// Every other method waits for the index before touching the entries, so there's nothing to merge with
+	_entries = indexLoad->entries;
+	for (QHash<QString, Entry>::const_iterator iter = _entries.constBegin(); iter != _entries.constEnd(); ++iter)
+	{
+		_totalSize += iter->size;
+		_lastAccess = qMax(_lastAccess, iter->lastAccess);
+	}
+
+	if (indexLoad->changed)
+		setNeedsSaveIndex();
+
+	// Trim the cache in case the budget shrank since the last run
+	if (_maximumSize > 0 && _totalSize > _maximumSize)
+		evict();
+}
+
+bool PFFileCache::readIndex(const QDir& directory, QHash<QString, Entry>& entries)
+{
+	// Get rid of the downloads that were never resumed
+	removeStalePartialDownloadsInDirectory(directory, gPartialDownloadMaximumAge);
+
+	// Read the index
+	QJsonObject entriesObject;
+	QFile file(directory.filePath(gIndexFilename));
+	if (file.open(QIODevice::ReadOnly))
+	{
+		entriesObject = QJsonDocument::fromJson(file.readAll()).object()["entries"].toObject();
+		file.close();
+	}
+
+	// Reconcile the index with a single listing of the directory. Files missing from the index (from a crash
+	// before it was saved) get picked up and index entries whose files are gone get dropped.
+	bool changed = false;
+	QFileInfoList fileInfos = directory.entryInfoList(QDir::Files);
+	foreach (const QFileInfo& fileInfo, fileInfos)
+	{
+		// Delete tombstones a previous run didn't get to and skip the index and any temporary files left behind
+		// by unfinished downloads
+		QString key = fileInfo.fileName();
+		if (key.contains(gTombstoneSuffix))
+			QFile::remove(fileInfo.absoluteFilePath());
+		if (key == gIndexFilename || key.length() != 40)
+			continue;
+
+		Entry entry;
+		entry.size = fileInfo.size();
+		if (entriesObject.contains(key))
+		{
+			QJsonObject entryObject = entriesObject[key].toObject();
+			entry.lastAccess = static_cast<qint64>(entryObject["lastAccess"].toDouble());
+			entry.etag = entryObject["etag"].toString();
+			entry.lastModified = entryObject["lastModified"].toString();
+		}
+		else
+		{
+			entry.lastAccess = fileInfo.lastModified().toMSecsSinceEpoch();
+			changed = true;
+		}
+
+		entries.insert(key, entry);
+	}
+
+	return (changed || entries.count() != entriesObject.count());
+}
+
+void PFFileCache::removeStalePartialDownloadsInDirectory(const QDir& directory, qint64 maximumAge)
+{
+	// Downloads append to the partial file as the data comes in, so its modification time says when the
+	// download was last running. The validators file only goes along with it.
+	QDateTime now = QDateTime::currentDateTime();
+	QStringList partialFilters = QStringList() << "*" + gPartialDownloadSuffix << "*" + gPartialDownloadSuffix + ".json";
+	foreach (const QFileInfo& fileInfo, directory.entryInfoList(partialFilters, QDir::Files))
+	{
+		QString filepath = fileInfo.absoluteFilePath();
+		QString partialFilepath = filepath;
+		if (partialFilepath.endsWith(".json"))
+			partialFilepath.chop(5);
+
+		QFileInfo partialFileInfo(partialFilepath);
+		QDateTime lastModified = partialFileInfo.exists() ? partialFileInfo.lastModified() : fileInfo.lastModified();
+		if (lastModified.msecsTo(now) < maximumAge)
+			continue;
+
+		qCDebug(PFLogFile) << "PFFileCache removing stale partial download" << fileInfo.fileName();
+		QFile::remove(filepath);
+	}
+}
+
+void PFFileCache::setNeedsSaveIndex()
+{
+	if (!_saveIndexTimer.isActive())
+		_saveIndexTimer.start(gSaveIndexDelay);
+}
+
+qint64 PFFileCache::nextAccessTime()
+{
+	// Keep the access times strictly increasing so entries touched within the same msec still have an order
+	_lastAccess = qMax(QDateTime::currentMSecsSinceEpoch(), _lastAccess + 1);
+	return _lastAccess;
+}
+
+}	// End of parse namespace
@@ -0,0 +1,136 @@
+//
+//  PFFileCache.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFFILECACHE_H
+#define PARSE_PFFILECACHE_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QWaitCondition>
+
+namespace parse {
+
+// Disk cache for downloaded PFFile data. Entries are keyed by a hash of the file url so files with
+// the same name never collide. The size, last access time and http validators of every entry are kept in memory and
+// persisted to an index file, so lookups are hash lookups that never touch the filesystem. The index
+// is loaded on a background thread when the cache is created. Once the total size
+// goes over the byte budget, the least recently used entries are evicted and their files are
+// deleted on a background thread.
+class PFFileCache : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods
+	static PFFileCachePtr fileCacheWithDirectory(const QDir& directory);
+
+	// Returns the cache key for the given url
+	static QString keyForUrl(const QString& url);
+
+	// Entry Methods
+	QString filepathForKey(const QString& key);
+
+	// Directory for files derived from the entry (e.g. decoded thumbnails) that go away along with it. They
+	// don't count towards the maximum size.
+	QString thumbnailDirectoryForKey(const QString& key);
+	bool contains(const QString& key);
+	void touch(const QString& key);
+	void insert(const QString& key, qint64 size, const QString& etag = QString(), const QString& lastModified = QString());
+	void remove(const QString& key);
+	void clear();
+
+	// Returns the ETag and Last-Modified headers the entry was downloaded with (used to revalidate it with the
+	// server), false if the entry doesn't exist or has neither
+	bool validatorsForKey(const QString& key, QString& etag, QString& lastModified);
+
+	// The maximum number of bytes stored in the cache before entries get evicted (0 means unlimited).
+	// Defaults to 256 MB.
+	void setMaximumSize(qint64 maximumSize);
+	qint64 maximumSize();
+	qint64 totalSize();
+	int count();
+
+	// Returns whether the background index load has finished (the other methods wait for it if needed)
+	bool isIndexLoaded();
+
+	// Evicts the least recently used entries until the cache fits in the maximum size
+	void evict();
+
+	// Writes the index out to disk (this normally happens automatically shortly after a change)
+	void saveIndex();
+
+	// Deletes the partial downloads (and the validators saved along with them) that nothing was written to in
+	// the last maximumAge msecs. Downloads abandoned for over a week are deleted when the index is loaded and
+	// whenever entries get evicted.
+	void removeStalePartialDownloads(qint64 maximumAge);
+
+	// Renames the files and directories to unique tombstone names and deletes them on a background thread
+	static void removePathsInBackground(const QStringList& paths);
+
+protected slots:
+
+	// Timer Slots
+	void handleSaveIndexTimeout();
+	void handleEvictionTimeout();
+
+protected:
+
+	// Constructor / Destructor
+	PFFileCache();
+	~PFFileCache();
+
+	// Entry struct
+	struct Entry
+	{
+		qint64 size;
+		qint64 lastAccess;
+		QString etag;
+		QString lastModified;
+	};
+
+	// Background index loading (defined in the implementation)
+	struct IndexLoad;
+	class IndexLoadTask;
+
+	// Index Helper Methods
+	void loadIndexInBackground();
+	void waitForIndex();
+	static bool readIndex(const QDir& directory, QHash<QString, Entry>& entries);
+	static void removeStalePartialDownloadsInDirectory(const QDir& directory, qint64 maximumAge);
+	void setNeedsSaveIndex();
+	qint64 nextAccessTime();
+
+	// Instance members
+	QDir					_directory;
+	QSharedPointer<IndexLoad>	_indexLoad;
+	QHash<QString, Entry>	_entries;
+	qint64					_maximumSize;
+	qint64					_totalSize;
+	qint64					_lastAccess;
+	bool					_evictionScheduled;
+	QTimer					_saveIndexTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFFILECACHE_H
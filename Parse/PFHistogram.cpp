@@ -0,0 +1,176 @@
+//
+//  PFHistogram.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFHistogram.h"
+
+// C++ headers
+#include <cmath>
+
+namespace parse {
+
+// Static Globals
+static const int gSubBucketBits = 6;
+static const qint64 gSubBucketCount = Q_INT64_C(1) << gSubBucketBits;
+static const qint64 gSubBucketHalfCount = gSubBucketCount / 2;
+static const int gTrackableBits = 40;
+static const qint64 gMaximumTrackableValue = (Q_INT64_C(1) << gTrackableBits) - 1;
+static const int gBucketCount = int(gSubBucketCount + (gTrackableBits - gSubBucketBits) * gSubBucketHalfCount);
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFHistogram::PFHistogram() :
+	_count(0),
+	_minimum(0),
+	_maximum(0),
+	_total(0.0)
+{
+	// No-op
+}
+
+#ifdef __APPLE__
+#pragma mark - Recording Methods
+#endif
+
+void PFHistogram::record(qint64 value)
+{
+	value = qBound(Q_INT64_C(0), value, gMaximumTrackableValue);
+	if (_counts.isEmpty())
+		_counts.fill(0, gBucketCount);
+
+	++_counts[bucketIndexForValue(value)];
+	_minimum = (_count == 0) ? value : qMin(_minimum, value);
+	_maximum = (_count == 0) ? value : qMax(_maximum, value);
+	_total += value;
+	++_count;
+}
+
+void PFHistogram::merge(const PFHistogram& histogram)
+{
+	if (histogram._count == 0)
+		return;
+
+	if (_counts.isEmpty())
+		_counts.fill(0, gBucketCount);
+
+	for (int i = 0; i < gBucketCount; ++i)
+		_counts[i] += histogram._counts.at(i);
+
+	_minimum = (_count == 0) ? histogram._minimum : qMin(_minimum, histogram._minimum);
+	_maximum = (_count == 0) ? histogram._maximum : qMax(_maximum, histogram._maximum);
+	_total += histogram._total;
+	_count += histogram._count;
+}
+
+void PFHistogram::reset()
+{
+	_counts.clear();
+	_count = 0;
+	_minimum = 0;
+	_maximum = 0;
+	_total = 0.0;
+}
+
+#ifdef __APPLE__
+#pragma mark - Statistics Methods
+#endif
+
+qint64 PFHistogram::count() const
+{
+	return _count;
+}
+
+qint64 PFHistogram::minimum() const
+{
+	return _minimum;
+}
+
+qint64 PFHistogram::maximum() const
+{
+	return _maximum;
+}
+
+double PFHistogram::mean() const
+{
+	if (_count == 0)
+		return 0.0;
+
+	return _total / _count;
+}
+
+qint64 PFHistogram::valueAtPercentile(double percentile) const
+{
+	if (_count == 0)
+		return 0;
+
+	// Walk the buckets until the running count reaches the rank of the percentile
+	percentile = qBound(0.0, percentile, 100.0);
+	qint64 rank = qMax(Q_INT64_C(1), qint64(std::ceil(percentile / 100.0 * _count)));
+	qint64 runningCount = 0;
+	for (int i = 0; i < gBucketCount; ++i)
+	{
+		runningCount += _counts.at(i);
+		if (runningCount >= rank)
+			return qBound(_minimum, highestValueForBucket(i), _maximum);
+	}
+
+	return _maximum;
+}
+
+#ifdef __APPLE__
+#pragma mark - Bucket Methods
+#endif
+
+qint64 PFHistogram::maximumTrackableValue()
+{
+	return gMaximumTrackableValue;
+}
+
+int PFHistogram::bucketCount()
+{
+	return gBucketCount;
+}
+
+int PFHistogram::bucketIndexForValue(qint64 value)
+{
+	value = qBound(Q_INT64_C(0), value, gMaximumTrackableValue);
+	if (value < gSubBucketCount)
+		return int(value);
+
+	// Each power of two past the linear range gets half the sub buckets, addressed by the top bits of the value
+	int highestBit = gSubBucketBits;
+	while ((value >> (highestBit + 1)) != 0)
+		++highestBit;
+
+	int shift = highestBit - gSubBucketBits + 1;
+	qint64 subBucket = value >> shift;
+	return int(gSubBucketCount + (shift - 1) * gSubBucketHalfCount + (subBucket - gSubBucketHalfCount));
+}
+
+qint64 PFHistogram::lowestValueForBucket(int index)
+{
+	if (index < gSubBucketCount)
+		return index;
+
+	qint64 offset = index - gSubBucketCount;
+	int shift = int(offset / gSubBucketHalfCount) + 1;
+	qint64 subBucket = offset % gSubBucketHalfCount + gSubBucketHalfCount;
+	return subBucket << shift;
+}
+
+qint64 PFHistogram::highestValueForBucket(int index)
+{
+	if (index < gSubBucketCount)
+		return index;
+
+	return lowestValueForBucket(index + 1) - 1;
+}
+
+}	// End of parse namespace
@@ -0,0 +1,65 @@
+//
+//  PFHistogram.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFHISTOGRAM_H
+#define PARSE_PFHISTOGRAM_H
+
+// Qt headers
+#include <QVector>
+
+namespace parse {
+
+// A log-linear (HDR style) histogram of non-negative integer values such as latencies in microseconds. Values
+// below 64 get a bucket each, above that every power of two is split into 32 buckets, so any recorded value is
+// reported within about 3% while the whole range up to 2^40 only takes around a thousand counters. The
+// counters are allocated with the first recorded value so unused histograms cost next to nothing.
+class PFHistogram
+{
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Constructor
+	PFHistogram();
+
+	// Recording Methods - negative values are recorded as 0 and values past the range as the largest value
+	void record(qint64 value);
+	void merge(const PFHistogram& histogram);
+	void reset();
+
+	// Statistics Methods (all 0 for an empty histogram)
+	qint64 count() const;
+	qint64 minimum() const;
+	qint64 maximum() const;
+	double mean() const;
+
+	// Returns the highest value equivalent to the value at the percentile (0 - 100), clamped to the maximum
+	qint64 valueAtPercentile(double percentile) const;
+
+	// Bucket Methods
+	static qint64 maximumTrackableValue();
+	static int bucketCount();
+	static int bucketIndexForValue(qint64 value);
+	static qint64 lowestValueForBucket(int index);
+	static qint64 highestValueForBucket(int index);
+
+protected:
+
+	// Instance members
+	QVector<qint64>		_counts;
+	qint64				_count;
+	qint64				_minimum;
+	qint64				_maximum;
+	double				_total;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFHISTOGRAM_H
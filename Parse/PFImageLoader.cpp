@@ -0,0 +1,229 @@
+//
+//  PFImageLoader.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFFile.h"
+#include "PFImageLoader.h"
+
+// Qt headers
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+
+namespace parse {
+
+// Static Globals
+static QMutex gPFImageLoaderMutex;
+static const int gDefaultMaximumCacheSize = 32 * 1024 * 1024;
+
+// Decodes a single image on the loader's thread pool and posts the result back to the loader
+class PFImageLoader::DecodeTask : public QRunnable
+{
+public:
+
+	DecodeTask(PFImageLoader* loader, quint64 requestId, const QString& key, const QString& filepath,
+			   const QByteArray& data, const QSize& size, const QString& thumbnailPath) :
+		_loader(loader), _requestId(requestId), _key(key), _filepath(filepath), _data(data), _size(size),
+		_thumbnailPath(thumbnailPath)
+	{}
+
+	void run()
+	{
+		// Use the persisted thumbnail if we already have one
+		QImage image;
+		if (!_thumbnailPath.isEmpty() && QFileInfo(_thumbnailPath).isFile())
+			image.load(_thumbnailPath);
+
+		if (image.isNull())
+		{
+			image = decode();
+
+			// Hold on to the scaled image so it never has to be decoded again
+			if (!image.isNull() && !_thumbnailPath.isEmpty())
+			{
+				QDir().mkpath(QFileInfo(_thumbnailPath).absolutePath());
+				QSaveFile thumbnailFile(_thumbnailPath);
+				if (thumbnailFile.open(QIODevice::WriteOnly) && image.save(&thumbnailFile, "PNG"))
+					thumbnailFile.commit();
+			}
+		}
+
+		QMetaObject::invokeMethod(_loader, "handleImageDecoded", Qt::QueuedConnection, Q_ARG(quint64, _requestId),
+								  Q_ARG(QString, _key), Q_ARG(QImage, image));
+	}
+
+protected:
+
+	QImage decode()
+	{
+		QBuffer buffer(&_data);
+		QImageReader reader;
+		if (_filepath.isEmpty())
+			reader.setDevice(&buffer);
+		else
+			reader.setFileName(_filepath);
+
+		// Let the reader do the downscaling so the full size image never gets decoded (never scale up though)
+		QSize imageSize = reader.size();
+		if (_size.isValid() && imageSize.isValid() && (imageSize.width() > _size.width() || imageSize.height() > _size.height()))
+			reader.setScaledSize(imageSize.scaled(_size, Qt::KeepAspectRatio));
+
+		QImage image = reader.read();
+		if (image.isNull())
+			qWarning() << "PFImageLoader failed to decode the image:" << reader.errorString();
+
+		return image;
+	}
+
+	PFImageLoader*	_loader;
+	quint64			_requestId;
+	QString			_key;
+	QString			_filepath;
+	QByteArray		_data;
+	QSize			_size;
+	QString			_thumbnailPath;
+};
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFImageLoader::PFImageLoader() :
+	_nextRequestId(0),
+	_persistsThumbnails(false)
+{
+	_memoryCache.setMaxCost(gDefaultMaximumCacheSize);
+}
+
+PFImageLoader::~PFImageLoader()
+{
+	_threadPool.waitForDone();
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFImageLoader* PFImageLoader::sharedLoader()
+{
+	QMutexLocker lock(&gPFImageLoaderMutex);
+	static PFImageLoader loader;
+	return &loader;
+}
+
+#ifdef __APPLE__
+#pragma mark - Cache Methods
+#endif
+
+void PFImageLoader::setMaximumCacheSize(int maximumCacheSize)
+{
+	_memoryCache.setMaxCost(qMax(0, maximumCacheSize));
+}
+
+int PFImageLoader::maximumCacheSize()
+{
+	return _memoryCache.maxCost();
+}
+
+void PFImageLoader::setPersistsThumbnails(bool persistsThumbnails)
+{
+	_persistsThumbnails = persistsThumbnails;
+}
+
+bool PFImageLoader::persistsThumbnails()
+{
+	return _persistsThumbnails;
+}
+
+void PFImageLoader::setMaximumConcurrentDecodes(int maximumConcurrentDecodes)
+{
+	_threadPool.setMaxThreadCount(qMax(1, maximumConcurrentDecodes));
+}
+
+int PFImageLoader::maximumConcurrentDecodes()
+{
+	return _threadPool.maxThreadCount();
+}
+
+void PFImageLoader::clearMemoryCache()
+{
+	_memoryCache.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API - Memory Cache Methods
+#endif
+
+QString PFImageLoader::keyForImage(const QString& fileKey, const QSize& size)
+{
+	if (fileKey.isEmpty())
+		return QString();
+
+	if (!size.isValid())
+		return fileKey;
+
+	return QString("%1@%2x%3").arg(fileKey).arg(size.width()).arg(size.height());
+}
+
+bool PFImageLoader::cachedImage(const QString& key, QImage& image)
+{
+	// Looking the image up marks it as the most recently used one
+	QImage* cachedImage = key.isEmpty() ? NULL : _memoryCache.object(key);
+	if (!cachedImage)
+		return false;
+
+	image = *cachedImage;
+	return true;
+}
+
+void PFImageLoader::removeCachedImages(const QString& fileKey)
+{
+	// Drops the images of the file at every size
+	foreach (const QString& key, _memoryCache.keys())
+	{
+		if (key == fileKey || key.startsWith(fileKey + "@"))
+			_memoryCache.remove(key);
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API - Decode Methods
+#endif
+
+void PFImageLoader::decodeInBackground(PFFile* file, const QString& key, const QString& filepath, const QByteArray& data,
+									   const QSize& size, const QString& thumbnailPath)
+{
+	quint64 requestId = _nextRequestId++;
+	_requests.insert(requestId, QPointer<PFFile>(file));
+	QString persistedThumbnailPath = (_persistsThumbnails && size.isValid()) ? thumbnailPath : QString();
+	_threadPool.start(new DecodeTask(this, requestId, key, filepath, data, size, persistedThumbnailPath));
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Decode Slots
+#endif
+
+void PFImageLoader::handleImageDecoded(quint64 requestId, QString key, QImage image)
+{
+	// Share the decoded image with anyone else asking for it
+	if (!image.isNull() && !key.isEmpty())
+		_memoryCache.insert(key, new QImage(image), image.byteCount());
+
+	// The file might have gone away while we were decoding
+	QPointer<PFFile> file = _requests.take(requestId);
+	if (file)
+		file->finishImageLoad(image);
+}
+
+}	// End of parse namespace
@@ -0,0 +1,100 @@
+//
+//  PFImageLoader.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFIMAGELOADER_H
+#define PARSE_PFIMAGELOADER_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+namespace parse {
+
+// Decodes PFFile images off the GUI thread (see PFFile::getImageInBackground). Images are decoded on a
+// dedicated thread pool, optionally downscaled while decoding (so a thumbnail never decodes the full
+// image), and kept in a bounded in-memory LRU cache. Thumbnails of cached files can also be persisted
+// next to the cached file so reopening them skips both the download and the decode.
+class PFImageLoader : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Creates a singleton instance of the PFImageLoader
+	static PFImageLoader* sharedLoader();
+
+	// The maximum number of bytes of decoded images kept in memory. Defaults to 32 MB.
+	void setMaximumCacheSize(int maximumCacheSize);
+	int maximumCacheSize();
+
+	// Whether scaled images of cached files are written to disk as well. Defaults to false.
+	void setPersistsThumbnails(bool persistsThumbnails);
+	bool persistsThumbnails();
+
+	// The number of images decoded at the same time. Defaults to the number of cores.
+	void setMaximumConcurrentDecodes(int maximumConcurrentDecodes);
+	int maximumConcurrentDecodes();
+
+	// Empties the in-memory cache
+	void clearMemoryCache();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Returns the key of an image in the memory cache (the size is part of it)
+	static QString keyForImage(const QString& fileKey, const QSize& size);
+
+	// Memory Cache Methods
+	bool cachedImage(const QString& key, QImage& image);
+	void removeCachedImages(const QString& fileKey);
+
+	// Decodes the image out of the file on disk (or the data if there is no file) on the thread pool and
+	// hands the result back to the PFFile. An empty thumbnail path means the result isn't persisted.
+	void decodeInBackground(PFFile* file, const QString& key, const QString& filepath, const QByteArray& data,
+							const QSize& size, const QString& thumbnailPath);
+
+protected slots:
+
+	// Decode Slots
+	void handleImageDecoded(quint64 requestId, QString key, QImage image);
+
+protected:
+
+	// Constructor / Destructor
+	PFImageLoader();
+	~PFImageLoader();
+
+	// Decode task (defined in the implementation)
+	class DecodeTask;
+
+	// Instance members
+	QCache<QString, QImage>				_memoryCache;
+	QHash<quint64, QPointer<PFFile> >	_requests;
+	quint64								_nextRequestId;
+	bool								_persistsThumbnails;
+	QThreadPool							_threadPool;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFIMAGELOADER_H
@@ -0,0 +1,920 @@
+//
+//  PFLocalDatastore.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFBinaryEncoding.h"
+#include "PFConversion.h"
+#include "PFError.h"
+#include "PFLocalDatastore.h"
+#include "PFLogging.h"
+#include "PFObject.h"
+
+// Qt headers
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSqlError>
+#include <QSqlQuery>
+
+// Std headers
+#include <algorithm>
+
+namespace parse {
+
+// Static Globals
+static const QString gDatabaseFilename = "datastore.sqlite";
+static const QString gDefaultPinName = "_default";
+static const int gMaximumIndexedInValues = 500; // Stays well under the SQLite bound parameter limit
+
+// Creates a local datastore error out of the message
+static PFErrorPtr datastoreError(const QString& message)
+{
+	return PFError::errorWithCodeAndMessage(kPFErrorLocalDatastoreFailed, message);
+}
+
+// Objects are stored in the binary encoding, rows written before it existed are still read as json text
+static QJsonObject jsonObjectFromBlob(const QByteArray& blob)
+{
+	if (!PFBinaryEncoding::isBinaryEncoded(blob))
+		return QJsonDocument::fromJson(blob).object();
+
+	QJsonValue jsonValue;
+	if (PFBinaryEncoding::decodeJson(blob, jsonValue))
+		return jsonValue.toObject();
+
+	// Corrupt or written by a newer version, try it as json before giving up on it
+	qCWarning(PFLogSync) << "PFLocalDatastore failed to decode a binary encoded object of" << blob.size() << "bytes, falling back to json";
+	return QJsonDocument::fromJson(blob).object();
+}
+
+// Dates are compared by their iso string so a Date constraint matches the createdAt / updatedAt strings too
+static QJsonValue normalizedValue(const QJsonValue& value)
+{
+	if (value.isObject())
+	{
+		QJsonObject jsonObject = value.toObject();
+		if (jsonObject.value("__type").toString() == "Date")
+			return jsonObject.value("iso");
+	}
+
+	return value;
+}
+
+static bool valuesEqual(const QJsonValue& value1, const QJsonValue& value2)
+{
+	return normalizedValue(value1) == normalizedValue(value2);
+}
+
+// An equality constraint on a list field matches when any element of the list is equal
+static bool fieldMatchesValue(const QJsonValue& field, const QJsonValue& value)
+{
+	if (field.isArray() && !value.isArray())
+	{
+		QJsonArray fieldArray = field.toArray();
+		for (QJsonArray::const_iterator iter = fieldArray.constBegin(); iter != fieldArray.constEnd(); ++iter)
+		{
+			if (valuesEqual(*iter, value))
+				return true;
+		}
+
+		return false;
+	}
+
+	return valuesEqual(field, value);
+}
+
+// Compares numbers, strings and bools (dates included), returns false if the values can't be compared
+static bool compareValues(const QJsonValue& value1, const QJsonValue& value2, int& result)
+{
+	QJsonValue normalized1 = normalizedValue(value1);
+	QJsonValue normalized2 = normalizedValue(value2);
+	if (normalized1.isDouble() && normalized2.isDouble())
+	{
+		double double1 = normalized1.toDouble(), double2 = normalized2.toDouble();
+		result = (double1 < double2) ? -1 : ((double1 > double2) ? 1 : 0);
+		return true;
+	}
+	else if (normalized1.isString() && normalized2.isString())
+	{
+		result = QString::compare(normalized1.toString(), normalized2.toString());
+		return true;
+	}
+	else if (normalized1.isBool() && normalized2.isBool())
+	{
+		result = int(normalized1.toBool()) - int(normalized2.toBool());
+		return true;
+	}
+
+	return false;
+}
+
+// Sorts missing values first, then bools, numbers, strings and everything else
+static int sortRank(const QJsonValue& value)
+{
+	switch (value.type())
+	{
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			return 0;
+		case QJsonValue::Bool:
+			return 1;
+		case QJsonValue::Double:
+			return 2;
+		case QJsonValue::String:
+			return 3;
+		default:
+			return 4;
+	}
+}
+
+// Orders json objects by the PFQuery order keys ("-" prefixed keys are descending)
+struct JsonObjectLessThan
+{
+	JsonObjectLessThan(const QStringList& orderKeys) : _orderKeys(orderKeys) {}
+
+	bool operator()(const QJsonObject& jsonObject1, const QJsonObject& jsonObject2) const
+	{
+		foreach (const QString& orderKey, _orderKeys)
+		{
+			bool descending = orderKey.startsWith('-');
+			QString key = descending ? orderKey.mid(1) : orderKey;
+			QJsonValue value1 = normalizedValue(jsonObject1.value(key));
+			QJsonValue value2 = normalizedValue(jsonObject2.value(key));
+
+			int result = sortRank(value1) - sortRank(value2);
+			if (result == 0 && !compareValues(value1, value2, result))
+				result = 0;
+
+			if (result != 0)
+				return descending ? (result > 0) : (result < 0);
+		}
+
+		return false;
+	}
+
+	QStringList _orderKeys;
+};
+
+// Returns the value stored in the index table for the json value (invalid if it can't be indexed)
+static QVariant indexValue(const QJsonValue& value)
+{
+	QJsonValue normalized = normalizedValue(value);
+	switch (normalized.type())
+	{
+		case QJsonValue::Bool:
+			return QVariant(normalized.toBool() ? 1 : 0);
+		case QJsonValue::Double:
+			return QVariant(normalized.toDouble());
+		case QJsonValue::String:
+			return QVariant(normalized.toString());
+		default:
+			return QVariant();
+	}
+}
+
+// Returns the SQL comparison for the range operators (empty for the rest)
+static QString comparisonForOperator(const QString& op)
+{
+	if (op == "$lt")
+		return "<";
+	else if (op == "$lte")
+		return "<=";
+	else if (op == "$gt")
+		return ">";
+	else if (op == "$gte")
+		return ">=";
+
+	return QString();
+}
+
+// Operator objects are the ones whose keys start with a "$"
+static bool isOperatorObject(const QJsonValue& value)
+{
+	if (!value.isObject())
+		return false;
+
+	QJsonObject jsonObject = value.toObject();
+	return !jsonObject.isEmpty() && jsonObject.constBegin().key().startsWith('$');
+}
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFLocalDatastore::PFLocalDatastore()
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFLocalDatastore(" << QString().sprintf("%8p", this) << ")";
+
+	_connectionName = QString("PFLocalDatastore-%1").arg((quintptr) this, 0, 16);
+	_database = QSqlDatabase::addDatabase("QSQLITE", _connectionName);
+}
+
+PFLocalDatastore::~PFLocalDatastore()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFLocalDatastore(" << QString().sprintf("%8p", this) << ")";
+
+	// The connection can only be removed once nothing refers to it anymore
+	_database.close();
+	_database = QSqlDatabase();
+	QSqlDatabase::removeDatabase(_connectionName);
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFLocalDatastorePtr PFLocalDatastore::localDatastoreWithDirectory(const QDir& directory)
+{
+	PFLocalDatastorePtr localDatastore = PFLocalDatastorePtr(new PFLocalDatastore(), &QObject::deleteLater);
+	localDatastore->_directory = directory;
+	localDatastore->_database.setDatabaseName(directory.filePath(gDatabaseFilename));
+
+	return localDatastore;
+}
+
+QString PFLocalDatastore::defaultPinName()
+{
+	return gDefaultPinName;
+}
+
+#ifdef __APPLE__
+#pragma mark - Index Methods
+#endif
+
+bool PFLocalDatastore::declareIndex(const QString& className, const QString& key)
+{
+	PFErrorPtr error;
+	return declareIndex(className, key, error);
+}
+
+bool PFLocalDatastore::declareIndex(const QString& className, const QString& key, PFErrorPtr& error)
+{
+	if (className.isEmpty() || key.isEmpty())
+	{
+		qWarning() << "PFLocalDatastore::declareIndex failed because the className and/or the key is empty";
+		return false;
+	}
+
+	if (!openDatabase(true, error))
+		return false;
+
+	if (_indexedKeys.value(className).contains(key))
+		return true;
+
+	// Record the index and write the values of the objects we already have
+	_database.transaction();
+	QSqlQuery insertQuery(_database);
+	insertQuery.prepare("INSERT OR IGNORE INTO indexed_keys (className, key) VALUES (?, ?)");
+	insertQuery.addBindValue(className);
+	insertQuery.addBindValue(key);
+	bool succeeded = insertQuery.exec();
+	if (!succeeded)
+		error = datastoreError(insertQuery.lastError().text());
+
+	QSqlQuery selectQuery(_database);
+	selectQuery.setForwardOnly(true);
+	selectQuery.prepare("SELECT objectId, json FROM objects WHERE className = ?");
+	selectQuery.addBindValue(className);
+	if (succeeded && !selectQuery.exec())
+	{
+		error = datastoreError(selectQuery.lastError().text());
+		succeeded = false;
+	}
+
+	while (succeeded && selectQuery.next())
+	{
+		QJsonObject jsonObject = jsonObjectFromBlob(selectQuery.value(1).toByteArray());
+		QJsonObject::const_iterator iter = jsonObject.constFind(key);
+		if (iter != jsonObject.constEnd())
+			succeeded = writeIndexValues(className, selectQuery.value(0).toString(), key, iter.value(), error);
+	}
+
+	if (!succeeded)
+	{
+		_database.rollback();
+		return false;
+	}
+
+	_database.commit();
+	_indexedKeys[className].append(key);
+
+	return true;
+}
+
+QStringList PFLocalDatastore::indexedKeys(const QString& className)
+{
+	PFErrorPtr error;
+	openDatabase(false, error);
+	return _indexedKeys.value(className);
+}
+
+#ifdef __APPLE__
+#pragma mark - Pin Methods
+#endif
+
+bool PFLocalDatastore::pinObjects(const QList<PFObject*>& objects, const QString& pinName, PFErrorPtr& error)
+{
+	if (!openDatabase(true, error))
+		return false;
+
+	// Write everything in a single transaction so pinning many objects only syncs the database once
+	QString name = pinName.isEmpty() ? gDefaultPinName : pinName;
+	_database.transaction();
+	foreach (PFObject* object, objects)
+	{
+		if (object->objectId().isEmpty())
+		{
+			error = PFError::errorWithCodeAndMessage(kPFErrorMissingObjectId, "Only objects with an objectId can be pinned");
+			_database.rollback();
+			return false;
+		}
+
+		QSqlQuery pinQuery(_database);
+		pinQuery.prepare("INSERT OR IGNORE INTO pins (name, className, objectId) VALUES (?, ?, ?)");
+		pinQuery.addBindValue(name);
+		pinQuery.addBindValue(object->className());
+		pinQuery.addBindValue(object->objectId());
+		if (!writeObject(object, error))
+		{
+			_database.rollback();
+			return false;
+		}
+		else if (!pinQuery.exec())
+		{
+			error = datastoreError(pinQuery.lastError().text());
+			_database.rollback();
+			return false;
+		}
+	}
+
+	_database.commit();
+	return true;
+}
+
+bool PFLocalDatastore::unpinObjects(const QList<PFObject*>& objects, const QString& pinName, PFErrorPtr& error)
+{
+	// Nothing has ever been pinned if there is no database
+	if (!openDatabase(false, error))
+		return error.isNull();
+
+	QString name = pinName.isEmpty() ? gDefaultPinName : pinName;
+	_database.transaction();
+	foreach (PFObject* object, objects)
+	{
+		QSqlQuery unpinQuery(_database);
+		unpinQuery.prepare("DELETE FROM pins WHERE name = ? AND className = ? AND objectId = ?");
+		unpinQuery.addBindValue(name);
+		unpinQuery.addBindValue(object->className());
+		unpinQuery.addBindValue(object->objectId());
+
+		QSqlQuery countQuery(_database);
+		countQuery.prepare("SELECT COUNT(*) FROM pins WHERE className = ? AND objectId = ?");
+		countQuery.addBindValue(object->className());
+		countQuery.addBindValue(object->objectId());
+
+		if (!unpinQuery.exec() || !countQuery.exec() || !countQuery.next())
+		{
+			error = datastoreError(unpinQuery.lastError().isValid() ? unpinQuery.lastError().text() : countQuery.lastError().text());
+			_database.rollback();
+			return false;
+		}
+
+		// Drop the object once nothing pins it anymore
+		if (countQuery.value(0).toInt() == 0 && !deleteObject(object->className(), object->objectId(), error))
+		{
+			_database.rollback();
+			return false;
+		}
+	}
+
+	_database.commit();
+	return true;
+}
+
+bool PFLocalDatastore::unpinAllObjects(const QString& pinName, PFErrorPtr& error)
+{
+	if (!openDatabase(false, error))
+		return error.isNull();
+
+	QString name = pinName.isEmpty() ? gDefaultPinName : pinName;
+	_database.transaction();
+	QSqlQuery unpinQuery(_database);
+	unpinQuery.prepare("DELETE FROM pins WHERE name = ?");
+	unpinQuery.addBindValue(name);
+	if (!unpinQuery.exec())
+	{
+		error = datastoreError(unpinQuery.lastError().text());
+		_database.rollback();
+		return false;
+	}
+
+	// Drop every object (and its index values) that isn't pinned anymore
+	bool succeeded = execute("DELETE FROM objects WHERE NOT EXISTS (SELECT 1 FROM pins p WHERE p.className = objects.className "
+							 "AND p.objectId = objects.objectId)", error) &&
+					 execute("DELETE FROM object_values WHERE NOT EXISTS (SELECT 1 FROM objects o WHERE o.className = "
+							 "object_values.className AND o.objectId = object_values.objectId)", error);
+	if (!succeeded)
+	{
+		_database.rollback();
+		return false;
+	}
+
+	_database.commit();
+	return true;
+}
+
+bool PFLocalDatastore::objectJson(const QString& className, const QString& objectId, QJsonObject& jsonObject, PFErrorPtr& error)
+{
+	if (!openDatabase(false, error))
+		return false;
+
+	QSqlQuery selectQuery(_database);
+	selectQuery.prepare("SELECT json FROM objects WHERE className = ? AND objectId = ?");
+	selectQuery.addBindValue(className);
+	selectQuery.addBindValue(objectId);
+	if (!selectQuery.exec())
+	{
+		error = datastoreError(selectQuery.lastError().text());
+		return false;
+	}
+	else if (!selectQuery.next())
+	{
+		return false;
+	}
+
+	jsonObject = jsonObjectFromBlob(selectQuery.value(0).toByteArray());
+	return true;
+}
+
+void PFLocalDatastore::updateObject(PFObject* object)
+{
+	PFErrorPtr error;
+	if (object->objectId().isEmpty() || !openDatabase(false, error))
+		return;
+
+	// Only objects that are already stored get rewritten
+	QSqlQuery selectQuery(_database);
+	selectQuery.prepare("SELECT 1 FROM objects WHERE className = ? AND objectId = ?");
+	selectQuery.addBindValue(object->className());
+	selectQuery.addBindValue(object->objectId());
+	if (!selectQuery.exec() || !selectQuery.next())
+		return;
+
+	selectQuery.finish();
+	_database.transaction();
+	if (writeObject(object, error))
+		_database.commit();
+	else
+		_database.rollback();
+
+	if (!error.isNull())
+		qWarning() << "PFLocalDatastore::updateObject failed to update the stored object:" << error->errorMessage();
+}
+
+void PFLocalDatastore::removeObject(PFObject* object)
+{
+	PFErrorPtr error;
+	if (object->objectId().isEmpty() || !openDatabase(false, error))
+		return;
+
+	_database.transaction();
+	if (deleteObject(object->className(), object->objectId(), error))
+		_database.commit();
+	else
+		_database.rollback();
+}
+
+#ifdef __APPLE__
+#pragma mark - Query Methods
+#endif
+
+PFObjectList PFLocalDatastore::findObjects(const QString& className, const QString& pinName, const QJsonObject& where,
+										   const QStringList& orderKeys, int limit, int skip, PFErrorPtr& error)
+{
+	PFObjectList objects;
+	QList<QJsonObject> candidates;
+	if (!selectCandidates(className, pinName, where, candidates, error))
+		return objects;
+
+	// Without an order the matching can stop as soon as the page is full
+	int first = qMax(skip, 0);
+	int needed = (limit < 0 || !orderKeys.isEmpty()) ? -1 : first + limit;
+	QList<QJsonObject> matches;
+	foreach (const QJsonObject& candidate, candidates)
+	{
+		if (needed != -1 && matches.count() >= needed)
+			break;
+
+		if (matchesWhere(candidate, where, error))
+			matches.append(candidate);
+		else if (!error.isNull())
+			return objects;
+	}
+
+	if (!orderKeys.isEmpty())
+		std::stable_sort(matches.begin(), matches.end(), JsonObjectLessThan(orderKeys));
+
+	// Only the page that gets returned is converted into objects
+	int last = (limit < 0) ? matches.count() : qMin(matches.count(), first + limit);
+	for (int i = first; i < last; ++i)
+	{
+		PFObjectPtr object = PFObject::objectFromVariant(PFConversion::convertJsonToVariant(matches.at(i)));
+		if (!object.isNull())
+			objects.append(object);
+	}
+
+	return objects;
+}
+
+int PFLocalDatastore::countObjects(const QString& className, const QString& pinName, const QJsonObject& where, PFErrorPtr& error)
+{
+	QList<QJsonObject> candidates;
+	if (!selectCandidates(className, pinName, where, candidates, error))
+		return error.isNull() ? 0 : -1;
+
+	int count = 0;
+	foreach (const QJsonObject& candidate, candidates)
+	{
+		if (matchesWhere(candidate, where, error))
+			++count;
+		else if (!error.isNull())
+			return -1;
+	}
+
+	return count;
+}
+
+bool PFLocalDatastore::matchesWhere(const QJsonObject& jsonObject, const QJsonObject& where, PFErrorPtr& error)
+{
+	for (QJsonObject::const_iterator whereIter = where.constBegin(); whereIter != where.constEnd(); ++whereIter)
+	{
+		QJsonObject::const_iterator fieldIter = jsonObject.constFind(whereIter.key());
+		bool exists = (fieldIter != jsonObject.constEnd());
+		QJsonValue field = exists ? fieldIter.value() : QJsonValue(QJsonValue::Undefined);
+
+		// Plain values are equality constraints
+		if (!isOperatorObject(whereIter.value()))
+		{
+			if (!exists || !fieldMatchesValue(field, whereIter.value()))
+				return false;
+
+			continue;
+		}
+
+		QJsonObject operators = whereIter.value().toObject();
+		for (QJsonObject::const_iterator iter = operators.constBegin(); iter != operators.constEnd(); ++iter)
+		{
+			const QString& op = iter.key();
+			const QJsonValue& value = iter.value();
+			if (op == "$exists")
+			{
+				if (exists != value.toBool())
+					return false;
+			}
+			else if (op == "$ne")
+			{
+				if (exists && fieldMatchesValue(field, value))
+					return false;
+			}
+			else if (op == "$lt" || op == "$lte" || op == "$gt" || op == "$gte")
+			{
+				int result = 0;
+				if (!exists || !compareValues(field, value, result))
+					return false;
+
+				bool matches = (op == "$lt") ? (result < 0) : ((op == "$lte") ? (result <= 0) : ((op == "$gt") ? (result > 0) : (result >= 0)));
+				if (!matches)
+					return false;
+			}
+			else if (op == "$in" || op == "$nin")
+			{
+				bool found = false;
+				QJsonArray values = value.toArray();
+				for (QJsonArray::const_iterator valueIter = values.constBegin(); valueIter != values.constEnd() && !found; ++valueIter)
+					found = exists && fieldMatchesValue(field, *valueIter);
+
+				if (found != (op == "$in"))
+					return false;
+			}
+			else if (op == "$all")
+			{
+				if (!field.isArray())
+					return false;
+
+				QJsonArray values = value.toArray();
+				for (QJsonArray::const_iterator valueIter = values.constBegin(); valueIter != values.constEnd(); ++valueIter)
+				{
+					if (!fieldMatchesValue(field, *valueIter))
+						return false;
+				}
+			}
+			else
+			{
+				error = PFError::errorWithCodeAndMessage(kPFErrorInvalidQuery, QString("The %1 constraint is not supported by the local datastore").arg(op));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Maintenance Methods
+#endif
+
+int PFLocalDatastore::count()
+{
+	PFErrorPtr error;
+	if (!openDatabase(false, error))
+		return 0;
+
+	QSqlQuery countQuery("SELECT COUNT(*) FROM objects", _database);
+	return countQuery.next() ? countQuery.value(0).toInt() : 0;
+}
+
+void PFLocalDatastore::clear()
+{
+	PFErrorPtr error;
+	if (!openDatabase(false, error))
+		return;
+
+	_database.transaction();
+	execute("DELETE FROM objects", error);
+	execute("DELETE FROM pins", error);
+	execute("DELETE FROM object_values", error);
+	execute("DELETE FROM indexed_keys", error);
+	_database.commit();
+	_indexedKeys.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark - Database Helper Methods
+#endif
+
+bool PFLocalDatastore::openDatabase(bool create, PFErrorPtr& error)
+{
+	if (_database.isOpen())
+		return true;
+
+	// Reading from a datastore that was never written to doesn't need to create the database
+	if (!create && !QFileInfo(_database.databaseName()).exists())
+		return false;
+
+	_directory.mkpath(_directory.absolutePath());
+	if (!_database.open())
+	{
+		error = datastoreError(_database.lastError().text());
+		return false;
+	}
+
+	bool succeeded = execute("PRAGMA journal_mode = WAL", error) &&
+					 execute("PRAGMA synchronous = NORMAL", error) &&
+					 execute("CREATE TABLE IF NOT EXISTS objects (className TEXT NOT NULL, objectId TEXT NOT NULL, "
+							 "json BLOB NOT NULL, PRIMARY KEY (className, objectId))", error) &&
+					 execute("CREATE TABLE IF NOT EXISTS pins (name TEXT NOT NULL, className TEXT NOT NULL, "
+							 "objectId TEXT NOT NULL, PRIMARY KEY (name, className, objectId))", error) &&
+					 execute("CREATE INDEX IF NOT EXISTS pins_object ON pins (className, objectId)", error) &&
+					 execute("CREATE TABLE IF NOT EXISTS indexed_keys (className TEXT NOT NULL, key TEXT NOT NULL, "
+							 "PRIMARY KEY (className, key))", error) &&
+					 execute("CREATE TABLE IF NOT EXISTS object_values (className TEXT NOT NULL, key TEXT NOT NULL, "
+							 "value, objectId TEXT NOT NULL)", error) &&
+					 execute("CREATE INDEX IF NOT EXISTS object_values_lookup ON object_values (className, key, value)", error) &&
+					 execute("CREATE INDEX IF NOT EXISTS object_values_object ON object_values (className, objectId)", error);
+	if (!succeeded)
+	{
+		_database.close();
+		return false;
+	}
+
+	// Keep the declared indexes in memory so the query planning never has to ask the database
+	_indexedKeys.clear();
+	QSqlQuery indexQuery("SELECT className, key FROM indexed_keys", _database);
+	while (indexQuery.next())
+		_indexedKeys[indexQuery.value(0).toString()].append(indexQuery.value(1).toString());
+
+	return true;
+}
+
+bool PFLocalDatastore::execute(const QString& statement, PFErrorPtr& error)
+{
+	QSqlQuery query(_database);
+	if (!query.exec(statement))
+	{
+		error = datastoreError(query.lastError().text());
+		return false;
+	}
+
+	return true;
+}
+
+bool PFLocalDatastore::writeObject(PFObject* object, PFErrorPtr& error)
+{
+	QJsonObject jsonObject;
+	if (!object->toObjectJson(jsonObject))
+	{
+		error = PFError::errorWithCodeAndMessage(kPFErrorMissingObjectId, "Only objects with an objectId can be stored");
+		return false;
+	}
+
+	QSqlQuery insertQuery(_database);
+	insertQuery.prepare("INSERT OR REPLACE INTO objects (className, objectId, json) VALUES (?, ?, ?)");
+	insertQuery.addBindValue(object->className());
+	insertQuery.addBindValue(object->objectId());
+	insertQuery.addBindValue(PFBinaryEncoding::encodeJson(jsonObject));
+
+	QSqlQuery deleteQuery(_database);
+	deleteQuery.prepare("DELETE FROM object_values WHERE className = ? AND objectId = ?");
+	deleteQuery.addBindValue(object->className());
+	deleteQuery.addBindValue(object->objectId());
+
+	if (!insertQuery.exec() || !deleteQuery.exec())
+	{
+		error = datastoreError(insertQuery.lastError().isValid() ? insertQuery.lastError().text() : deleteQuery.lastError().text());
+		return false;
+	}
+
+	// Rewrite the values of the indexed keys
+	foreach (const QString& key, _indexedKeys.value(object->className()))
+	{
+		QJsonObject::const_iterator iter = jsonObject.constFind(key);
+		if (iter != jsonObject.constEnd() && !writeIndexValues(object->className(), object->objectId(), key, iter.value(), error))
+			return false;
+	}
+
+	return true;
+}
+
+bool PFLocalDatastore::writeIndexValues(const QString& className, const QString& objectId, const QString& key,
+										const QJsonValue& value, PFErrorPtr& error)
+{
+	// Lists get a row per element so equality constraints match any element like they do in the cloud
+	QJsonArray values = value.isArray() ? value.toArray() : (QJsonArray() << value);
+	for (QJsonArray::const_iterator iter = values.constBegin(); iter != values.constEnd(); ++iter)
+	{
+		QVariant storedValue = indexValue(*iter);
+		if (!storedValue.isValid())
+			continue;
+
+		QSqlQuery insertQuery(_database);
+		insertQuery.prepare("INSERT INTO object_values (className, key, value, objectId) VALUES (?, ?, ?, ?)");
+		insertQuery.addBindValue(className);
+		insertQuery.addBindValue(key);
+		insertQuery.addBindValue(storedValue);
+		insertQuery.addBindValue(objectId);
+		if (!insertQuery.exec())
+		{
+			error = datastoreError(insertQuery.lastError().text());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool PFLocalDatastore::deleteObject(const QString& className, const QString& objectId, PFErrorPtr& error)
+{
+	QStringList statements;
+	statements << "DELETE FROM objects WHERE className = ? AND objectId = ?";
+	statements << "DELETE FROM object_values WHERE className = ? AND objectId = ?";
+	statements << "DELETE FROM pins WHERE className = ? AND objectId = ?";
+	foreach (const QString& statement, statements)
+	{
+		QSqlQuery deleteQuery(_database);
+		deleteQuery.prepare(statement);
+		deleteQuery.addBindValue(className);
+		deleteQuery.addBindValue(objectId);
+		if (!deleteQuery.exec())
+		{
+			error = datastoreError(deleteQuery.lastError().text());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool PFLocalDatastore::selectCandidates(const QString& className, const QString& pinName, const QJsonObject& where,
+										QList<QJsonObject>& candidates, PFErrorPtr& error)
+{
+	if (!openDatabase(false, error))
+		return error.isNull();
+
+	// Narrow the objects down with the first constraint that can use a declared index (the matching that
+	// follows stays the authority, the index only has to return a superset of the matches)
+	QString indexCondition;
+	QVariantList indexValues;
+	QString indexKey;
+	foreach (const QString& key, _indexedKeys.value(className))
+	{
+		QJsonObject::const_iterator whereIter = where.constFind(key);
+		if (whereIter == where.constEnd())
+			continue;
+
+		QStringList conditions;
+		QVariantList values;
+		if (!isOperatorObject(whereIter.value()))
+		{
+			QVariant value = indexValue(whereIter.value());
+			if (value.isValid())
+			{
+				conditions << "value = ?";
+				values << value;
+			}
+		}
+		else
+		{
+			QJsonObject operators = whereIter.value().toObject();
+			for (QJsonObject::const_iterator iter = operators.constBegin(); iter != operators.constEnd(); ++iter)
+			{
+				QString comparison = comparisonForOperator(iter.key());
+				QVariant value = indexValue(iter.value());
+				if (!comparison.isEmpty() && value.isValid())
+				{
+					conditions << QString("value %1 ?").arg(comparison);
+					values << value;
+				}
+				else if (iter.key() == "$in")
+				{
+					QJsonArray inArray = iter.value().toArray();
+					QVariantList inValues;
+					for (QJsonArray::const_iterator inIter = inArray.constBegin(); inIter != inArray.constEnd(); ++inIter)
+					{
+						QVariant inValue = indexValue(*inIter);
+						if (inValue.isValid())
+							inValues << inValue;
+					}
+
+					if (inValues.count() == inArray.count() && !inValues.isEmpty() && inValues.count() <= gMaximumIndexedInValues)
+					{
+						QStringList placeholders;
+						for (int i = 0; i < inValues.count(); ++i)
+							placeholders << "?";
+						conditions << QString("value IN (%1)").arg(placeholders.join(", "));
+						values << inValues;
+					}
+				}
+			}
+		}
+
+		if (!conditions.isEmpty())
+		{
+			indexKey = key;
+			indexCondition = conditions.join(" AND ");
+			indexValues = values;
+			break;
+		}
+	}
+
+	// Build the statement
+	QString statement = "SELECT o.json FROM objects o";
+	QVariantList bindValues;
+	if (!indexKey.isEmpty())
+	{
+		statement += QString(" JOIN (SELECT DISTINCT objectId FROM object_values WHERE className = ? AND key = ? AND %1) v "
+							 "ON v.objectId = o.objectId").arg(indexCondition);
+		bindValues << className << indexKey << indexValues;
+	}
+
+	statement += " WHERE o.className = ?";
+	bindValues << className;
+
+	// The objectId is part of the primary key so it never needs a declared index
+	QJsonObject::const_iterator objectIdIter = where.constFind("objectId");
+	if (objectIdIter != where.constEnd() && objectIdIter.value().isString())
+	{
+		statement += " AND o.objectId = ?";
+		bindValues << objectIdIter.value().toString();
+	}
+
+	if (!pinName.isEmpty())
+	{
+		statement += " AND EXISTS (SELECT 1 FROM pins p WHERE p.name = ? AND p.className = o.className AND p.objectId = o.objectId)";
+		bindValues << pinName;
+	}
+
+	QSqlQuery selectQuery(_database);
+	selectQuery.setForwardOnly(true);
+	selectQuery.prepare(statement);
+	foreach (const QVariant& bindValue, bindValues)
+		selectQuery.addBindValue(bindValue);
+
+	if (!selectQuery.exec())
+	{
+		error = datastoreError(selectQuery.lastError().text());
+		return false;
+	}
+
+	while (selectQuery.next())
+		candidates.append(jsonObjectFromBlob(selectQuery.value(0).toByteArray()));
+
+	return true;
+}
+
+}	// End of parse namespace
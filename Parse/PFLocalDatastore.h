@@ -0,0 +1,111 @@
+//
+//  PFLocalDatastore.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFLOCALDATASTORE_H
+#define PARSE_PFLOCALDATASTORE_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QDir>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+namespace parse {
+
+// Keeps pinned PFObjects on disk so they can be queried without a network connection (see PFObject::pin and
+// PFQuery::fromLocalDatastore). Objects live in a SQLite database in the datastore directory as the binary
+// encoding (PFBinaryEncoding) of the json the REST API returns for them, along with the pins that reference
+// them. Keys declared as indexed also get their values written to an indexed table, so queries constraining
+// them only ever read the matching objects instead of scanning the whole class. An object goes away once the
+// last pin referencing it is removed.
+class PFLocalDatastore : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Declares a secondary index on the key for the class. Existing objects of the class get indexed right away
+	// and queries with equality, range or $in constraints on the key use the index from then on.
+	bool declareIndex(const QString& className, const QString& key);
+	bool declareIndex(const QString& className, const QString& key, PFErrorPtr& error);
+	QStringList indexedKeys(const QString& className);
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods
+	static PFLocalDatastorePtr localDatastoreWithDirectory(const QDir& directory);
+
+	// The pin name used when none is given
+	static QString defaultPinName();
+
+	// Pin Methods - only objects with an objectId can be pinned
+	bool pinObjects(const QList<PFObject*>& objects, const QString& pinName, PFErrorPtr& error);
+	bool unpinObjects(const QList<PFObject*>& objects, const QString& pinName, PFErrorPtr& error);
+	bool unpinAllObjects(const QString& pinName, PFErrorPtr& error);
+
+	// Returns the json of the stored object, false if the object isn't in the datastore
+	bool objectJson(const QString& className, const QString& objectId, QJsonObject& jsonObject, PFErrorPtr& error);
+
+	// Keeps a stored object in sync after it was saved or fetched, or drops it after it was deleted (both are no-ops
+	// for objects that aren't in the datastore)
+	void updateObject(PFObject* object);
+	void removeObject(PFObject* object);
+
+	// Query Methods - the where object is the json the REST API takes as the "where" parameter, an empty pin name
+	// means every pinned object. A limit of -1 returns every match.
+	PFObjectList findObjects(const QString& className, const QString& pinName, const QJsonObject& where,
+							 const QStringList& orderKeys, int limit, int skip, PFErrorPtr& error);
+	int countObjects(const QString& className, const QString& pinName, const QJsonObject& where, PFErrorPtr& error);
+
+	// Returns whether the json object satisfies the constraints of the where object
+	static bool matchesWhere(const QJsonObject& jsonObject, const QJsonObject& where, PFErrorPtr& error);
+
+	// The number of stored objects
+	int count();
+
+	// Removes every object, pin and index
+	void clear();
+
+protected:
+
+	// Constructor / Destructor
+	PFLocalDatastore();
+	~PFLocalDatastore();
+
+	// Database Helper Methods
+	bool openDatabase(bool create, PFErrorPtr& error);
+	bool execute(const QString& statement, PFErrorPtr& error);
+	bool writeObject(PFObject* object, PFErrorPtr& error);
+	bool writeIndexValues(const QString& className, const QString& objectId, const QString& key,
+						  const QJsonValue& value, PFErrorPtr& error);
+	bool deleteObject(const QString& className, const QString& objectId, PFErrorPtr& error);
+	bool selectCandidates(const QString& className, const QString& pinName, const QJsonObject& where,
+						  QList<QJsonObject>& candidates, PFErrorPtr& error);
+
+	// Instance members
+	QDir							_directory;
+	QString							_connectionName;
+	QSqlDatabase					_database;
+	QHash<QString, QStringList>		_indexedKeys;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFLOCALDATASTORE_H
@@ -0,0 +1,30 @@
+//
+//  PFLogging.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+
+// Categories that log once per object start out with debug output disabled (Qt 5.4 added the severity
+// threshold, older versions fall back to the Qt default of everything but qt.* being enabled)
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+#define PF_QUIET_LOGGING_CATEGORY(name, categoryName) Q_LOGGING_CATEGORY(name, categoryName, QtWarningMsg)
+#else
+#define PF_QUIET_LOGGING_CATEGORY(name, categoryName) Q_LOGGING_CATEGORY(name, categoryName)
+#endif
+
+namespace parse {
+
+PF_QUIET_LOGGING_CATEGORY(PFLogLifetime, "parse.lifetime")
+PF_QUIET_LOGGING_CATEGORY(PFLogObject, "parse.object")
+Q_LOGGING_CATEGORY(PFLogQuery, "parse.query")
+Q_LOGGING_CATEGORY(PFLogFile, "parse.file")
+Q_LOGGING_CATEGORY(PFLogSync, "parse.sync")
+Q_LOGGING_CATEGORY(PFLogManager, "parse.manager")
+Q_LOGGING_CATEGORY(PFLogMetrics, "parse.metrics")
+
+}	// End of parse namespace
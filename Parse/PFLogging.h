@@ -0,0 +1,39 @@
+//
+//  PFLogging.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFLOGGING_H
+#define PARSE_PFLOGGING_H
+
+// Qt headers
+#include <QLoggingCategory>
+
+namespace parse {
+
+// Logging categories for each subsystem of the SDK. Messages go through qCDebug so their arguments are only
+// built when the category is enabled, and defining QT_NO_DEBUG_OUTPUT compiles them out entirely. The
+// lifetime and object categories log once per object and are disabled by default, turn them on with
+// QLoggingCategory::setFilterRules("parse.lifetime.debug=true") or the QT_LOGGING_RULES environment variable.
+//
+//   parse.lifetime   Creation and destruction of every SDK object
+//   parse.object     Objects created or updated by save and fetch
+//   parse.query      Query operations
+//   parse.file       File transfers and the file cache
+//   parse.sync       The sync engine
+//   parse.manager    The manager and its cache directory
+//   parse.metrics    The periodic metrics dump (see PFMetrics::setDumpInterval)
+Q_DECLARE_LOGGING_CATEGORY(PFLogLifetime)
+Q_DECLARE_LOGGING_CATEGORY(PFLogObject)
+Q_DECLARE_LOGGING_CATEGORY(PFLogQuery)
+Q_DECLARE_LOGGING_CATEGORY(PFLogFile)
+Q_DECLARE_LOGGING_CATEGORY(PFLogSync)
+Q_DECLARE_LOGGING_CATEGORY(PFLogManager)
+Q_DECLARE_LOGGING_CATEGORY(PFLogMetrics)
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFLOGGING_H
@@ -7,9 +7,17 @@
 //
 
 // Parse headers
+#include "PFFileCache.h"
+#include "PFLocalDatastore.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
+#include "PFUploadIndex.h"
 
 // Qt headers
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
 #include <QMutex>
 #include <QMutexLocker>
 
@@ -33,12 +41,23 @@ PFManager::PFManager() :
 	_cacheDirectory = QDir::temp();
 	_cacheDirectory.mkdir("Parse");
 	_cacheDirectory.cd("Parse");
-	qDebug() << "Cache directory:" << _cacheDirectory.absolutePath();
+	qCDebug(PFLogManager) << "Cache directory:" << _cacheDirectory.absolutePath();
+
+	// Set up the file cache inside the cache directory
+	_fileCache = PFFileCache::fileCacheWithDirectory(QDir(_cacheDirectory.filePath("PFFileCache")));
+	_uploadIndex = PFUploadIndex::uploadIndexWithDirectory(QDir(_cacheDirectory.filePath("PFUploadIndex")));
+	_localDatastore = PFLocalDatastore::localDatastoreWithDirectory(QDir(_cacheDirectory.filePath("PFLocalDatastore")));
+
+	// Every reply of the network access manager gets reported to the metrics
+	_metrics = PFMetrics::metrics();
+	_networkAccessManager.setMetrics(_metrics);
 }
 
 PFManager::~PFManager()
 {
-	// No-op
+	// The event loop is gone by now so make sure the latest indexes make it to disk
+	_fileCache->saveIndex();
+	_uploadIndex->saveIndex();
 }
 
 #ifdef __APPLE__
@@ -82,11 +101,21 @@ const QString& PFManager::masterKey()
 	return _masterKey;
 }
 
+PFMetrics* PFManager::metrics()
+{
+	return _metrics.data();
+}
+
+PFRequestScheduler* PFManager::requestScheduler()
+{
+	return _networkAccessManager.requestScheduler();
+}
+
 #ifdef __APPLE__
 #pragma mark - Backend API - Caching and Network Methods
 #endif
 
-QNetworkAccessManager* PFManager::networkAccessManager()
+PFNetworkAccessManager* PFManager::networkAccessManager()
 {
 	return &_networkAccessManager;
 }
@@ -94,6 +123,13 @@ QNetworkAccessManager* PFManager::networkAccessManager()
 void PFManager::setCacheDirectory(const QDir& cacheDirectory)
 {
 	_cacheDirectory = cacheDirectory;
+
+	// Move the file cache over to the new directory
+	_fileCache->saveIndex();
+	_fileCache = PFFileCache::fileCacheWithDirectory(QDir(_cacheDirectory.filePath("PFFileCache")));
+	_uploadIndex->saveIndex();
+	_uploadIndex = PFUploadIndex::uploadIndexWithDirectory(QDir(_cacheDirectory.filePath("PFUploadIndex")));
+	_localDatastore = PFLocalDatastore::localDatastoreWithDirectory(QDir(_cacheDirectory.filePath("PFLocalDatastore")));
 }
 
 QDir& PFManager::cacheDirectory()
@@ -103,8 +139,55 @@ QDir& PFManager::cacheDirectory()
 
 void PFManager::clearCache()
 {
-	_cacheDirectory.removeRecursively();
+	// Empty the file cache index right away and let it delete its files in the background
+	_fileCache->clear();
+	_uploadIndex->clear();
+
+	// Move everything else out of the way and delete it in the background as well. If we can't move it
+	// (e.g. the temp directory is on a different volume), fall back to deleting it right here.
+	QString fileCachePath = QDir(_cacheDirectory.filePath("PFFileCache")).absolutePath();
+	QString uploadIndexPath = QDir(_cacheDirectory.filePath("PFUploadIndex")).absolutePath();
+	QString localDatastorePath = QDir(_cacheDirectory.filePath("PFLocalDatastore")).absolutePath();
+	QString trashName = QString("Parse-trash-%1").arg(QDateTime::currentMSecsSinceEpoch());
+	QDir trashDirectory = QDir::temp();
+	bool hasTrashDirectory = trashDirectory.mkpath(trashName) && trashDirectory.cd(trashName);
+
+	QFileInfoList fileInfos = _cacheDirectory.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+	foreach (const QFileInfo& fileInfo, fileInfos)
+	{
+		if (fileInfo.absoluteFilePath() == fileCachePath || fileInfo.absoluteFilePath() == uploadIndexPath ||
+			fileInfo.absoluteFilePath() == localDatastorePath)
+			continue;
+
+		bool moved = hasTrashDirectory && QDir().rename(fileInfo.absoluteFilePath(), trashDirectory.filePath(fileInfo.fileName()));
+		if (!moved)
+		{
+			if (fileInfo.isDir())
+				QDir(fileInfo.absoluteFilePath()).removeRecursively();
+			else
+				QFile::remove(fileInfo.absoluteFilePath());
+		}
+	}
+
+	if (hasTrashDirectory)
+		PFFileCache::removePathsInBackground(QStringList() << trashDirectory.absolutePath());
+
 	_cacheDirectory.mkpath(_cacheDirectory.absolutePath());
 }
 
+PFFileCache* PFManager::fileCache()
+{
+	return _fileCache.data();
+}
+
+PFUploadIndex* PFManager::uploadIndex()
+{
+	return _uploadIndex.data();
+}
+
+PFLocalDatastore* PFManager::localDatastore()
+{
+	return _localDatastore.data();
+}
+
 }	// End of parse namespace
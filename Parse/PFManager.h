@@ -9,6 +9,10 @@
 #ifndef PARSE_PFMANAGER_H
 #define PARSE_PFMANAGER_H
 
+// Parse headers
+#include "PFNetworkAccessManager.h"
+#include "PFTypedefs.h"
+
 // Qt headers
 #include <QDir>
 #include <QNetworkAccessManager>
@@ -38,16 +42,32 @@ public:
 	const QString& restApiKey();
 	const QString& masterKey();
 
+	// The request metrics of every endpoint (see PFMetrics for the snapshot, reset and periodic dump)
+	PFMetrics* metrics();
+
+	// Keeps requests under the requests per second of the app (see PFRequestScheduler for the rate and priorities)
+	PFRequestScheduler* requestScheduler();
+
 	//=================================================================================
 	//                                BACKEND API
 	//=================================================================================
 
-	// Caching and Network Methods
-	QNetworkAccessManager* networkAccessManager();
+	// Caching and Network Methods - interceptors get added to the network access manager (see PFNetworkInterceptor)
+	PFNetworkAccessManager* networkAccessManager();
 	void setCacheDirectory(const QDir& cacheDirectory);
 	QDir& cacheDirectory();
 	void clearCache();
 
+	// The cache for downloaded file data which lives in the PFFileCache folder of the cache directory
+	PFFileCache* fileCache();
+
+	// The record of previously uploaded file contents which lives in the PFUploadIndex folder of the cache directory
+	PFUploadIndex* uploadIndex();
+
+	// The pinned objects which live in the PFLocalDatastore folder of the cache directory. Pinned objects are
+	// data rather than cache, so clearCache() leaves them alone.
+	PFLocalDatastore* localDatastore();
+
 protected:
 
 	// Constructor / Destructor
@@ -59,7 +79,11 @@ protected:
 	QString					_restApiKey;
 	QString					_masterKey;
 	QDir					_cacheDirectory;
-	QNetworkAccessManager	_networkAccessManager;
+	PFNetworkAccessManager	_networkAccessManager;
+	PFMetricsPtr			_metrics;
+	PFFileCachePtr			_fileCache;
+	PFUploadIndexPtr		_uploadIndex;
+	PFLocalDatastorePtr		_localDatastore;
 };
 
 }	// End of parse namespace
@@ -0,0 +1,283 @@
+//
+//  PFMetrics.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+#include "PFMetrics.h"
+
+// Qt headers
+#include <QDebug>
+#include <QMutexLocker>
+#include <QNetworkRequest>
+
+namespace parse {
+
+// Static Globals
+static const QString gApiHost = "api.parse.com";
+static const QString gOtherEndpoint = "other";
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFMetrics::PFMetrics()
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFMetrics(" << QString().sprintf("%8p", this) << ")";
+
+	_clock.start();
+	QObject::connect(&_dumpTimer, SIGNAL(timeout()), this, SLOT(handleDumpTimeout()));
+}
+
+PFMetrics::~PFMetrics()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFMetrics(" << QString().sprintf("%8p", this) << ")";
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFMetricsPtr PFMetrics::metrics()
+{
+	return PFMetricsPtr(new PFMetrics(), &QObject::deleteLater);
+}
+
+#ifdef __APPLE__
+#pragma mark - User API
+#endif
+
+QJsonObject PFMetrics::snapshot()
+{
+	QMutexLocker lock(&_mutex);
+
+	QJsonObject snapshotObject;
+	for (QHash<QString, EndpointMetrics>::const_iterator iter = _endpoints.constBegin(); iter != _endpoints.constEnd(); ++iter)
+	{
+		const EndpointMetrics& endpointMetrics = iter.value();
+		QJsonObject errorsObject;
+		for (QMap<QString, qint64>::const_iterator errorIter = endpointMetrics.errors.constBegin();
+			 errorIter != endpointMetrics.errors.constEnd(); ++errorIter)
+		{
+			errorsObject[errorIter.key()] = double(errorIter.value());
+		}
+
+		QJsonObject endpointObject;
+		endpointObject["requests"] = double(endpointMetrics.requests);
+		endpointObject["bytesSent"] = double(endpointMetrics.bytesSent);
+		endpointObject["bytesReceived"] = double(endpointMetrics.bytesReceived);
+		endpointObject["errors"] = errorsObject;
+		endpointObject["queueWait"] = histogramToJson(endpointMetrics.queueWait);
+		endpointObject["timeToFirstByte"] = histogramToJson(endpointMetrics.timeToFirstByte);
+		endpointObject["latency"] = histogramToJson(endpointMetrics.latency);
+		endpointObject["decodeTime"] = histogramToJson(endpointMetrics.decodeTime);
+		snapshotObject[iter.key()] = endpointObject;
+	}
+
+	return snapshotObject;
+}
+
+void PFMetrics::reset()
+{
+	QMutexLocker lock(&_mutex);
+	_endpoints.clear();
+}
+
+void PFMetrics::setDumpInterval(int dumpInterval)
+{
+	if (dumpInterval > 0)
+		_dumpTimer.start(dumpInterval);
+	else
+		_dumpTimer.stop();
+}
+
+int PFMetrics::dumpInterval()
+{
+	return _dumpTimer.isActive() ? _dumpTimer.interval() : 0;
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+QString PFMetrics::endpointForUrl(const QUrl& url)
+{
+	// The only requests going anywhere but the REST API are file downloads
+	if (url.host() != gApiHost)
+		return url.isEmpty() ? gOtherEndpoint : QString("files");
+
+	// https://api.parse.com/1/<endpoint>/...
+	QStringList pathComponents = url.path().split('/', QString::SkipEmptyParts);
+	QString endpoint = (pathComponents.count() > 1) ? pathComponents.at(1) : QString();
+	if (endpoint == "classes" || endpoint == "batch" || endpoint == "users" || endpoint == "login" || endpoint == "files")
+		return endpoint;
+	else if (endpoint == "requestPasswordReset")
+		return "users";
+
+	return gOtherEndpoint;
+}
+
+void PFMetrics::trackReply(QNetworkReply* reply, qint64 bytesToSend)
+{
+	PendingReply pendingReply;
+	pendingReply.endpoint = endpointForUrl(reply->request().url());
+	pendingReply.startUsecs = elapsedUsecs();
+	pendingReply.firstByteUsecs = -1;
+	pendingReply.bytesSent = qMax(Q_INT64_C(0), bytesToSend);
+	pendingReply.bytesReceived = 0;
+	_pendingReplies.insert(reply, pendingReply);
+
+	QObject::connect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleReplyMetaDataChanged()));
+	QObject::connect(reply, SIGNAL(uploadProgress(qint64, qint64)), this, SLOT(handleReplyUploadProgress(qint64, qint64)));
+	QObject::connect(reply, SIGNAL(downloadProgress(qint64, qint64)), this, SLOT(handleReplyDownloadProgress(qint64, qint64)));
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleReplyFinished()));
+	QObject::connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(handleReplyDestroyed(QObject*)));
+}
+
+void PFMetrics::recordQueueWait(const QString& endpoint, qint64 usecs)
+{
+	QMutexLocker lock(&_mutex);
+	_endpoints[endpoint].queueWait.record(usecs);
+}
+
+void PFMetrics::recordDecodeTime(const QString& endpoint, qint64 usecs)
+{
+	QMutexLocker lock(&_mutex);
+	_endpoints[endpoint].decodeTime.record(usecs);
+}
+
+void PFMetrics::recordError(const QString& endpoint, const QString& error)
+{
+	QMutexLocker lock(&_mutex);
+	++_endpoints[endpoint].errors[error];
+}
+
+QJsonDocument PFMetrics::decodeReply(QNetworkReply* networkReply)
+{
+	QByteArray data = networkReply->readAll();
+	qint64 startUsecs = elapsedUsecs();
+	QJsonDocument doc = QJsonDocument::fromJson(data);
+	QString endpoint = endpointForUrl(networkReply->request().url());
+	recordDecodeTime(endpoint, elapsedUsecs() - startUsecs);
+
+	// The transport error was already recorded when the reply finished, this adds the parse error code
+	if (networkReply->error() != QNetworkReply::NoError && doc.object().contains("code"))
+		recordError(endpoint, QString("parse:%1").arg(doc.object().value("code").toInt()));
+
+	return doc;
+}
+
+qint64 PFMetrics::elapsedUsecs()
+{
+	return _clock.nsecsElapsed() / 1000;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Reply Slots
+#endif
+
+void PFMetrics::handleReplyMetaDataChanged()
+{
+	markFirstByte(qobject_cast<QNetworkReply*>(sender()));
+}
+
+void PFMetrics::handleReplyUploadProgress(qint64 bytesSent, qint64 bytesTotal)
+{
+	Q_UNUSED(bytesTotal);
+	QHash<QNetworkReply*, PendingReply>::iterator iter = _pendingReplies.find(qobject_cast<QNetworkReply*>(sender()));
+	if (iter != _pendingReplies.end())
+		iter->bytesSent = qMax(iter->bytesSent, bytesSent);
+}
+
+void PFMetrics::handleReplyDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
+{
+	Q_UNUSED(bytesTotal);
+	QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+	if (bytesReceived > 0)
+		markFirstByte(reply);
+
+	QHash<QNetworkReply*, PendingReply>::iterator iter = _pendingReplies.find(reply);
+	if (iter != _pendingReplies.end())
+		iter->bytesReceived = qMax(iter->bytesReceived, bytesReceived);
+}
+
+void PFMetrics::handleReplyFinished()
+{
+	QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+	if (!_pendingReplies.contains(reply))
+		return;
+
+	PendingReply pendingReply = _pendingReplies.take(reply);
+	qint64 finishedUsecs = elapsedUsecs();
+
+	// Errors are keyed by the http status when the server answered, otherwise by the network error
+	QString error;
+	if (reply->error() != QNetworkReply::NoError)
+	{
+		QVariant statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+		if (statusCode.isValid())
+			error = QString("http:%1").arg(statusCode.toInt());
+		else
+			error = QString("network:%1").arg(int(reply->error()));
+	}
+
+	QMutexLocker lock(&_mutex);
+	EndpointMetrics& endpointMetrics = _endpoints[pendingReply.endpoint];
+	++endpointMetrics.requests;
+	endpointMetrics.bytesSent += pendingReply.bytesSent;
+	endpointMetrics.bytesReceived += pendingReply.bytesReceived;
+	endpointMetrics.latency.record(finishedUsecs - pendingReply.startUsecs);
+	if (pendingReply.firstByteUsecs >= 0)
+		endpointMetrics.timeToFirstByte.record(pendingReply.firstByteUsecs - pendingReply.startUsecs);
+	if (!error.isEmpty())
+		++endpointMetrics.errors[error];
+}
+
+void PFMetrics::handleReplyDestroyed(QObject* object)
+{
+	// Replies normally finish before they're deleted, this only drops the ones that never did
+	_pendingReplies.remove(static_cast<QNetworkReply*>(object));
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Timer Slots
+#endif
+
+void PFMetrics::handleDumpTimeout()
+{
+	QJsonObject snapshotObject = snapshot();
+	QByteArray snapshotJson = QJsonDocument(snapshotObject).toJson(QJsonDocument::Compact);
+	qCDebug(PFLogMetrics).nospace() << "Metrics: " << snapshotJson.constData();
+	emit metricsDumped(snapshotObject);
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Metrics Helper Methods
+#endif
+
+void PFMetrics::markFirstByte(QNetworkReply* reply)
+{
+	QHash<QNetworkReply*, PendingReply>::iterator iter = _pendingReplies.find(reply);
+	if (iter != _pendingReplies.end() && iter->firstByteUsecs < 0)
+		iter->firstByteUsecs = elapsedUsecs();
+}
+
+QJsonObject PFMetrics::histogramToJson(const PFHistogram& histogram)
+{
+	QJsonObject jsonObject;
+	jsonObject["count"] = double(histogram.count());
+	jsonObject["min"] = histogram.minimum() / 1000.0;
+	jsonObject["mean"] = histogram.mean() / 1000.0;
+	jsonObject["p50"] = histogram.valueAtPercentile(50.0) / 1000.0;
+	jsonObject["p90"] = histogram.valueAtPercentile(90.0) / 1000.0;
+	jsonObject["p99"] = histogram.valueAtPercentile(99.0) / 1000.0;
+	jsonObject["max"] = histogram.maximum() / 1000.0;
+
+	return jsonObject;
+}
+
+}	// End of parse namespace
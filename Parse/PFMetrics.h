@@ -0,0 +1,150 @@
+//
+//  PFMetrics.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFMETRICS_H
+#define PARSE_PFMETRICS_H
+
+// Parse headers
+#include "PFHistogram.h"
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+namespace parse {
+
+// Collects request metrics for each REST endpoint (classes, batch, users, login, files and other). Every reply
+// created through the PFManager network access manager is tracked for its request count, bytes sent and
+// received, time to first byte, total latency and errors. The deserializers report how long the json decode
+// took and the PFTransferManager how long files waited in its queue. Times are recorded in microseconds in
+// PFHistograms and reported in milliseconds.
+class PFMetrics : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Returns the metrics of every endpoint with recorded requests as json, for example:
+	//
+	//     { "classes": { "requests": 12, "bytesSent": 1024, "bytesReceived": 8192, "errors": { "http:404": 1 },
+	//                    "latency": { "count": 12, "min": 20.1, "mean": 48.2, "p50": 45.0, "p90": 80.3,
+	//                                 "p99": 96.7, "max": 97.0 }, "timeToFirstByte": {...},
+	//                    "queueWait": {...}, "decodeTime": {...} } }
+	QJsonObject snapshot();
+
+	// Clears every recorded metric (requests still running get recorded once they finish)
+	void reset();
+
+	// Logs the snapshot to the parse.metrics logging category and emits metricsDumped every interval
+	// (in msecs). Defaults to 0 which turns the periodic dump off.
+	void setDumpInterval(int dumpInterval);
+	int dumpInterval();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods
+	static PFMetricsPtr metrics();
+
+	// Returns the endpoint name for the request url
+	static QString endpointForUrl(const QUrl& url);
+
+	// Starts tracking the reply until it finishes (called by the network access manager)
+	void trackReply(QNetworkReply* reply, qint64 bytesToSend);
+
+	// Recording Methods - times are in microseconds
+	void recordQueueWait(const QString& endpoint, qint64 usecs);
+	void recordDecodeTime(const QString& endpoint, qint64 usecs);
+	void recordError(const QString& endpoint, const QString& error);
+
+	// Reads and decodes the json body of the reply, recording the decode time and the parse error code of
+	// failed requests against the endpoint of the reply
+	QJsonDocument decodeReply(QNetworkReply* networkReply);
+
+	// Microseconds since the metrics were created
+	qint64 elapsedUsecs();
+
+signals:
+
+	// Emitted with the snapshot on every periodic dump
+	void metricsDumped(const QJsonObject& snapshot);
+
+protected slots:
+
+	// Reply Slots
+	void handleReplyMetaDataChanged();
+	void handleReplyUploadProgress(qint64 bytesSent, qint64 bytesTotal);
+	void handleReplyDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+	void handleReplyFinished();
+	void handleReplyDestroyed(QObject* object);
+
+	// Timer Slots
+	void handleDumpTimeout();
+
+protected:
+
+	// Constructor / Destructor
+	PFMetrics();
+	~PFMetrics();
+
+	// Metrics of a single endpoint
+	struct EndpointMetrics
+	{
+		EndpointMetrics() : requests(0), bytesSent(0), bytesReceived(0) {}
+
+		qint64					requests;
+		qint64					bytesSent;
+		qint64					bytesReceived;
+		QMap<QString, qint64>	errors;
+		PFHistogram				queueWait;
+		PFHistogram				timeToFirstByte;
+		PFHistogram				latency;
+		PFHistogram				decodeTime;
+	};
+
+	// A reply that hasn't finished yet
+	struct PendingReply
+	{
+		QString		endpoint;
+		qint64		startUsecs;
+		qint64		firstByteUsecs;
+		qint64		bytesSent;
+		qint64		bytesReceived;
+	};
+
+	// Metrics Helper Methods
+	void markFirstByte(QNetworkReply* reply);
+	static QJsonObject histogramToJson(const PFHistogram& histogram);
+
+	// Instance members
+	QElapsedTimer							_clock;
+	QMutex									_mutex;
+	QHash<QString, EndpointMetrics>			_endpoints;
+	QHash<QNetworkReply*, PendingReply>		_pendingReplies;
+	QTimer									_dumpTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFMETRICS_H
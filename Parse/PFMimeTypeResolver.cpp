@@ -0,0 +1,104 @@
+//
+//  PFMimeTypeResolver.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFMimeTypeResolver.h"
+
+// Qt headers
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+namespace parse {
+
+// Static Globals
+static QMutex gPFMimeTypeResolverMutex;
+static const qint64 gHeaderSize = 16 * 1024;
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFMimeTypeResolver::PFMimeTypeResolver()
+{
+	// No-op
+}
+
+PFMimeTypeResolver::~PFMimeTypeResolver()
+{
+	// No-op
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFMimeTypeResolver* PFMimeTypeResolver::sharedResolver()
+{
+	QMutexLocker lock(&gPFMimeTypeResolverMutex);
+	static PFMimeTypeResolver resolver;
+	return &resolver;
+}
+
+qint64 PFMimeTypeResolver::headerSize()
+{
+	return gHeaderSize;
+}
+
+#ifdef __APPLE__
+#pragma mark - Lookup Methods
+#endif
+
+QMimeType PFMimeTypeResolver::mimeTypeForData(const QByteArray& data)
+{
+	// Sniff the header only without copying it out of the data
+	QByteArray header = QByteArray::fromRawData(data.constData(), qMin<qint64>(data.size(), gHeaderSize));
+	return _mimeDatabase.mimeTypeForData(header);
+}
+
+QMimeType PFMimeTypeResolver::mimeTypeForFileName(const QString& fileName)
+{
+	// Names with multiple suffixes (e.g. archive.tar.gz) can match longer globs so don't share a cache entry
+	QFileInfo fileInfo(fileName);
+	QString suffix = fileInfo.suffix().toLower();
+	if (suffix.isEmpty() || fileInfo.completeSuffix().length() != fileInfo.suffix().length())
+	{
+		QList<QMimeType> mimeTypes = _mimeDatabase.mimeTypesForFileName(fileName);
+		return (mimeTypes.count() == 1) ? mimeTypes.first() : QMimeType();
+	}
+
+	QMutexLocker lock(&_mutex);
+	QHash<QString, QMimeType>::const_iterator iter = _suffixMimeTypes.constFind(suffix);
+	if (iter != _suffixMimeTypes.constEnd())
+		return iter.value();
+
+	// Only an extension that maps to a single mime type is trusted, the rest need to be sniffed (an invalid
+	// mime type is cached for those as well so we don't ask the database again)
+	QList<QMimeType> mimeTypes = _mimeDatabase.mimeTypesForFileName("file." + suffix);
+	QMimeType mimeType = (mimeTypes.count() == 1) ? mimeTypes.first() : QMimeType();
+	_suffixMimeTypes.insert(suffix, mimeType);
+
+	return mimeType;
+}
+
+QMimeType PFMimeTypeResolver::mimeTypeForFile(const QString& fileName, const QString& filepath)
+{
+	QMimeType mimeType = mimeTypeForFileName(fileName);
+	if (mimeType.isValid())
+		return mimeType;
+
+	// Fall back to the header of the file
+	QByteArray header;
+	QFile file(filepath);
+	if (file.open(QIODevice::ReadOnly))
+		header = file.read(gHeaderSize);
+
+	return _mimeDatabase.mimeTypeForFileNameAndData(fileName, header);
+}
+
+}	// End of parse namespace
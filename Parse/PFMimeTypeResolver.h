@@ -0,0 +1,58 @@
+//
+//  PFMimeTypeResolver.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFMIMETYPERESOLVER_H
+#define PARSE_PFMIMETYPERESOLVER_H
+
+// Qt headers
+#include <QByteArray>
+#include <QHash>
+#include <QMimeDatabase>
+#include <QMimeType>
+#include <QMutex>
+#include <QString>
+
+namespace parse {
+
+// Process-wide mime type lookups for PFFile. A single mime database is shared by all the files, content
+// sniffing only ever looks at the first few KB of the data, and the mime type for each file extension is
+// cached so files with an unambiguous extension never have to be sniffed (or even opened) at all.
+class PFMimeTypeResolver
+{
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creates a singleton instance of the PFMimeTypeResolver
+	static PFMimeTypeResolver* sharedResolver();
+
+	// The number of leading bytes used to sniff the mime type of some data
+	static qint64 headerSize();
+
+	// Lookup Methods - these are thread-safe
+	QMimeType mimeTypeForData(const QByteArray& data);
+	QMimeType mimeTypeForFileName(const QString& fileName);
+	QMimeType mimeTypeForFile(const QString& fileName, const QString& filepath);
+
+protected:
+
+	// Constructor / Destructor
+	PFMimeTypeResolver();
+	~PFMimeTypeResolver();
+
+	// Instance members
+	QMimeDatabase				_mimeDatabase;
+	QMutex						_mutex;
+	QHash<QString, QMimeType>	_suffixMimeTypes;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFMIMETYPERESOLVER_H
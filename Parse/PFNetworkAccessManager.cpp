@@ -0,0 +1,471 @@
+//
+//  PFNetworkAccessManager.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFError.h"
+#include "PFLogging.h"
+#include "PFMetrics.h"
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkReply.h"
+#include "PFRetryReply.h"
+
+// Qt headers
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace parse {
+
+// Static Globals
+static const QString gApiHost = "api.parse.com";
+static const QNetworkRequest::Attribute gAttemptAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 2);
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFNetworkAccessManager::PFNetworkAccessManager() :
+	_requestDeduplicationEnabled(true)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFNetworkAccessManager(" << QString().sprintf("%8p", this) << ")";
+	_clock.start();
+	_randomEngine.seed(std::random_device()());
+	_circuitBreaker.setRetryPolicy(_retryPolicy);
+}
+
+PFNetworkAccessManager::~PFNetworkAccessManager()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFNetworkAccessManager(" << QString().sprintf("%8p", this) << ")";
+}
+
+#ifdef __APPLE__
+#pragma mark - User API
+#endif
+
+void PFNetworkAccessManager::addInterceptor(PFNetworkInterceptorPtr interceptor)
+{
+	if (!interceptor.isNull() && !_interceptors.contains(interceptor))
+		_interceptors.append(interceptor);
+}
+
+void PFNetworkAccessManager::removeInterceptor(PFNetworkInterceptorPtr interceptor)
+{
+	_interceptors.removeAll(interceptor);
+}
+
+QList<PFNetworkInterceptorPtr> PFNetworkAccessManager::interceptors()
+{
+	return _interceptors;
+}
+
+void PFNetworkAccessManager::setRetryPolicy(const PFRetryPolicy& retryPolicy)
+{
+	_retryPolicy = retryPolicy;
+	_circuitBreaker.setRetryPolicy(retryPolicy);
+}
+
+PFRetryPolicy PFNetworkAccessManager::retryPolicy()
+{
+	return _retryPolicy;
+}
+
+PFCircuitBreaker::State PFNetworkAccessManager::circuitStateForHost(const QString& host)
+{
+	return _circuitBreaker.stateForHost(host, _clock.elapsed());
+}
+
+PFRequestScheduler* PFNetworkAccessManager::requestScheduler()
+{
+	return &_requestScheduler;
+}
+
+void PFNetworkAccessManager::setRequestDeduplicationEnabled(bool enabled)
+{
+	_requestDeduplicationEnabled = enabled;
+}
+
+bool PFNetworkAccessManager::requestDeduplicationEnabled()
+{
+	return _requestDeduplicationEnabled;
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+void PFNetworkAccessManager::setMetrics(PFMetricsPtr metrics)
+{
+	_metrics = metrics;
+}
+
+qint64 PFNetworkAccessManager::elapsedUsecs()
+{
+	return _clock.nsecsElapsed() / 1000;
+}
+
+bool PFNetworkAccessManager::allowRequest(const QUrl& url)
+{
+	return _circuitBreaker.allowRequest(url.host(), _clock.elapsed());
+}
+
+QByteArray PFNetworkAccessManager::circuitOpenBody(const QUrl& url)
+{
+	QJsonObject jsonObject;
+	jsonObject["code"] = kPFErrorConnectionFailed;
+	jsonObject["error"] = QString("Circuit open for host %1").arg(url.host());
+
+	return QJsonDocument(jsonObject).toJson(QJsonDocument::Compact);
+}
+
+QNetworkReply* PFNetworkAccessManager::sendRequestAttempt(Operation op, const QNetworkRequest& request, const QByteArray& body)
+{
+	QBuffer* buffer = NULL;
+	if (!body.isEmpty())
+	{
+		buffer = new QBuffer();
+		buffer->setData(body);
+		buffer->open(QIODevice::ReadOnly);
+	}
+
+	QNetworkReply* reply = sendRequest(op, request, buffer, true);
+	if (buffer)
+		buffer->setParent(reply);
+
+	return reply;
+}
+
+QNetworkReply* PFNetworkAccessManager::sendRequestAttempt(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+	return sendRequest(op, request, outgoingData, true);
+}
+
+bool PFNetworkAccessManager::isAttemptReply(QNetworkReply* reply)
+{
+	return reply && reply->request().attribute(gAttemptAttribute).toBool();
+}
+
+double PFNetworkAccessManager::nextRandom()
+{
+	return std::uniform_real_distribution<double>(0.0, 1.0)(_randomEngine);
+}
+
+void PFNetworkAccessManager::recordQueueWait(const QUrl& url, qint64 usecs)
+{
+	if (!_metrics.isNull())
+		_metrics->recordQueueWait(PFMetrics::endpointForUrl(url), usecs);
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Reply Slots
+#endif
+
+void PFNetworkAccessManager::handleReplyReadChannelFinished()
+{
+	// Replies emit readChannelFinished right before finished, which lets the interceptors see the reply
+	// before the SDK reads it in its finished handlers
+	finishPendingRequest(qobject_cast<QNetworkReply*>(sender()));
+}
+
+void PFNetworkAccessManager::handleReplyFinished()
+{
+	// Aborted replies only emit finished
+	finishPendingRequest(qobject_cast<QNetworkReply*>(sender()));
+}
+
+void PFNetworkAccessManager::handleReplyDestroyed(QObject* object)
+{
+	_pendingRequests.remove(static_cast<QNetworkReply*>(object));
+}
+
+void PFNetworkAccessManager::handleLocalReplyFinished()
+{
+	// Retry replies, the replies of open circuits and those of shared requests never went through
+	// QNetworkAccessManager either
+	emit finished(qobject_cast<QNetworkReply*>(sender()));
+}
+
+void PFNetworkAccessManager::handleTransportReplyFinished()
+{
+	QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+	if (!reply)
+		return;
+
+	// Rejected for going over the request limit, which says nothing about the health of the host. The requests
+	// that follow would be rejected as well so the scheduler holds them.
+	QString host = reply->request().url().host();
+	QNetworkReply::NetworkError networkError = reply->error();
+	int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	if (statusCode == 429)
+	{
+		if (isScheduledRequest(reply->request()))
+			_requestScheduler.pause(PFRequestScheduler::retryAfterForReply(reply));
+		_circuitBreaker.recordCanceled(host);
+		return;
+	}
+
+	if (networkError == QNetworkReply::OperationCanceledError)
+		_circuitBreaker.recordCanceled(host);
+	else if (PFRetryPolicy::isTransientFailure(networkError, statusCode))
+		_circuitBreaker.recordFailure(host, _clock.elapsed());
+	else
+		_circuitBreaker.recordSuccess(host);
+}
+
+void PFNetworkAccessManager::handleSharedReplyFinished()
+{
+	QNetworkReply* sharedReply = qobject_cast<QNetworkReply*>(sender());
+	if (!sharedReply)
+		return;
+
+	QHash<QByteArray, SharedRequest>::iterator iter = _sharedRequests.find(sharedRequestKey(sharedReply->operation(), sharedReply->request()));
+	if (iter == _sharedRequests.end() || iter.value().reply != sharedReply)
+		return;
+
+	// The request is done before the callers hear about it, so the GETs they send in their finished handlers
+	// go out again instead of joining a request that already finished
+	QList<QPointer<PFNetworkReply> > subscribers = iter.value().subscribers;
+	_sharedRequests.erase(iter);
+	QByteArray data = sharedReply->readAll();
+	sharedReply->deleteLater();
+
+	foreach (QPointer<PFNetworkReply> subscriber, subscribers)
+	{
+		if (subscriber && !subscriber->isFinished())
+			subscriber->finishWithReply(sharedReply, data);
+	}
+}
+
+void PFNetworkAccessManager::handleSubscriberFinished()
+{
+	PFNetworkReply* reply = qobject_cast<PFNetworkReply*>(sender());
+	if (!reply || reply->error() != QNetworkReply::OperationCanceledError)
+		return;
+
+	QHash<QByteArray, SharedRequest>::iterator iter = _sharedRequests.find(sharedRequestKey(reply->operation(), reply->request()));
+	if (iter == _sharedRequests.end())
+		return;
+
+	// Other callers are still waiting on the response
+	foreach (QPointer<PFNetworkReply> subscriber, iter.value().subscribers)
+	{
+		if (subscriber && !subscriber->isFinished())
+			return;
+	}
+
+	QNetworkReply* sharedReply = iter.value().reply;
+	_sharedRequests.erase(iter);
+	sharedReply->disconnect(this);
+	sharedReply->abort();
+	sharedReply->deleteLater();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected QNetworkAccessManager Methods
+#endif
+
+QNetworkReply* PFNetworkAccessManager::createRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+	// Open circuits fail right away without touching the network
+	if (!allowRequest(request.url()))
+	{
+		QNetworkReply* reply = PFNetworkReply::replyWithError(request, op, QNetworkReply::TemporaryNetworkFailureError,
+															  QString("Circuit open for host %1").arg(request.url().host()),
+															  circuitOpenBody(request.url()));
+		reply->setParent(this);
+		if (!_metrics.isNull())
+			_metrics->trackReply(reply, 0);
+		QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleLocalReplyFinished()));
+
+		return reply;
+	}
+
+	// Identical GETs that are already in flight get answered by the same response
+	if (op == GetOperation && _requestDeduplicationEnabled && isScheduledRequest(request))
+		return subscribeToSharedRequest(op, request, outgoingData);
+
+	// Requests that are only sent once go right out when the scheduler has a token for them
+	bool isRetryable = isRetryableRequest(op, request, outgoingData);
+	if (!isRetryable && (!isScheduledRequest(request) || _requestScheduler.tryAcquire()))
+		return sendRequest(op, request, outgoingData, false);
+
+	// The others get a retry reply which sends the attempts as the scheduler hands out the tokens
+	PFRetryPolicy retryPolicy = isRetryable ? _retryPolicy : PFRetryPolicy::noRetryPolicy();
+	PFRetryReply* reply = PFRetryReply::replyWithRequest(this, request, op, outgoingData, retryPolicy);
+	reply->setParent(this);
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleLocalReplyFinished()));
+
+	return reply;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Request Helper Methods
+#endif
+
+QNetworkReply* PFNetworkAccessManager::sendRequest(Operation op, const QNetworkRequest& originalRequest, QIODevice* outgoingData, bool isAttempt)
+{
+	// Attempts go through QNetworkAccessManager like every other request, so they share its configuration and
+	// connections, but the SDK has to tell them apart from the replies it was handed in the finished signal
+	QNetworkRequest request = originalRequest;
+	if (isAttempt)
+		request.setAttribute(gAttemptAttribute, true);
+
+	// Sequential devices don't know their size up front, the upload progress fills in what they actually sent
+	qint64 bytesToSend = 0;
+	if (outgoingData && !outgoingData->isSequential())
+		bytesToSend = outgoingData->size() - outgoingData->pos();
+
+	// Fast path
+	if (_interceptors.isEmpty())
+	{
+		QNetworkReply* reply = QNetworkAccessManager::createRequest(op, request, outgoingData);
+		if (!_metrics.isNull())
+			_metrics->trackReply(reply, bytesToSend);
+		QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleTransportReplyFinished()));
+
+		return reply;
+	}
+
+	// Run the request through the interceptors until one of them answers it
+	PendingRequest pendingRequest;
+	pendingRequest.context.operation = op;
+	pendingRequest.context.request = request;
+	pendingRequest.context.outgoingData = outgoingData;
+	pendingRequest.context.startUsecs = elapsedUsecs();
+	foreach (PFNetworkInterceptorPtr interceptor, _interceptors)
+	{
+		pendingRequest.interceptors.append(interceptor);
+		interceptor->willSendRequest(pendingRequest.context);
+		if (pendingRequest.context.reply)
+			break;
+	}
+
+	QNetworkReply* reply = pendingRequest.context.reply;
+	pendingRequest.isInterceptedReply = (reply != 0);
+	pendingRequest.isAttempt = isAttempt;
+	if (reply)
+	{
+		reply->setParent(this);
+	}
+	else if (pendingRequest.context.hasReplacementBody)
+	{
+		QBuffer* buffer = new QBuffer();
+		buffer->setData(pendingRequest.context.replacementBody);
+		buffer->open(QIODevice::ReadOnly);
+		bytesToSend = buffer->size();
+		pendingRequest.context.request.setHeader(QNetworkRequest::ContentLengthHeader, bytesToSend);
+		reply = QNetworkAccessManager::createRequest(op, pendingRequest.context.request, buffer);
+		buffer->setParent(reply);
+	}
+	else
+	{
+		reply = QNetworkAccessManager::createRequest(op, pendingRequest.context.request, outgoingData);
+	}
+
+	pendingRequest.context.reply = reply;
+	pendingRequest.context.sendUsecs = elapsedUsecs();
+	_pendingRequests.insert(reply, pendingRequest);
+
+	if (!_metrics.isNull())
+		_metrics->trackReply(reply, bytesToSend);
+
+	QObject::connect(reply, SIGNAL(readChannelFinished()), this, SLOT(handleReplyReadChannelFinished()));
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleReplyFinished()));
+	QObject::connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(handleReplyDestroyed(QObject*)));
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleTransportReplyFinished()));
+
+	return reply;
+}
+
+bool PFNetworkAccessManager::isRetryableRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+	// File downloads resume where they left off on their own
+	if (_retryPolicy.maximumAttempts() <= 1 || !isScheduledRequest(request))
+		return false;
+
+	QByteArray body;
+	if (op == PutOperation && outgoingData)
+		body = outgoingData->peek(outgoingData->bytesAvailable());
+
+	return PFRetryPolicy::isIdempotent(op, body);
+}
+
+bool PFNetworkAccessManager::isScheduledRequest(const QNetworkRequest& request)
+{
+	// The request limit only counts REST API requests
+	return request.url().host() == gApiHost;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Deduplication Helper Methods
+#endif
+
+QNetworkReply* PFNetworkAccessManager::subscribeToSharedRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+	// The shared request is a retry reply nobody but the manager sees, so it never emits the finished signal
+	// of the manager and the scheduler and retry policy apply to it like to any other request
+	QByteArray key = sharedRequestKey(op, request);
+	QHash<QByteArray, SharedRequest>::iterator iter = _sharedRequests.find(key);
+	if (iter == _sharedRequests.end())
+	{
+		PFRetryPolicy retryPolicy = isRetryableRequest(op, request, outgoingData) ? _retryPolicy : PFRetryPolicy::noRetryPolicy();
+		SharedRequest sharedRequest;
+		sharedRequest.reply = PFRetryReply::replyWithRequest(this, request, op, outgoingData, retryPolicy);
+		sharedRequest.reply->setParent(this);
+		QObject::connect(sharedRequest.reply, SIGNAL(finished()), this, SLOT(handleSharedReplyFinished()));
+		iter = _sharedRequests.insert(key, sharedRequest);
+	}
+	else
+	{
+		qCDebug(PFLogManager).nospace() << "Joining the request to " << request.url().toString() << " already in flight ("
+										<< iter.value().subscribers.count() + 1 << " callers)";
+	}
+
+	PFNetworkReply* reply = PFNetworkReply::pendingReplyWithRequest(request, op);
+	reply->setParent(this);
+	iter.value().subscribers.append(reply);
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleSubscriberFinished()));
+	QObject::connect(reply, SIGNAL(finished()), this, SLOT(handleLocalReplyFinished()));
+
+	return reply;
+}
+
+QByteArray PFNetworkAccessManager::sharedRequestKey(Operation op, const QNetworkRequest& request)
+{
+	// Users only share responses they're allowed to see
+	QByteArray key = QByteArray::number(int(op)) + " " + request.url().toEncoded();
+	key += "\n" + request.rawHeader("X-Parse-Application-Id");
+	key += "\n" + request.rawHeader("X-Parse-Session-Token");
+	key += "\n" + request.rawHeader("X-Parse-Master-Key");
+
+	return key;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Interceptor Helper Methods
+#endif
+
+void PFNetworkAccessManager::finishPendingRequest(QNetworkReply* reply)
+{
+	QHash<QNetworkReply*, PendingRequest>::iterator iter = _pendingRequests.find(reply);
+	if (iter == _pendingRequests.end())
+		return;
+
+	PendingRequest pendingRequest = iter.value();
+	_pendingRequests.erase(iter);
+	pendingRequest.context.finishedUsecs = elapsedUsecs();
+
+	for (int i = pendingRequest.interceptors.count() - 1; i >= 0; --i)
+		pendingRequest.interceptors.at(i)->didFinishReply(pendingRequest.context, reply);
+
+	// Replies made up by an interceptor never went through QNetworkAccessManager, so the finished signal the
+	// SDK waits on has to come from here (the retry reply reports its own)
+	if (pendingRequest.isInterceptedReply && !pendingRequest.isAttempt)
+		emit finished(reply);
+}
+
+}	// End of parse namespace
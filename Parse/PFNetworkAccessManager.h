@@ -0,0 +1,169 @@
+//
+//  PFNetworkAccessManager.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFNETWORKACCESSMANAGER_H
+#define PARSE_PFNETWORKACCESSMANAGER_H
+
+// Parse headers
+#include "PFCircuitBreaker.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
+#include "PFRequestScheduler.h"
+#include "PFRetryPolicy.h"
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QHash>
+#include <QIODevice>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QUrl>
+
+// C++ headers
+#include <random>
+
+namespace parse {
+
+// The network access manager behind PFManager::networkAccessManager(). Every request the SDK makes goes
+// through createRequest, which runs it through the interceptor chain and hands the reply to the PFMetrics of
+// the manager to be tracked. Without any interceptors requests go straight to QNetworkAccessManager.
+//
+// Requests to hosts whose circuit is open fail right away and idempotent REST API requests are retried as
+// the PFRetryPolicy says (file downloads resume on their own). REST API requests also wait their turn with
+// the PFRequestScheduler when the app has a request limit. The manager hands out a PFRetryReply for requests
+// that get retried or have to wait, each attempt runs through the interceptors and the metrics as a request
+// of its own and is reported by the finished signal as well.
+//
+// REST API GETs with the same url, application and session that are in flight at the same time share a single
+// request, so widgets fetching the same object or running the same query together cost one round trip. Every
+// caller still gets a reply of its own which finishes with the response of the shared request, and the shared
+// request is only aborted once all of its callers aborted.
+class PFNetworkAccessManager : public QNetworkAccessManager
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Interceptor Methods - requests that are already running keep the interceptors they were sent with
+	void addInterceptor(PFNetworkInterceptorPtr interceptor);
+	void removeInterceptor(PFNetworkInterceptorPtr interceptor);
+	QList<PFNetworkInterceptorPtr> interceptors();
+
+	// Retry Methods - requests that are already running keep the policy they were sent with
+	void setRetryPolicy(const PFRetryPolicy& retryPolicy);
+	PFRetryPolicy retryPolicy();
+
+	// Returns the state of the circuit breaker for the host
+	PFCircuitBreaker::State circuitStateForHost(const QString& host);
+
+	// Returns the scheduler that keeps the REST API requests under the request limit
+	PFRequestScheduler* requestScheduler();
+
+	// Deduplication Methods - identical GETs share the request that's in flight (enabled by default)
+	void setRequestDeduplicationEnabled(bool enabled);
+	bool requestDeduplicationEnabled();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Constructor / Destructor (owned by PFManager)
+	PFNetworkAccessManager();
+	~PFNetworkAccessManager();
+
+	// The metrics every reply gets reported to
+	void setMetrics(PFMetricsPtr metrics);
+
+	// Microseconds since the manager was created (the clock of the PFNetworkContext times)
+	qint64 elapsedUsecs();
+
+	// Circuit Breaker Methods - allowRequest hands out the trial request of half open circuits
+	bool allowRequest(const QUrl& url);
+	static QByteArray circuitOpenBody(const QUrl& url);
+
+	// Retry Reply Methods - sends a single attempt of a retry reply, returns a random value in [0, 1) for the
+	// backoff jitter and records how long a reply waited for the scheduler
+	QNetworkReply* sendRequestAttempt(Operation op, const QNetworkRequest& request, const QByteArray& body);
+	QNetworkReply* sendRequestAttempt(Operation op, const QNetworkRequest& request, QIODevice* outgoingData);
+	double nextRandom();
+	void recordQueueWait(const QUrl& url, qint64 usecs);
+
+	// Returns whether the reply belongs to a single attempt of a retry reply. Attempts go through
+	// QNetworkAccessManager like every other request, so the finished signal reports them next to the reply
+	// that was handed out. Slots connected to finished should check for the reply they were handed (the SDK
+	// does) or skip the attempts with this method.
+	static bool isAttemptReply(QNetworkReply* reply);
+
+protected slots:
+
+	// Reply Slots
+	void handleReplyReadChannelFinished();
+	void handleReplyFinished();
+	void handleReplyDestroyed(QObject* object);
+	void handleLocalReplyFinished();
+	void handleTransportReplyFinished();
+	void handleSharedReplyFinished();
+	void handleSubscriberFinished();
+
+protected:
+
+	// QNetworkAccessManager Methods
+	virtual QNetworkReply* createRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData = 0);
+
+	// A request that went through the interceptor chain and hasn't finished yet
+	struct PendingRequest
+	{
+		PFNetworkContext					context;
+		QList<PFNetworkInterceptorPtr>		interceptors;
+		bool								isInterceptedReply;
+		bool								isAttempt;
+	};
+
+	// A GET in flight and the callers waiting on its response
+	struct SharedRequest
+	{
+		QNetworkReply*						reply;
+		QList<QPointer<PFNetworkReply> >	subscribers;
+	};
+
+	// Request Helper Methods
+	QNetworkReply* sendRequest(Operation op, const QNetworkRequest& originalRequest, QIODevice* outgoingData, bool isAttempt);
+	bool isRetryableRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData);
+	bool isScheduledRequest(const QNetworkRequest& request);
+
+	// Deduplication Helper Methods
+	QNetworkReply* subscribeToSharedRequest(Operation op, const QNetworkRequest& request, QIODevice* outgoingData);
+	static QByteArray sharedRequestKey(Operation op, const QNetworkRequest& request);
+
+	// Interceptor Helper Methods
+	void finishPendingRequest(QNetworkReply* reply);
+
+	// Instance members
+	PFMetricsPtr								_metrics;
+	QElapsedTimer								_clock;
+	QList<PFNetworkInterceptorPtr>				_interceptors;
+	QHash<QNetworkReply*, PendingRequest>		_pendingRequests;
+	PFRetryPolicy								_retryPolicy;
+	PFCircuitBreaker							_circuitBreaker;
+	PFRequestScheduler							_requestScheduler;
+	std::mt19937								_randomEngine;
+	bool										_requestDeduplicationEnabled;
+	QHash<QByteArray, SharedRequest>			_sharedRequests;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFNETWORKACCESSMANAGER_H
@@ -0,0 +1,66 @@
+//
+//  PFNetworkInterceptor.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFNetworkInterceptor.h"
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - PFNetworkContext Methods
+#endif
+
+PFNetworkContext::PFNetworkContext() :
+	operation(QNetworkAccessManager::UnknownOperation),
+	outgoingData(0),
+	hasReplacementBody(false),
+	reply(0),
+	startUsecs(0),
+	sendUsecs(0),
+	finishedUsecs(0)
+{
+	// No-op
+}
+
+QByteArray PFNetworkContext::body() const
+{
+	if (hasReplacementBody)
+		return replacementBody;
+	else if (outgoingData)
+		return outgoingData->peek(outgoingData->bytesAvailable());
+
+	return QByteArray();
+}
+
+void PFNetworkContext::setBody(const QByteArray& body)
+{
+	replacementBody = body;
+	hasReplacementBody = true;
+}
+
+#ifdef __APPLE__
+#pragma mark - PFNetworkInterceptor Methods
+#endif
+
+PFNetworkInterceptor::~PFNetworkInterceptor()
+{
+	// No-op
+}
+
+void PFNetworkInterceptor::willSendRequest(PFNetworkContext& context)
+{
+	Q_UNUSED(context);
+}
+
+void PFNetworkInterceptor::didFinishReply(PFNetworkContext& context, QNetworkReply* reply)
+{
+	Q_UNUSED(context);
+	Q_UNUSED(reply);
+}
+
+}	// End of parse namespace
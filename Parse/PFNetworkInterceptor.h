@@ -0,0 +1,72 @@
+//
+//  PFNetworkInterceptor.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFNETWORKINTERCEPTOR_H
+#define PARSE_PFNETWORKINTERCEPTOR_H
+
+// Qt headers
+#include <QByteArray>
+#include <QIODevice>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QVariantMap>
+
+namespace parse {
+
+// Everything an interceptor gets to see about a request. The request, its body and the user data can be
+// changed before it's sent, setting a reply answers the request without sending it (the remaining
+// interceptors are skipped). Times are in microseconds on the clock of the network access manager.
+struct PFNetworkContext
+{
+	PFNetworkContext();
+
+	// Body Methods - body() peeks at the outgoing data without consuming it, setBody() replaces it
+	QByteArray body() const;
+	void setBody(const QByteArray& body);
+
+	QNetworkAccessManager::Operation	operation;
+	QNetworkRequest						request;
+	QIODevice*							outgoingData;
+	QByteArray							replacementBody;
+	bool								hasReplacementBody;
+	QNetworkReply*						reply;
+
+	qint64								startUsecs;		// Entered the interceptor chain
+	qint64								sendUsecs;		// Left the interceptor chain
+	qint64								finishedUsecs;	// The reply finished
+
+	// State the interceptors want to carry from willSendRequest over to didFinishReply (span ids, cache keys...)
+	QVariantMap							userData;
+};
+
+// A hook into every request the SDK sends through PFManager::networkAccessManager() (see
+// PFNetworkAccessManager::addInterceptor). Interceptors see requests in the order they were added and replies
+// in the reverse order, so the first interceptor wraps all the others. didFinishReply runs as the reply
+// finishes, before the SDK reads it, so the reply can still be peeked at but must not be read.
+class PFNetworkInterceptor
+{
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Destructor
+	virtual ~PFNetworkInterceptor();
+
+	// Called before the request is sent (the default implementation does nothing)
+	virtual void willSendRequest(PFNetworkContext& context);
+
+	// Called once the reply finished (the default implementation does nothing)
+	virtual void didFinishReply(PFNetworkContext& context, QNetworkReply* reply);
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFNETWORKINTERCEPTOR_H
@@ -0,0 +1,192 @@
+//
+//  PFNetworkReply.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+#include "PFNetworkReply.h"
+
+// Qt headers
+#include <QMetaObject>
+
+// C++ headers
+#include <cstring>
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFNetworkReply::PFNetworkReply(const QNetworkRequest& request, QNetworkAccessManager::Operation operation, bool finishOnStart) :
+	_offset(0),
+	_statusCode(0),
+	_networkError(QNetworkReply::NoError)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFNetworkReply(" << QString().sprintf("%8p", this) << ")";
+
+	setRequest(request);
+	setOperation(operation);
+	setUrl(request.url());
+	open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+	if (finishOnStart)
+		QMetaObject::invokeMethod(this, "finishReply", Qt::QueuedConnection);
+}
+
+PFNetworkReply::~PFNetworkReply()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFNetworkReply(" << QString().sprintf("%8p", this) << ")";
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFNetworkReply* PFNetworkReply::replyWithData(const QNetworkRequest& request, QNetworkAccessManager::Operation operation,
+											  int statusCode, const QByteArray& data)
+{
+	PFNetworkReply* reply = new PFNetworkReply(request, operation);
+	reply->_data = data;
+	reply->_statusCode = statusCode;
+	reply->_networkError = networkErrorForStatusCode(statusCode);
+	if (reply->_networkError != QNetworkReply::NoError)
+		reply->_networkErrorString = QString("Server replied with status %1").arg(statusCode);
+
+	return reply;
+}
+
+PFNetworkReply* PFNetworkReply::replyWithError(const QNetworkRequest& request, QNetworkAccessManager::Operation operation,
+											   QNetworkReply::NetworkError error, const QString& errorString,
+											   const QByteArray& data)
+{
+	PFNetworkReply* reply = new PFNetworkReply(request, operation);
+	reply->_data = data;
+	reply->_networkError = error;
+	reply->_networkErrorString = errorString;
+
+	return reply;
+}
+
+PFNetworkReply* PFNetworkReply::pendingReplyWithRequest(const QNetworkRequest& request, QNetworkAccessManager::Operation operation)
+{
+	return new PFNetworkReply(request, operation, false);
+}
+
+void PFNetworkReply::finishWithReply(QNetworkReply* reply, const QByteArray& data)
+{
+	foreach (const QNetworkReply::RawHeaderPair& headerPair, reply->rawHeaderPairs())
+		setRawHeader(headerPair.first, headerPair.second);
+	setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+
+	_data = data;
+	_statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	_networkError = reply->error();
+	_networkErrorString = reply->errorString();
+	finishReply();
+}
+
+QNetworkReply::NetworkError PFNetworkReply::networkErrorForStatusCode(int statusCode)
+{
+	if (statusCode < 400)
+		return QNetworkReply::NoError;
+
+	switch (statusCode)
+	{
+		case 400:
+			return QNetworkReply::ProtocolInvalidOperationError;
+		case 401:
+			return QNetworkReply::AuthenticationRequiredError;
+		case 403:
+			return QNetworkReply::ContentAccessDenied;
+		case 404:
+			return QNetworkReply::ContentNotFoundError;
+		case 405:
+			return QNetworkReply::ContentOperationNotPermittedError;
+		default:
+			return QNetworkReply::UnknownContentError;
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - QNetworkReply Methods
+#endif
+
+void PFNetworkReply::abort()
+{
+	if (isFinished())
+		return;
+
+	_data.clear();
+	_offset = 0;
+	setError(QNetworkReply::OperationCanceledError, "Operation canceled");
+	emit error(QNetworkReply::OperationCanceledError);
+	setFinished(true);
+	emit finished();
+}
+
+qint64 PFNetworkReply::bytesAvailable() const
+{
+	return (_data.size() - _offset) + QIODevice::bytesAvailable();
+}
+
+bool PFNetworkReply::isSequential() const
+{
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Slots
+#endif
+
+void PFNetworkReply::finishReply()
+{
+	// Aborted in the meantime
+	if (isFinished())
+		return;
+
+	if (_statusCode > 0)
+		setAttribute(QNetworkRequest::HttpStatusCodeAttribute, _statusCode);
+	setHeader(QNetworkRequest::ContentLengthHeader, _data.size());
+	if (!_data.isEmpty() && !header(QNetworkRequest::ContentTypeHeader).isValid())
+		setHeader(QNetworkRequest::ContentTypeHeader, QString("application/json; charset=utf-8"));
+	emit metaDataChanged();
+
+	if (_networkError != QNetworkReply::NoError)
+	{
+		setError(_networkError, _networkErrorString);
+		emit error(_networkError);
+	}
+
+	if (!_data.isEmpty())
+	{
+		emit readyRead();
+		emit downloadProgress(_data.size(), _data.size());
+	}
+
+	setFinished(true);
+	emit readChannelFinished();
+	emit finished();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected QIODevice Methods
+#endif
+
+qint64 PFNetworkReply::readData(char* data, qint64 maxSize)
+{
+	qint64 length = qMin(maxSize, qint64(_data.size()) - _offset);
+	if (length <= 0)
+		return isFinished() ? -1 : 0;
+
+	std::memcpy(data, _data.constData() + _offset, size_t(length));
+	_offset += length;
+
+	return length;
+}
+
+}	// End of parse namespace
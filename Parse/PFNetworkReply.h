@@ -0,0 +1,81 @@
+//
+//  PFNetworkReply.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFNETWORKREPLY_H
+#define PARSE_PFNETWORKREPLY_H
+
+// Qt headers
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+
+namespace parse {
+
+// A reply that never touches the network. Interceptors hand one back from willSendRequest to answer a request
+// themselves (cached responses, fault injection, tests). It finishes on the next pass through the event loop
+// with the same signals a network reply emits, and statuses of 400 and above set the matching network error
+// so the SDK treats the body as a Parse error. The network access manager also hands pending replies to the
+// callers of a GET it shares between them and finishes them once the shared request did.
+class PFNetworkReply : public QNetworkReply
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods
+	static PFNetworkReply* replyWithData(const QNetworkRequest& request, QNetworkAccessManager::Operation operation,
+										 int statusCode, const QByteArray& data);
+	static PFNetworkReply* replyWithError(const QNetworkRequest& request, QNetworkAccessManager::Operation operation,
+										  QNetworkReply::NetworkError error, const QString& errorString,
+										  const QByteArray& data = QByteArray());
+
+	// Returns a reply that waits until finishWithReply hands it the response of another reply
+	static PFNetworkReply* pendingReplyWithRequest(const QNetworkRequest& request, QNetworkAccessManager::Operation operation);
+
+	// Finishes the reply with the headers, status and error of the other reply and the data read from it
+	void finishWithReply(QNetworkReply* reply, const QByteArray& data);
+
+	// Returns the network error Qt reports for the http status
+	static QNetworkReply::NetworkError networkErrorForStatusCode(int statusCode);
+
+	// QNetworkReply Methods
+	virtual void abort();
+	virtual qint64 bytesAvailable() const;
+	virtual bool isSequential() const;
+
+protected slots:
+
+	// Emits the reply signals and finishes
+	void finishReply();
+
+protected:
+
+	// Constructor / Destructor - subclasses that fill in the reply later call finishReply themselves
+	PFNetworkReply(const QNetworkRequest& request, QNetworkAccessManager::Operation operation, bool finishOnStart = true);
+	~PFNetworkReply();
+
+	// QIODevice Methods
+	virtual qint64 readData(char* data, qint64 maxSize);
+
+	// Instance members
+	QByteArray						_data;
+	qint64							_offset;
+	int								_statusCode;
+	QNetworkReply::NetworkError		_networkError;
+	QString							_networkErrorString;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFNETWORKREPLY_H
@@ -12,7 +12,10 @@
 #include "PFDateTime.h"
 #include "PFError.h"
 #include "PFFile.h"
+#include "PFLocalDatastore.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
 #include "PFObject.h"
 #include "PFUser.h"
 
@@ -21,12 +24,17 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
 #include <QVariant>
 
 namespace parse {
 
 // Static Globals
 static QHash<PFObject *, PFObjectList> gActiveBackgroundObjects; // Used for save all, delete all and fetch all
+static QHash<QString, PFObjectFactory> gSubclassFactories; // Used to create registered subclasses by class name
+static QMutex gSubclassFactoriesMutex;
 
 #ifdef __APPLE__
 #pragma mark - Memory Management Methods
@@ -34,7 +42,7 @@ static QHash<PFObject *, PFObjectList> gActiveBackgroundObjects; // Used for sav
 
 PFObject::PFObject()
 {
-	qDebug().nospace() << "Created PFObject(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFObject(" << QString().sprintf("%8p", this) << ")";
 
 	_className = "";
 	_objectId = "";
@@ -47,11 +55,12 @@ PFObject::PFObject()
 	_isDeleting = false;
 	_isFetching = false;
 	_fetched = false;
+	_backgroundReply = NULL;
 }
 
 PFObject::~PFObject()
 {
-	qDebug().nospace() << "Destroyed PFObject(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFObject(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
@@ -67,30 +76,9 @@ PFObjectPtr PFObject::objectWithClassName(const QString& className)
 	}
 	else
 	{
-		// Create a new PFObject and set the parse class name
-		PFObjectPtr object = PFObjectPtr(new PFObject(), &QObject::deleteLater);
-		object->_className = className;
-
-		// Add the default acl if set
-		PFACLPtr defaultACL;
-		bool currentUserAccess;
-		PFACL::defaultACLWithCurrentUserAccess(defaultACL, currentUserAccess);
-		if (!defaultACL.isNull())
-		{
-			// Modify the default acl if the current user access is set
-			if (currentUserAccess)
-			{
-				PFUserPtr currentUser = PFUser::currentUser();
-				if (!currentUser.isNull())
-				{
-					defaultACL = defaultACL->clone();
-					defaultACL->setReadAccessForUser(true, currentUser);
-					defaultACL->setWriteAccessForUser(true, currentUser);
-				}
-			}
-
-			object->setACL(defaultACL);
-		}
+		// Create a new PFObject (or registered subclass), set the parse class name and add the default acl
+		PFObjectPtr object = createObjectForClassName(className);
+		applyDefaultACL(object);
 
 		return object;
 	}
@@ -105,8 +93,7 @@ PFObjectPtr PFObject::objectWithClassName(const QString& className, const QStrin
 	}
 	else
 	{
-		PFObjectPtr object = PFObjectPtr(new PFObject(), &QObject::deleteLater);
-		object->_className = className;
+		PFObjectPtr object = createObjectForClassName(className);
 		object->_objectId = objectId;
 
 		return object;
@@ -122,15 +109,37 @@ PFObjectPtr PFObject::objectFromVariant(const QVariant& variant)
 	return PFObjectPtr();
 }
 
+#ifdef __APPLE__
+#pragma mark - Subclass Registration Methods
+#endif
+
+void PFObject::registerSubclassFactory(const QString& className, PFObjectFactory factory)
+{
+	if (className.isEmpty() || !factory)
+	{
+		qWarning() << "PFObject::registerSubclassFactory failed because the className and/or the factory is empty";
+		return;
+	}
+
+	QMutexLocker lock(&gSubclassFactoriesMutex);
+	gSubclassFactories.insert(className, factory);
+}
+
+void PFObject::unregisterSubclassFactory(const QString& className)
+{
+	QMutexLocker lock(&gSubclassFactoriesMutex);
+	gSubclassFactories.remove(className);
+}
+
 #ifdef __APPLE__
 #pragma mark - Object Storage Methods
 #endif
 
 void PFObject::setObjectForKey(const QVariant& object, const QString& key)
 {
-	_properties[key] = object;
-	if (!_objectId.isEmpty())
-		_updatedProperties[key] = object;
+	writeTypedFields();
+	storeObjectForKey(object, key);
+	discardTypedFields();
 }
 
 void PFObject::setObjectForKey(PFSerializablePtr object, const QString& key)
@@ -140,10 +149,12 @@ void PFObject::setObjectForKey(PFSerializablePtr object, const QString& key)
 
 bool PFObject::removeObjectForKey(const QString& key)
 {
+	writeTypedFields();
 	if (_properties.contains(key))
 	{
 		// Remove the property
 		_properties.remove(key);
+		discardTypedFields();
 
 		// Create a delete operation if the object is not new
 		if (!_objectId.isEmpty())
@@ -161,6 +172,7 @@ bool PFObject::removeObjectForKey(const QString& key)
 
 QVariant PFObject::objectForKey(const QString& key)
 {
+	writeTypedFields();
 	if (_properties.contains(key))
 		return _properties[key];
 
@@ -169,6 +181,7 @@ QVariant PFObject::objectForKey(const QString& key)
 
 QStringList PFObject::allKeys()
 {
+	writeTypedFields();
 	return _properties.keys();
 }
 
@@ -183,6 +196,8 @@ void PFObject::incrementKey(const QString& key)
 
 void PFObject::incrementKeyByAmount(const QString& key, int amount)
 {
+	writeTypedFields();
+	discardTypedFields();
 	if (_properties.contains(key))
 	{
 		// Create a set of supported meta types for the variant
@@ -246,6 +261,8 @@ void PFObject::addObjectToListForKey(PFSerializablePtr object, const QString& ke
 
 void PFObject::addObjectsToListForKey(const QVariantList& objects, const QString& key)
 {
+	writeTypedFields();
+	discardTypedFields();
 	if (_properties.contains(key) && !objects.isEmpty())
 	{
 		QMetaType::Type propertyType = (QMetaType::Type) _properties.value(key).type();
@@ -286,6 +303,8 @@ void PFObject::addUniqueObjectToListForKey(PFSerializablePtr object, const QStri
 
 void PFObject::addUniqueObjectsToListForKey(const QVariantList& objects, const QString& key)
 {
+	writeTypedFields();
+	discardTypedFields();
 	if (_properties.contains(key) && !objects.isEmpty())
 	{
 		QMetaType::Type propertyType = (QMetaType::Type) _properties.value(key).type();
@@ -294,17 +313,20 @@ void PFObject::addUniqueObjectsToListForKey(const QVariantList& objects, const Q
 			// Create a property set and find which objects are unique
 			QVariantList propertyList = _properties.value(key).toList();
 
-			// Go through all the objects to add and find the unique ones
-			QVariantList uniqueObjects = objects;
+			QSet<QString> existingKeys;
+			existingKeys.reserve(propertyList.count() + objects.count());
+			foreach (const QVariant& existingObject, propertyList)
+				existingKeys.insert(PFConversion::equalityKey(existingObject));
+
+			// Go through all the objects to add and find the unique ones (duplicates within the objects count too)
+			QVariantList uniqueObjects;
 			foreach (const QVariant& objectToAdd, objects)
 			{
-				foreach (const QVariant& existingObject, propertyList)
+				QString equalityKey = PFConversion::equalityKey(objectToAdd);
+				if (!existingKeys.contains(equalityKey))
 				{
-					if (PFConversion::areEqual(existingObject, objectToAdd))
-					{
-						uniqueObjects.removeOne(objectToAdd);
-						break;
-					}
+					existingKeys.insert(equalityKey);
+					uniqueObjects.append(objectToAdd);
 				}
 			}
 
@@ -350,30 +372,41 @@ void PFObject::removeObjectFromListForKey(PFSerializablePtr object, const QStrin
 
 void PFObject::removeObjectsFromListForKey(const QVariantList& objects, const QString& key)
 {
+	writeTypedFields();
+	discardTypedFields();
 	if (_properties.contains(key) && !objects.isEmpty())
 	{
-		// Create a property set and find which objects are unique
+		// Create a key set of the objects to remove
+		QSet<QString> removalKeys;
+		removalKeys.reserve(objects.count());
+		foreach (const QVariant& objectToRemove, objects)
+			removalKeys.insert(PFConversion::equalityKey(objectToRemove));
+
+		// Split the current objects into the ones we keep and the ones that matched in a single pass
 		QVariantList currentObjects = _properties.value(key).toList();
+		QVariantList remainingObjects;
 		QVariantList matchedObjects;
-		foreach (const QVariant& objectToRemove, objects)
+		QSet<QString> matchedKeys;
+		remainingObjects.reserve(currentObjects.count());
+		foreach (const QVariant& currentObject, currentObjects)
 		{
-			foreach (const QVariant& currentObject, currentObjects)
+			QString equalityKey = PFConversion::equalityKey(currentObject);
+			if (!removalKeys.contains(equalityKey))
 			{
-				if (PFConversion::areEqual(currentObject, objectToRemove))
-				{
-					matchedObjects.append(currentObject);
-					break;
-				}
+				remainingObjects.append(currentObject);
+			}
+			else if (!matchedKeys.contains(equalityKey))
+			{
+				matchedKeys.insert(equalityKey);
+				matchedObjects.append(currentObject);
 			}
 		}
 
 		// Create a remove operation if there are matched objects
 		if (!matchedObjects.isEmpty())
 		{
-			// First remove all the matched objects and update the properties key with the modified list
-			foreach (const QVariant& matchedObject, matchedObjects)
-				currentObjects.removeAll(matchedObject);
-			_properties[key] = currentObjects;
+			// Update the properties key with the modified list
+			_properties[key] = remainingObjects;
 
 			// Create a Remove operation to remove the objects in the cloud
 			if (!_objectId.isEmpty())
@@ -515,9 +548,9 @@ bool PFObject::saveInBackground(QObject *target, const char *action)
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	if (updateRequired)
-		networkAccessManager->put(request, data);
+		_backgroundReply = networkAccessManager->put(request, data);
 	else
-		networkAccessManager->post(request, data);
+		_backgroundReply = networkAccessManager->post(request, data);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(handleSaveCompleted(QNetworkReply*)));
 	if (target)
 		QObject::connect(this, SIGNAL(saveCompleted(bool, PFErrorPtr)), target, action);
@@ -609,7 +642,7 @@ bool PFObject::saveAllInBackground(PFObjectList objects, QObject *target, const
 
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->post(request, data);
+	callbackObject->_backgroundReply = networkAccessManager->post(request, data);
 
 	// Hook up the callbacks to the temp object
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), callbackObject, SLOT(handleSaveAllCompleted(QNetworkReply*)));
@@ -684,7 +717,7 @@ bool PFObject::deleteObjectInBackground(QObject *target, const char *action)
 
 	// Execute the network request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->deleteResource(networkRequest);
+	_backgroundReply = networkAccessManager->deleteResource(networkRequest);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(handleDeleteObjectCompleted(QNetworkReply*)));
 	if (target)
 		QObject::connect(this, SIGNAL(deleteObjectCompleted(bool, PFErrorPtr)), target, action);
@@ -776,7 +809,7 @@ bool PFObject::deleteAllObjectsInBackground(PFObjectList objects, QObject *targe
 
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->post(request, data);
+	callbackObject->_backgroundReply = networkAccessManager->post(request, data);
 
 	// Hook up the callbacks to the temp object
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), callbackObject, SLOT(handleDeleteAllObjectsCompleted(QNetworkReply*)));
@@ -877,7 +910,7 @@ bool PFObject::fetchInBackground(QObject *target, const char *action)
 
 	// Execute the network request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->get(networkRequest);
+	_backgroundReply = networkAccessManager->get(networkRequest);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(handleFetchCompleted(QNetworkReply*)));
 	if (target)
 		QObject::connect(this, SIGNAL(fetchCompleted(bool, PFErrorPtr)), target, action);
@@ -965,6 +998,132 @@ bool PFObject::fetchAllIfNeeded(PFObjectList objects, PFErrorPtr& error)
 	return allSucceeded;
 }
 
+#ifdef __APPLE__
+#pragma mark - Local Datastore Methods
+#endif
+
+bool PFObject::pin()
+{
+	PFErrorPtr error;
+	return pinWithName(PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::pin(PFErrorPtr& error)
+{
+	return pinWithName(PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::pinWithName(const QString& name)
+{
+	PFErrorPtr error;
+	return pinWithName(name, error);
+}
+
+bool PFObject::pinWithName(const QString& name, PFErrorPtr& error)
+{
+	return PFManager::sharedManager()->localDatastore()->pinObjects(QList<PFObject*>() << this, name, error);
+}
+
+bool PFObject::unpin()
+{
+	PFErrorPtr error;
+	return unpinWithName(PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::unpin(PFErrorPtr& error)
+{
+	return unpinWithName(PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::unpinWithName(const QString& name)
+{
+	PFErrorPtr error;
+	return unpinWithName(name, error);
+}
+
+bool PFObject::unpinWithName(const QString& name, PFErrorPtr& error)
+{
+	return PFManager::sharedManager()->localDatastore()->unpinObjects(QList<PFObject*>() << this, name, error);
+}
+
+#ifdef __APPLE__
+#pragma mark - Local Datastore All Methods
+#endif
+
+bool PFObject::pinAll(PFObjectList objects)
+{
+	PFErrorPtr error;
+	return pinAllWithName(objects, PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::pinAll(PFObjectList objects, PFErrorPtr& error)
+{
+	return pinAllWithName(objects, PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::pinAllWithName(PFObjectList objects, const QString& name, PFErrorPtr& error)
+{
+	QList<PFObject*> datastoreObjects;
+	foreach (PFObjectPtr object, objects)
+		datastoreObjects.append(object.data());
+
+	return PFManager::sharedManager()->localDatastore()->pinObjects(datastoreObjects, name, error);
+}
+
+bool PFObject::unpinAll(PFObjectList objects)
+{
+	PFErrorPtr error;
+	return unpinAllWithName(objects, PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::unpinAll(PFObjectList objects, PFErrorPtr& error)
+{
+	return unpinAllWithName(objects, PFLocalDatastore::defaultPinName(), error);
+}
+
+bool PFObject::unpinAllWithName(PFObjectList objects, const QString& name, PFErrorPtr& error)
+{
+	QList<PFObject*> datastoreObjects;
+	foreach (PFObjectPtr object, objects)
+		datastoreObjects.append(object.data());
+
+	return PFManager::sharedManager()->localDatastore()->unpinObjects(datastoreObjects, name, error);
+}
+
+bool PFObject::unpinAllObjectsWithName(const QString& name, PFErrorPtr& error)
+{
+	return PFManager::sharedManager()->localDatastore()->unpinAllObjects(name, error);
+}
+
+bool PFObject::fetchFromLocalDatastore()
+{
+	PFErrorPtr error;
+	return fetchFromLocalDatastore(error);
+}
+
+bool PFObject::fetchFromLocalDatastore(PFErrorPtr& error)
+{
+	if (_objectId.isEmpty())
+	{
+		qWarning() << "PFObject::fetchFromLocalDatastore failed because the objectId is not set";
+		return false;
+	}
+
+	QJsonObject jsonObject;
+	if (!PFManager::sharedManager()->localDatastore()->objectJson(_className, _objectId, jsonObject, error))
+		return false;
+
+	// Strip the type so the json converts into our properties rather than into a new object
+	jsonObject.remove("__type");
+	writeTypedFields();
+	_properties = PFConversion::convertJsonToVariant(jsonObject).toMap();
+	stripInstanceMembersFromProperties();
+	_updatedProperties.clear();
+	_fetched = true;
+
+	return true;
+}
+
 #ifdef __APPLE__
 #pragma mark - PFSerializable Methods
 #endif
@@ -1010,12 +1169,43 @@ const QString PFObject::pfClassName() const
 	return "PFObject";
 }
 
+bool PFObject::toObjectJson(QJsonObject& jsonObject)
+{
+	if (_objectId.isEmpty())
+	{
+		qWarning() << "PFObject::toObjectJson could NOT convert the PFObject to JSON because the _objectId is not set";
+		return false;
+	}
+
+	// Serialize all the properties (the ACL is stored in the properties as well)
+	writeTypedFields();
+	for (QVariantMap::const_iterator iter = _properties.constBegin(); iter != _properties.constEnd(); ++iter)
+		jsonObject[iter.key()] = PFConversion::convertVariantToJson(iter.value());
+
+	// Add the instance members in the same format the REST API returns them
+	jsonObject["__type"] = QString("Object");
+	jsonObject["className"] = _className;
+	jsonObject["objectId"] = _objectId;
+	if (!_createdAt.isNull())
+		jsonObject["createdAt"] = _createdAt->toParseString();
+	if (!_updatedAt.isNull())
+		jsonObject["updatedAt"] = _updatedAt->toParseString();
+
+	return true;
+}
+
 #ifdef __APPLE__
 #pragma mark - Background Request Completion Signals
 #endif
 
 void PFObject::handleSaveCompleted(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -1042,6 +1232,12 @@ void PFObject::handleSaveCompleted(QNetworkReply* networkReply)
 
 void PFObject::handleSaveAllCompleted(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -1069,6 +1265,12 @@ void PFObject::handleSaveAllCompleted(QNetworkReply* networkReply)
 
 void PFObject::handleDeleteObjectCompleted(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -1092,6 +1294,12 @@ void PFObject::handleDeleteObjectCompleted(QNetworkReply* networkReply)
 
 void PFObject::handleDeleteAllObjectsCompleted(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -1119,6 +1327,12 @@ void PFObject::handleDeleteAllObjectsCompleted(QNetworkReply* networkReply)
 
 void PFObject::handleFetchCompleted(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -1140,6 +1354,47 @@ void PFObject::handleFetchCompleted(QNetworkReply* networkReply)
 	networkReply->deleteLater();
 }
 
+#ifdef __APPLE__
+#pragma mark - Protected Creation Methods
+#endif
+
+PFObjectPtr PFObject::createObjectForClassName(const QString& className)
+{
+	PFObjectFactory factory = 0;
+	{
+		QMutexLocker lock(&gSubclassFactoriesMutex);
+		factory = gSubclassFactories.value(className, 0);
+	}
+
+	PFObjectPtr object = factory ? factory() : PFObjectPtr(new PFObject(), &QObject::deleteLater);
+	object->_className = className;
+
+	return object;
+}
+
+void PFObject::applyDefaultACL(PFObjectPtr object)
+{
+	PFACLPtr defaultACL;
+	bool currentUserAccess;
+	PFACL::defaultACLWithCurrentUserAccess(defaultACL, currentUserAccess);
+	if (!defaultACL.isNull())
+	{
+		// Modify the default acl if the current user access is set
+		if (currentUserAccess)
+		{
+			PFUserPtr currentUser = PFUser::currentUser();
+			if (!currentUser.isNull())
+			{
+				defaultACL = defaultACL->clone();
+				defaultACL->setReadAccessForUser(true, currentUser);
+				defaultACL->setWriteAccessForUser(true, currentUser);
+			}
+		}
+
+		object->setACL(defaultACL);
+	}
+}
+
 #ifdef __APPLE__
 #pragma mark - Protected Methods
 #endif
@@ -1172,6 +1427,7 @@ void PFObject::createSaveNetworkRequest(QNetworkRequest& request, QByteArray& da
 		request.setRawHeader(QString("X-Parse-Session-Token").toUtf8(), PFUser::currentUser()->sessionToken().toUtf8());
 
 	// Figure out whether we need to
+	writeTypedFields();
 	QVariantMap objectsToSerialize;
 	if (updateRequired)
 		objectsToSerialize = _updatedProperties;
@@ -1206,6 +1462,7 @@ void PFObject::createSaveAllNetworkRequest(PFObjectList objects, QNetworkRequest
 	{
 		// Figure out whether we need to update the object or save it
 		bool updateRequired = object->needsUpdate();
+		object->writeTypedFields();
 		QVariantMap objectsToSerialize;
 		if (updateRequired)
 			objectsToSerialize = object->_updatedProperties;
@@ -1310,7 +1567,7 @@ QNetworkRequest PFObject::createFetchNetworkRequest()
 bool PFObject::deserializeSaveNetworkReply(QNetworkReply* networkReply, bool updated, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
@@ -1321,13 +1578,16 @@ bool PFObject::deserializeSaveNetworkReply(QNetworkReply* networkReply, bool upd
 			QString createdAt = jsonObject["createdAt"].toString();
 			_createdAt = PFDateTime::dateTimeFromParseString(createdAt);
 			_objectId = jsonObject["objectId"].toString();
-			qDebug().nospace() << "Created Object:" << _className << " with objectId:" << _objectId;
+			qCDebug(PFLogObject).nospace() << "Created Object:" << _className << " with objectId:" << _objectId;
 		}
 		else // UPDATED
 		{
 			QString updatedAt = jsonObject["updatedAt"].toString();
 			_updatedAt = PFDateTime::dateTimeFromParseString(updatedAt);
-			qDebug().nospace() << "Updated Object:" << _className << " with objectId:" << _objectId;
+			qCDebug(PFLogObject).nospace() << "Updated Object:" << _className << " with objectId:" << _objectId;
+
+			// Keep the pinned copy in sync
+			PFManager::sharedManager()->localDatastore()->updateObject(this);
 		}
 
 		return true;
@@ -1345,7 +1605,7 @@ bool PFObject::deserializeSaveNetworkReply(QNetworkReply* networkReply, bool upd
 bool PFObject::deserializeSaveAllNetworkReply(PFObjectList objects, QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
@@ -1373,17 +1633,18 @@ bool PFObject::deserializeSaveAllNetworkReply(PFObjectList objects, QNetworkRepl
 					// Extract the updatedAt property
 					QString updatedAt = jsonObject["updatedAt"].toString();
 					object->_updatedAt = PFDateTime::dateTimeFromParseString(updatedAt);
-					qDebug().nospace() << "Updated Object:" << object->_className << " with objectId:" << object->_objectId;
+					qCDebug(PFLogObject).nospace() << "Updated Object:" << object->_className << " with objectId:" << object->_objectId;
 
-					// Clear out the updated properties
+					// Clear out the updated properties and keep the pinned copy in sync
 					object->_updatedProperties.clear();
+					PFManager::sharedManager()->localDatastore()->updateObject(object.data());
 				}
 				else // SAVED
 				{
 					QString createdAt = jsonObject["createdAt"].toString();
 					object->_createdAt = PFDateTime::dateTimeFromParseString(createdAt);
 					object->_objectId = jsonObject["objectId"].toString();
-					qDebug().nospace() << "Created Object:" << object->_className << " with objectId:" << object->_objectId;
+					qCDebug(PFLogObject).nospace() << "Created Object:" << object->_className << " with objectId:" << object->_objectId;
 				}
 			}
 			else
@@ -1416,13 +1677,14 @@ bool PFObject::deserializeSaveAllNetworkReply(PFObjectList objects, QNetworkRepl
 bool PFObject::deserializeDeleteObjectNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
 	{
-		// Payload is empty on success
+		// Payload is empty on success, drop the pinned copy since the object is gone
+		PFManager::sharedManager()->localDatastore()->removeObject(this);
 		return true;
 	}
 	else // FAILURE
@@ -1438,7 +1700,7 @@ bool PFObject::deserializeDeleteObjectNetworkReply(QNetworkReply* networkReply,
 bool PFObject::deserializeDeleteAllObjectsNetworkReply(PFObjectList objects, QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
@@ -1458,7 +1720,8 @@ bool PFObject::deserializeDeleteAllObjectsNetworkReply(PFObjectList objects, QNe
 			QJsonObject jsonObject = jsonValue.toObject();
 			if (jsonObject.contains("success"))
 			{
-				// Reset the object id
+				// Drop the pinned copy and reset the object id
+				PFManager::sharedManager()->localDatastore()->removeObject(object.data());
 				object->_objectId = "";
 			}
 			else
@@ -1491,16 +1754,20 @@ bool PFObject::deserializeDeleteAllObjectsNetworkReply(PFObjectList objects, QNe
 bool PFObject::deserializeFetchNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
 	{
 		// Deserialize the json into our properties variant map and strip out the instance members
+		writeTypedFields();
 		_properties = PFConversion::convertJsonToVariant(jsonObject).toMap();
 		stripInstanceMembersFromProperties();
 
+		// Keep the pinned copy in sync
+		PFManager::sharedManager()->localDatastore()->updateObject(this);
+
 		return true;
 	}
 	else // FAILURE
@@ -1513,12 +1780,36 @@ bool PFObject::deserializeFetchNetworkReply(QNetworkReply* networkReply, PFError
 	}
 }
 
+#ifdef __APPLE__
+#pragma mark - Typed Field Methods
+#endif
+
+void PFObject::storeObjectForKey(const QVariant& object, const QString& key)
+{
+	_properties[key] = object;
+	if (!_objectId.isEmpty())
+		_updatedProperties[key] = object;
+}
+
+void PFObject::writeTypedFields()
+{
+	// Plain objects keep everything in the properties
+}
+
+void PFObject::discardTypedFields()
+{
+	// Plain objects keep everything in the properties
+}
+
 #ifdef __APPLE__
 #pragma mark - Instance Member Property Stripping Methods
 #endif
 
 void PFObject::stripInstanceMembersFromProperties()
 {
+	// The properties were replaced so any typed values read out of them are stale
+	discardTypedFields();
+
 	// className
 	if (_properties.contains("className"))
 		_className = _properties.take("className").toString();
@@ -33,6 +33,12 @@ public:
 	static PFObjectPtr objectWithClassName(const QString& className, const QString& objectId);
 	static PFObjectPtr objectFromVariant(const QVariant& variant);
 
+	// Subclass Registration Methods - once a factory is registered for a class name, every object of that
+	// class gets created through it (fetches, queries and PFConversion::convertJsonToVariant() included).
+	// See PFTypedObject for the usual way to register a subclass.
+	static void registerSubclassFactory(const QString& className, PFObjectFactory factory);
+	static void unregisterSubclassFactory(const QString& className);
+
 	// Object Storage Methods
 	void setObjectForKey(const QVariant& object, const QString& key);
 	void setObjectForKey(PFSerializablePtr object, const QString& key);
@@ -108,6 +114,31 @@ public:
 	static bool fetchAllIfNeeded(PFObjectList objects);
 	static bool fetchAllIfNeeded(PFObjectList objects, PFErrorPtr& error);
 
+	// Local Datastore Methods - pinned objects are kept on disk and can be queried without a network connection
+	// through PFQuery::fromLocalDatastore(). Only objects with an objectId can be pinned. Pinned objects stay in
+	// sync when they are saved, fetched or deleted, and go away once their last pin is removed.
+	bool pin();
+	bool pin(PFErrorPtr& error);
+	bool pinWithName(const QString& name);
+	bool pinWithName(const QString& name, PFErrorPtr& error);
+	bool unpin();
+	bool unpin(PFErrorPtr& error);
+	bool unpinWithName(const QString& name);
+	bool unpinWithName(const QString& name, PFErrorPtr& error);
+
+	// Local Datastore All Methods
+	static bool pinAll(PFObjectList objects);
+	static bool pinAll(PFObjectList objects, PFErrorPtr& error);
+	static bool pinAllWithName(PFObjectList objects, const QString& name, PFErrorPtr& error);
+	static bool unpinAll(PFObjectList objects);
+	static bool unpinAll(PFObjectList objects, PFErrorPtr& error);
+	static bool unpinAllWithName(PFObjectList objects, const QString& name, PFErrorPtr& error);
+	static bool unpinAllObjectsWithName(const QString& name, PFErrorPtr& error);
+
+	// Loads the properties stored in the local datastore (returns false if the object isn't pinned)
+	bool fetchFromLocalDatastore();
+	bool fetchFromLocalDatastore(PFErrorPtr& error);
+
 	//=================================================================================
 	//                                BACKEND API
 	//=================================================================================
@@ -117,6 +148,10 @@ public:
 	virtual bool toJson(QJsonObject& jsonObject);
 	virtual const QString pfClassName() const;
 
+	// Serializes the entire object (instance members and properties) rather than just a pointer. The
+	// result can be converted back into an object with PFConversion::convertJsonToVariant().
+	virtual bool toObjectJson(QJsonObject& jsonObject);
+
 protected slots:
 
 	// Background Network Reply Completion Slots
@@ -141,6 +176,12 @@ protected:
 	PFObject();
 	~PFObject();
 
+	// Creates the object through the factory registered for the class name (or a plain PFObject)
+	static PFObjectPtr createObjectForClassName(const QString& className);
+
+	// Sets the default acl (see PFACL::setDefaultACLWithAccessForCurrentUser) on a newly created object
+	static void applyDefaultACL(PFObjectPtr object);
+
 	// Returns true if the if the object exists in the cloud and needs an update,
 	// false if it hasn't been put into the cloud yet
 	bool needsUpdate();
@@ -162,6 +203,13 @@ protected:
 	// Strips the instance members from the properties after recursive fetching
 	virtual void stripInstanceMembersFromProperties();
 
+	// Typed Field Methods - PFTypedObject keeps typed values in slots of its own. Pending values get written into
+	// the properties before the property methods or the serialization read them, and the slots are discarded
+	// whenever the properties change underneath them.
+	void storeObjectForKey(const QVariant& object, const QString& key);
+	virtual void writeTypedFields();
+	virtual void discardTypedFields();
+
 	// Instance members
 	QString				_className;
 	QString				_objectId;
@@ -174,6 +222,7 @@ protected:
 	bool				_isDeleting;
 	bool				_isFetching;
 	bool				_fetched;
+	QNetworkReply*		_backgroundReply;
 };
 
 }	// End of parse namespace
@@ -9,7 +9,10 @@
 // Parse headers
 #include "PFConversion.h"
 #include "PFError.h"
+#include "PFLocalDatastore.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
 #include "PFObject.h"
 #include "PFQuery.h"
 #include "PFUser.h"
@@ -25,18 +28,52 @@ namespace parse {
 
 #define PFUSER_QUERY_CLASSNAME		"__PFUSER_QUERY__"
 
+// Static Globals
+static const int gMaximumObjectIdsPerQuery = 1000;
+
+#ifdef __APPLE__
+#pragma mark - Static Helper Methods
+#endif
+
+// Returns whether the reply answers a direct object lookup (/1/classes/<className>/<objectId> or /1/users/<objectId>)
+// rather than a query
+static bool isObjectLookupReply(QNetworkReply* networkReply)
+{
+	QStringList segments = networkReply->request().url().path().split('/', QString::SkipEmptyParts);
+	if (segments.count() == 4)
+		return segments.at(1) == "classes";
+	if (segments.count() == 3)
+		return segments.at(1) == "users";
+
+	return false;
+}
+
+// Returns the results of a query reply, or the object of a direct object lookup reply as the only result
+static QJsonArray resultsForJsonObject(const QJsonObject& rootObject)
+{
+	if (rootObject.contains("results"))
+		return rootObject["results"].toArray();
+
+	QJsonArray results;
+	if (rootObject.contains("objectId"))
+		results.append(rootObject);
+
+	return results;
+}
+
 #ifdef __APPLE__
 #pragma mark - Memory Management Methods
 #endif
 
 PFQuery::PFQuery()
 {
-	qDebug().nospace() << "Created PFQuery(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFQuery(" << QString().sprintf("%8p", this) << ")";
 
 	// Set ivar defaults
 	_limit = -1;
 	_skip = -1;
 	_count = -1;
+	_fromLocalDatastore = false;
 	_getObjectReply = NULL;
 	_findReply = NULL;
 	_getFirstObjectReply = NULL;
@@ -45,7 +82,7 @@ PFQuery::PFQuery()
 
 PFQuery::~PFQuery()
 {
-	qDebug().nospace() << "Destroyed PFQuery(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFQuery(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
@@ -195,6 +232,27 @@ int PFQuery::skip()
 	return _skip;
 }
 
+#ifdef __APPLE__
+#pragma mark - Local Datastore Methods
+#endif
+
+void PFQuery::fromLocalDatastore()
+{
+	_fromLocalDatastore = true;
+	_pinName = QString();
+}
+
+void PFQuery::fromPinWithName(const QString& name)
+{
+	_fromLocalDatastore = true;
+	_pinName = name.isEmpty() ? PFLocalDatastore::defaultPinName() : name;
+}
+
+bool PFQuery::isFromLocalDatastore()
+{
+	return _fromLocalDatastore;
+}
+
 #ifdef __APPLE__
 #pragma mark - Get Object Methods
 #endif
@@ -227,6 +285,14 @@ PFObjectPtr PFQuery::getObjectWithId(const QString& objectId, PFErrorPtr& error)
 	_whereEqualKeys.clear();
 	whereKeyEqualTo("objectId", objectId);
 
+	// Read the object out of the local datastore if asked to (a missing object comes back null without an error
+	// just like it does from the cloud)
+	if (_fromLocalDatastore)
+	{
+		PFObjectList objects = findObjectsInLocalDatastore(error);
+		return objects.isEmpty() ? PFObjectPtr() : objects.first();
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createGetObjectNetworkRequest();
 
@@ -255,6 +321,14 @@ void PFQuery::getObjectWithIdInBackground(const QString& objectId, QObject* targ
 	_whereEqualKeys.clear();
 	whereKeyEqualTo("objectId", objectId);
 
+	// Read the object out of the local datastore on the next pass through the event loop
+	if (_fromLocalDatastore)
+	{
+		QObject::connect(this, SIGNAL(getObjectCompleted(PFObjectPtr, PFErrorPtr)), target, action);
+		QMetaObject::invokeMethod(this, "handleLocalGetObjectCompleted", Qt::QueuedConnection);
+		return;
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createGetObjectNetworkRequest();
 
@@ -267,6 +341,63 @@ void PFQuery::getObjectWithIdInBackground(const QString& objectId, QObject* targ
 	QObject::connect(this, SIGNAL(getObjectCompleted(PFObjectPtr, PFErrorPtr)), target, action);
 }
 
+#ifdef __APPLE__
+#pragma mark - Get Objects Methods
+#endif
+
+PFObjectList PFQuery::getObjectsWithIds(const QStringList& objectIds)
+{
+	PFErrorPtr error;
+	return getObjectsWithIds(objectIds, error);
+}
+
+PFObjectList PFQuery::getObjectsWithIds(const QStringList& objectIds, PFErrorPtr& error)
+{
+	QStringList uniqueObjectIds = objectIds;
+	uniqueObjectIds.removeDuplicates();
+	if (uniqueObjectIds.isEmpty())
+		return PFObjectList();
+
+	// Local queries have no maximum limit, cloud queries look up the object ids in chunks under it
+	int chunkSize = _fromLocalDatastore ? uniqueObjectIds.count() : gMaximumObjectIdsPerQuery;
+	PFObjectList objects;
+	for (int index = 0; index < uniqueObjectIds.count(); index += chunkSize)
+	{
+		setObjectIdConstraint(uniqueObjectIds.mid(index, chunkSize));
+		objects.append(findObjects(error));
+		if (!error.isNull())
+			return PFObjectList();
+	}
+
+	return objects;
+}
+
+void PFQuery::getObjectsWithIdsInBackground(const QStringList& objectIds, QObject* target, const char* action)
+{
+	QStringList uniqueObjectIds = objectIds;
+	uniqueObjectIds.removeDuplicates();
+
+	// Nothing to look up, hand back the empty result on the next pass through the event loop
+	_foundObjects.clear();
+	_pendingObjectIds.clear();
+	if (uniqueObjectIds.isEmpty())
+	{
+		QObject::connect(this, SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)), target, action);
+		QMetaObject::invokeMethod(this, "handleEmptyFindObjectsCompleted", Qt::QueuedConnection);
+		return;
+	}
+
+	// The remaining chunks get looked up one after the other as the find replies come back
+	if (!_fromLocalDatastore && uniqueObjectIds.count() > gMaximumObjectIdsPerQuery)
+	{
+		_pendingObjectIds = uniqueObjectIds.mid(gMaximumObjectIdsPerQuery);
+		uniqueObjectIds = uniqueObjectIds.mid(0, gMaximumObjectIdsPerQuery);
+	}
+
+	setObjectIdConstraint(uniqueObjectIds);
+	findObjectsInBackground(target, action);
+}
+
 #ifdef __APPLE__
 #pragma mark - Get User Methods
 #endif
@@ -316,6 +447,9 @@ PFObjectList PFQuery::findObjects()
 
 PFObjectList PFQuery::findObjects(PFErrorPtr& error)
 {
+	if (_fromLocalDatastore)
+		return findObjectsInLocalDatastore(error);
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createFindObjectsNetworkRequest();
 
@@ -339,6 +473,13 @@ PFObjectList PFQuery::findObjects(PFErrorPtr& error)
 
 void PFQuery::findObjectsInBackground(QObject* target, const char* action)
 {
+	if (_fromLocalDatastore)
+	{
+		QObject::connect(this, SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)), target, action);
+		QMetaObject::invokeMethod(this, "handleLocalFindObjectsCompleted", Qt::QueuedConnection);
+		return;
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createFindObjectsNetworkRequest();
 
@@ -363,6 +504,13 @@ PFObjectPtr PFQuery::getFirstObject()
 
 PFObjectPtr PFQuery::getFirstObject(PFErrorPtr& error)
 {
+	if (_fromLocalDatastore)
+	{
+		_limit = 1;
+		PFObjectList objects = findObjectsInLocalDatastore(error);
+		return objects.isEmpty() ? PFObjectPtr() : objects.first();
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createGetFirstObjectNetworkRequest();
 
@@ -386,6 +534,13 @@ PFObjectPtr PFQuery::getFirstObject(PFErrorPtr& error)
 
 void PFQuery::getFirstObjectInBackground(QObject* target, const char* action)
 {
+	if (_fromLocalDatastore)
+	{
+		QObject::connect(this, SIGNAL(getFirstObjectCompleted(PFObjectPtr, PFErrorPtr)), target, action);
+		QMetaObject::invokeMethod(this, "handleLocalGetFirstObjectCompleted", Qt::QueuedConnection);
+		return;
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createFindObjectsNetworkRequest();
 
@@ -410,6 +565,9 @@ int PFQuery::countObjects()
 
 int PFQuery::countObjects(PFErrorPtr& error)
 {
+	if (_fromLocalDatastore)
+		return countObjectsInLocalDatastore(error);
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createCountObjectsNetworkRequest();
 
@@ -433,6 +591,13 @@ int PFQuery::countObjects(PFErrorPtr& error)
 
 void PFQuery::countObjectsInBackground(QObject* target, const char* action)
 {
+	if (_fromLocalDatastore)
+	{
+		QObject::connect(this, SIGNAL(countObjectsCompleted(int, PFErrorPtr)), target, action);
+		QMetaObject::invokeMethod(this, "handleLocalCountObjectsCompleted", Qt::QueuedConnection);
+		return;
+	}
+
 	// Prep the request and data
 	QNetworkRequest networkRequest = createCountObjectsNetworkRequest();
 
@@ -451,9 +616,19 @@ void PFQuery::countObjectsInBackground(QObject* target, const char* action)
 
 void PFQuery::cancel()
 {
+	if (_fromLocalDatastore)
+	{
+		// Local queries have no replies to abort, just make sure the pending callbacks never get called
+		qCDebug(PFLogQuery) << "Cancelling PFQuery local datastore operations";
+		disconnect(SIGNAL(getObjectCompleted(PFObjectPtr, PFErrorPtr)));
+		disconnect(SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+		disconnect(SIGNAL(getFirstObjectCompleted(PFObjectPtr, PFErrorPtr)));
+		disconnect(SIGNAL(countObjectsCompleted(int, PFErrorPtr)));
+	}
+
 	if (_getObjectReply)
 	{
-		qDebug() << "Cancelling PFQuery get object operation";
+		qCDebug(PFLogQuery) << "Cancelling PFQuery get object operation";
 		disconnect(SIGNAL(getObjectCompleted(PFObjectPtr, PFErrorPtr)));
 		_getObjectReply->disconnect();
 		_getObjectReply->abort();
@@ -462,8 +637,10 @@ void PFQuery::cancel()
 
 	if (_findReply)
 	{
-		qDebug() << "Cancelling PFQuery find objects operation";
+		qCDebug(PFLogQuery) << "Cancelling PFQuery find objects operation";
 		disconnect(SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+		_foundObjects.clear();
+		_pendingObjectIds.clear();
 		_findReply->disconnect();
 		_findReply->abort();
 		_findReply->deleteLater();
@@ -471,7 +648,7 @@ void PFQuery::cancel()
 
 	if (_getFirstObjectReply)
 	{
-		qDebug() << "Cancelling PFQuery get first object operation";
+		qCDebug(PFLogQuery) << "Cancelling PFQuery get first object operation";
 		disconnect(SIGNAL(getFirstObjectCompleted(PFObjectPtr, PFErrorPtr)));
 		_getFirstObjectReply->disconnect();
 		_getFirstObjectReply->abort();
@@ -480,7 +657,7 @@ void PFQuery::cancel()
 
 	if (_countReply)
 	{
-		qDebug() << "Cancelling PFQuery count objects operation";
+		qCDebug(PFLogQuery) << "Cancelling PFQuery count objects operation";
 		disconnect(SIGNAL(countObjectsCompleted(int, PFErrorPtr)));
 		_countReply->disconnect();
 		_countReply->abort();
@@ -497,6 +674,32 @@ const QString& PFQuery::className()
 	return _className;
 }
 
+#ifdef __APPLE__
+#pragma mark - Backend API - Serialization Methods
+#endif
+
+QString PFQuery::serializedQuery()
+{
+	// Sort the set based options so the output doesn't depend on the hash ordering
+	QStringList includeKeys = _includeKeys.toList();
+	includeKeys.sort();
+	QStringList selectKeys = _selectKeys.toList();
+	selectKeys.sort();
+
+	// QJsonObject keeps its keys sorted which makes the compact JSON canonical
+	QJsonObject jsonObject;
+	jsonObject["className"] = _className;
+	jsonObject["where"] = PFConversion::convertVariantToJson(_whereMap);
+	jsonObject["include"] = QJsonArray::fromStringList(includeKeys);
+	jsonObject["keys"] = QJsonArray::fromStringList(selectKeys);
+	jsonObject["order"] = QJsonArray::fromStringList(_orderKeys);
+	jsonObject["limit"] = _limit;
+	jsonObject["skip"] = _skip;
+	jsonObject["count"] = _count;
+
+	return QString::fromUtf8(QJsonDocument(jsonObject).toJson(QJsonDocument::Compact));
+}
+
 #ifdef __APPLE__
 #pragma mark - Background Network Reply Completion Slots
 #endif
@@ -525,14 +728,34 @@ void PFQuery::handleFindObjectsCompleted()
 
 	// Deserialize the reply
 	PFErrorPtr error;
-	const PFObjectList& objects = deserializeFindObjectsNetworkReply(_findReply, error);
+	PFObjectList objects = deserializeFindObjectsNetworkReply(_findReply, error);
+
+	// Clean up
+	_findReply->deleteLater();
+
+	// Look up the next chunk of object ids if this was one of several for getObjectsWithIdsInBackground
+	if (!_pendingObjectIds.isEmpty() && error.isNull())
+	{
+		_foundObjects.append(objects);
+		setObjectIdConstraint(_pendingObjectIds.mid(0, gMaximumObjectIdsPerQuery));
+		_pendingObjectIds = _pendingObjectIds.mid(gMaximumObjectIdsPerQuery);
+
+		QNetworkRequest networkRequest = createFindObjectsNetworkRequest();
+		QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+		_findReply = networkAccessManager->get(networkRequest);
+		QObject::connect(_findReply, SIGNAL(finished()), this, SLOT(handleFindObjectsCompleted()));
+		return;
+	}
+
+	// Hand back the objects of all the chunks together (nothing if any of them failed)
+	if (error.isNull())
+		objects = _foundObjects + objects;
+	_foundObjects.clear();
+	_pendingObjectIds.clear();
 
 	// Emit the signal that the request completed and then disconnect it
 	emit findObjectsCompleted(objects, error);
 	this->disconnect(SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)));
-
-	// Clean up
-	_findReply->deleteLater();
 }
 
 void PFQuery::handleGetFirstObjectCompleted()
@@ -569,6 +792,77 @@ void PFQuery::handleCountObjectsCompleted()
 	_countReply->deleteLater();
 }
 
+#ifdef __APPLE__
+#pragma mark - Local Datastore Completion Slots
+#endif
+
+void PFQuery::handleLocalGetObjectCompleted()
+{
+	PFErrorPtr error;
+	PFObjectList objects = findObjectsInLocalDatastore(error);
+	PFObjectPtr object = objects.isEmpty() ? PFObjectPtr() : objects.first();
+
+	// Emit the signal that the query completed and then disconnect it
+	emit getObjectCompleted(object, error);
+	this->disconnect(SIGNAL(getObjectCompleted(PFObjectPtr, PFErrorPtr)));
+}
+
+void PFQuery::handleEmptyFindObjectsCompleted()
+{
+	// Emit the signal that the query completed and then disconnect it
+	emit findObjectsCompleted(PFObjectList(), PFErrorPtr());
+	this->disconnect(SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+}
+
+void PFQuery::handleLocalFindObjectsCompleted()
+{
+	PFErrorPtr error;
+	PFObjectList objects = findObjectsInLocalDatastore(error);
+
+	// Emit the signal that the query completed and then disconnect it
+	emit findObjectsCompleted(objects, error);
+	this->disconnect(SIGNAL(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+}
+
+void PFQuery::handleLocalGetFirstObjectCompleted()
+{
+	PFErrorPtr error;
+	_limit = 1;
+	PFObjectList objects = findObjectsInLocalDatastore(error);
+	PFObjectPtr object = objects.isEmpty() ? PFObjectPtr() : objects.first();
+
+	// Emit the signal that the query completed and then disconnect it
+	emit getFirstObjectCompleted(object, error);
+	this->disconnect(SIGNAL(getFirstObjectCompleted(PFObjectPtr, PFErrorPtr)));
+}
+
+void PFQuery::handleLocalCountObjectsCompleted()
+{
+	PFErrorPtr error;
+	int count = countObjectsInLocalDatastore(error);
+
+	// Emit the signal that the query completed and then disconnect it
+	emit countObjectsCompleted(count, error);
+	this->disconnect(SIGNAL(countObjectsCompleted(int, PFErrorPtr)));
+}
+
+#ifdef __APPLE__
+#pragma mark - Local Datastore Query Methods
+#endif
+
+PFObjectList PFQuery::findObjectsInLocalDatastore(PFErrorPtr& error)
+{
+	// The where map is converted the same way it is for the REST API so both run the same constraints
+	QJsonObject where = PFConversion::convertVariantToJson(_whereMap).toObject();
+	return PFManager::sharedManager()->localDatastore()->findObjects(_className, _pinName, where, _orderKeys, _limit, _skip, error);
+}
+
+int PFQuery::countObjectsInLocalDatastore(PFErrorPtr& error)
+{
+	QJsonObject where = PFConversion::convertVariantToJson(_whereMap).toObject();
+	return PFManager::sharedManager()->localDatastore()->countObjects(_className, _pinName, where, error);
+}
+
 #ifdef __APPLE__
 #pragma mark - Network Request Builder Methods
 #endif
@@ -626,14 +920,14 @@ PFUserPtr PFQuery::deserializeGetUserNetworkReply(QNetworkReply* networkReply, P
 	PFUserPtr user;
 
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
 	{
 		// Extract the results array
 		QJsonObject rootObject = doc.object();
-		QJsonArray results = rootObject["results"].toArray();
+		QJsonArray results = resultsForJsonObject(rootObject);
 
 		// Convert the first result to a PFUser if it exists
 		if (!results.isEmpty())
@@ -649,10 +943,13 @@ PFUserPtr PFQuery::deserializeGetUserNetworkReply(QNetworkReply* networkReply, P
 	}
 	else // FAILURE
 	{
+		// Direct lookups of missing objects fail where the query would have come back empty, any other request
+		// reports the error as is
 		QJsonObject jsonObject = doc.object();
 		int errorCode = jsonObject["code"].toInt();
 		QString errorMessage = jsonObject["error"].toString();
-		error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
+		if (errorCode != kPFErrorObjectNotFound || !isObjectLookupReply(networkReply))
+			error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
 	}
 
 	return user;
@@ -664,14 +961,14 @@ PFObjectList PFQuery::deserializeFindObjectsNetworkReply(QNetworkReply* networkR
 	PFObjectList objects;
 
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
 	{
 		// Extract the results array
 		QJsonObject rootObject = doc.object();
-		QJsonArray results = rootObject["results"].toArray();
+		QJsonArray results = resultsForJsonObject(rootObject);
 
 		// Go through each item in the reply and create a PFObject out of it
 		foreach (const QJsonValue& resultValue, results)
@@ -688,10 +985,13 @@ PFObjectList PFQuery::deserializeFindObjectsNetworkReply(QNetworkReply* networkR
 	}
 	else // FAILURE
 	{
+		// Direct lookups of missing objects fail where the query would have come back empty, any other request
+		// reports the error as is
 		QJsonObject jsonObject = doc.object();
 		int errorCode = jsonObject["code"].toInt();
 		QString errorMessage = jsonObject["error"].toString();
-		error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
+		if (errorCode != kPFErrorObjectNotFound || !isObjectLookupReply(networkReply))
+			error = PFError::errorWithCodeAndMessage(errorCode, errorMessage);
 	}
 
 	return objects;
@@ -707,7 +1007,7 @@ int PFQuery::deserializeCountObjectsNetworkReply(QNetworkReply* networkReply, PF
 {
 	// Parse the json reply
 	int count = -1;
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 
 	// Extract the JSON payload
 	if (networkReply->error() == QNetworkReply::NoError) // SUCCESS
@@ -748,6 +1048,57 @@ void PFQuery::addWhereOption(const QString& key, const QString& option, const QV
 	_whereMap[key] = keyMap;
 }
 
+void PFQuery::setObjectIdConstraint(const QStringList& uniqueObjectIds)
+{
+	// A single object id turns into a direct lookup of the object, more of them share one query
+	_whereMap.clear();
+	_whereEqualKeys.clear();
+	if (uniqueObjectIds.count() == 1)
+	{
+		whereKeyEqualTo("objectId", uniqueObjectIds.first());
+	}
+	else
+	{
+		QVariantList objectIdList;
+		foreach (const QString& objectId, uniqueObjectIds)
+			objectIdList.append(objectId);
+		whereKeyContainedIn("objectId", objectIdList);
+	}
+
+	// The default limit of 100 would cut off the larger lookups (the callers keep the chunks under the maximum)
+	_limit = uniqueObjectIds.count();
+}
+
+QString PFQuery::objectIdForLookup()
+{
+	// Only queries constrained to a single object id and nothing else that changes which object comes back
+	if (_whereMap.count() != 1 || !_whereEqualKeys.contains("objectId") || _skip > 0 || _count != -1 || _limit == 0)
+		return QString();
+
+	QVariant objectId = _whereMap.value("objectId");
+	if (objectId.type() != QVariant::String)
+		return QString();
+
+	return objectId.toString();
+}
+
+PFQueryPtr PFQuery::clone()
+{
+	PFQueryPtr query = PFQuery::queryWithClassName(_className);
+	query->_whereMap = _whereMap;
+	query->_whereEqualKeys = _whereEqualKeys;
+	query->_orderKeys = _orderKeys;
+	query->_includeKeys = _includeKeys;
+	query->_selectKeys = _selectKeys;
+	query->_limit = _limit;
+	query->_skip = _skip;
+	query->_count = _count;
+	query->_fromLocalDatastore = _fromLocalDatastore;
+	query->_pinName = _pinName;
+
+	return query;
+}
+
 QNetworkRequest PFQuery::buildDefaultNetworkRequest()
 {
 	// Create the url
@@ -755,11 +1106,22 @@ QNetworkRequest PFQuery::buildDefaultNetworkRequest()
 	if (_className == PFUSER_QUERY_CLASSNAME)
 		url = QUrl(QString("https://api.parse.com/1/users"));
 
+	// Lookups by object id get the object directly instead of having the server plan a query for them, only
+	// the include and select keys apply to those
+	QString lookupObjectId = objectIdForLookup();
+	bool isLookup = !lookupObjectId.isEmpty();
+	if (isLookup)
+	{
+		if (_className == "_User")
+			url = QUrl(QString("https://api.parse.com/1/users"));
+		url = QUrl(url.toString() + "/" + QString::fromUtf8(QUrl::toPercentEncoding(lookupObjectId)));
+	}
+
 	// Create the url query
 	QUrlQuery urlQuery;
 
 	// Attach the "where" query
-	if (!_whereMap.isEmpty())
+	if (!isLookup && !_whereMap.isEmpty())
 	{
 		QJsonObject whereJsonObject = PFConversion::convertVariantToJson(_whereMap).toObject();
 		QString whereJsonString = QString::fromUtf8(QJsonDocument(whereJsonObject).toJson(QJsonDocument::Compact));
@@ -783,28 +1145,28 @@ QNetworkRequest PFQuery::buildDefaultNetworkRequest()
 	}
 
 	// Attach the "order" query
-	if (!_orderKeys.isEmpty())
+	if (!isLookup && !_orderKeys.isEmpty())
 	{
 		QString orderString = _orderKeys.join(",");
 		urlQuery.addQueryItem("order", orderString);
 	}
 
 	// Attach the "limit" query
-	if (_limit != -1)
+	if (!isLookup && _limit != -1)
 	{
 		QString limitString = QString::number(_limit);
 		urlQuery.addQueryItem("limit", limitString);
 	}
 
 	// Attach the "skip" query
-	if (_skip != -1)
+	if (!isLookup && _skip != -1)
 	{
 		QString skipString = QString::number(_skip);
 		urlQuery.addQueryItem("skip", skipString);
 	}
 
 	// Attach the "count" query
-	if (_count != -1)
+	if (!isLookup && _count != -1)
 	{
 		QString countString = QString::number(_count);
 		urlQuery.addQueryItem("count", countString);
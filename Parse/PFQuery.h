@@ -80,6 +80,17 @@ public:
 	void setSkip(int skip);
 	int skip();
 
+	////////////////////////////////
+	//   Local Datastore Methods
+	////////////////////////////////
+
+	// Runs the query against the objects pinned in the local datastore instead of the cloud (see PFObject::pin),
+	// optionally only against the objects pinned with the given name. Local queries don't apply the default limit
+	// of 100 and don't support the include and select keys options.
+	void fromLocalDatastore();
+	void fromPinWithName(const QString& name);
+	bool isFromLocalDatastore();
+
 	////////////////////////////////
 	//     Get Object Methods
 	////////////////////////////////
@@ -93,6 +104,16 @@ public:
 	PFObjectPtr getObjectWithId(const QString& objectId, PFErrorPtr& error);
 	void getObjectWithIdInBackground(const QString& objectId, QObject* target, const char* action);
 
+	////////////////////////////////
+	//     Get Objects Methods
+	////////////////////////////////
+
+	// Returns the objects with the given object ids using a single request for every 1000 of them, in no particular
+	// order and leaving out the ids without an object - action signature: (PFObjectList objects, PFErrorPtr error)
+	PFObjectList getObjectsWithIds(const QStringList& objectIds);
+	PFObjectList getObjectsWithIds(const QStringList& objectIds, PFErrorPtr& error);
+	void getObjectsWithIdsInBackground(const QStringList& objectIds, QObject* target, const char* action);
+
 	////////////////////////////////
 	//      Get User Methods
 	////////////////////////////////
@@ -145,6 +166,10 @@ public:
 	//                                BACKEND API
 	//=================================================================================
 
+	// Returns a canonical string representation of the query options. Two queries with the same
+	// constraints return the same string regardless of the order the constraints were added in.
+	QString serializedQuery();
+
 protected slots:
 
 	// Background Network Reply Completion Slots
@@ -153,6 +178,15 @@ protected slots:
 	void handleGetFirstObjectCompleted();
 	void handleCountObjectsCompleted();
 
+	// Local Datastore Completion Slots (invoked through the event loop to keep the background methods asynchronous)
+	void handleLocalGetObjectCompleted();
+	void handleLocalFindObjectsCompleted();
+	void handleLocalGetFirstObjectCompleted();
+	void handleLocalCountObjectsCompleted();
+
+	// Completes a getObjectsWithIdsInBackground call without any object ids (also invoked through the event loop)
+	void handleEmptyFindObjectsCompleted();
+
 signals:
 
 	// Background Request Completion Signals
@@ -181,10 +215,20 @@ protected:
 	PFObjectPtr deserializeGetFirstObjectNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error);
 	int deserializeCountObjectsNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error);
 
+	// Local Datastore Query Methods
+	PFObjectList findObjectsInLocalDatastore(PFErrorPtr& error);
+	int countObjectsInLocalDatastore(PFErrorPtr& error);
+
 	// Protected Helper Methods
 	void addWhereOption(const QString& key, const QString& option, const QVariant& object);
+	void setObjectIdConstraint(const QStringList& uniqueObjectIds);
+	QString objectIdForLookup();
 	QNetworkRequest buildDefaultNetworkRequest();
 
+	// Direct access to copy the query options for polling subscriptions
+	friend class PFQuerySubscription;
+	PFQueryPtr clone();
+
 	// Instance members
 	QString				_className;
 	QVariantMap			_whereMap;
@@ -195,6 +239,10 @@ protected:
 	int					_limit;
 	int					_skip;
 	int					_count;
+	bool				_fromLocalDatastore;
+	QString				_pinName;
+	QStringList			_pendingObjectIds;
+	PFObjectList		_foundObjects;
 	QNetworkReply*		_getObjectReply;
 	QNetworkReply*		_findReply;
 	QNetworkReply*		_getFirstObjectReply;
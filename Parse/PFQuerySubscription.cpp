@@ -0,0 +1,224 @@
+//
+//  PFQuerySubscription.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFDateTime.h"
+#include "PFError.h"
+#include "PFLogging.h"
+#include "PFObject.h"
+#include "PFQuery.h"
+#include "PFQuerySubscription.h"
+
+// Qt headers
+#include <QDebug>
+#include <QSet>
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFQuerySubscription::PFQuerySubscription() :
+	_minimumInterval(0),
+	_maximumInterval(0),
+	_currentInterval(0),
+	_hasResults(false)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFQuerySubscription(" << QString().sprintf("%8p", this) << ")";
+
+	_timer.setSingleShot(true);
+	QObject::connect(&_timer, SIGNAL(timeout()), this, SLOT(poll()));
+}
+
+PFQuerySubscription::~PFQuerySubscription()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFQuerySubscription(" << QString().sprintf("%8p", this) << ")";
+
+	// Make sure an in-flight poll doesn't call back into us
+	if (!_activeQuery.isNull())
+		_activeQuery->cancel();
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFQuerySubscriptionPtr PFQuerySubscription::subscriptionWithQuery(PFQueryPtr query, int minimumInterval, int maximumInterval)
+{
+	if (query.isNull())
+	{
+		qWarning() << "PFQuerySubscription::subscriptionWithQuery failed because the query was NULL";
+		return PFQuerySubscriptionPtr();
+	}
+	else
+	{
+		PFQuerySubscriptionPtr subscription = PFQuerySubscriptionPtr(new PFQuerySubscription(), &QObject::deleteLater);
+		subscription->_query = query->clone();
+		subscription->setPollingIntervals(minimumInterval, maximumInterval);
+
+		// Run the first poll as soon as we get back to the event loop
+		subscription->_timer.start(0);
+
+		return subscription;
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Subscriber Methods
+#endif
+
+void PFQuerySubscription::addSubscriber(QObject* target, const char* action)
+{
+	if (!target || !action || hasSubscriber(target))
+		return;
+
+	_subscribers.append(qMakePair(target, QByteArray(action)));
+
+	// Catch the new subscriber up with the current results since it missed all the previous diffs
+	if (_hasResults)
+	{
+		QObject::connect(this, SIGNAL(snapshotReady(PFObjectList, PFObjectList, QStringList)), target, action);
+		emit snapshotReady(_objects, PFObjectList(), QStringList());
+		this->disconnect(SIGNAL(snapshotReady(PFObjectList, PFObjectList, QStringList)));
+	}
+
+	QObject::connect(this, SIGNAL(resultsChanged(PFObjectList, PFObjectList, QStringList)), target, action);
+}
+
+bool PFQuerySubscription::removeSubscriber(QObject* target)
+{
+	for (int i = 0; i < _subscribers.count(); ++i)
+	{
+		if (_subscribers.at(i).first == target)
+		{
+			QObject::disconnect(this, SIGNAL(resultsChanged(PFObjectList, PFObjectList, QStringList)), target, _subscribers.at(i).second.constData());
+			_subscribers.removeAt(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool PFQuerySubscription::hasSubscriber(QObject* target)
+{
+	for (int i = 0; i < _subscribers.count(); ++i)
+	{
+		if (_subscribers.at(i).first == target)
+			return true;
+	}
+
+	return false;
+}
+
+int PFQuerySubscription::subscriberCount()
+{
+	return _subscribers.count();
+}
+
+#ifdef __APPLE__
+#pragma mark - Polling Methods
+#endif
+
+void PFQuerySubscription::setPollingIntervals(int minimumInterval, int maximumInterval)
+{
+	_minimumInterval = qMax(0, minimumInterval);
+	_maximumInterval = qMax(_minimumInterval, maximumInterval);
+	_currentInterval = _minimumInterval;
+}
+
+int PFQuerySubscription::currentInterval()
+{
+	return _currentInterval;
+}
+
+void PFQuerySubscription::pollNow()
+{
+	_currentInterval = _minimumInterval;
+	if (_activeQuery.isNull())
+		_timer.start(0);
+}
+
+PFObjectList PFQuerySubscription::objects()
+{
+	return _objects;
+}
+
+#ifdef __APPLE__
+#pragma mark - Polling Slots
+#endif
+
+void PFQuerySubscription::poll()
+{
+	// Only ever have a single poll in flight
+	if (!_activeQuery.isNull())
+		return;
+
+	_activeQuery = _query->clone();
+	_activeQuery->findObjectsInBackground(this, SLOT(handlePollCompleted(PFObjectList, PFErrorPtr)));
+}
+
+void PFQuerySubscription::handlePollCompleted(PFObjectList objects, PFErrorPtr error)
+{
+	_activeQuery = PFQueryPtr();
+
+	if (!error.isNull())
+	{
+		// Back off on errors as well so we don't hammer the server during an outage
+		qWarning() << "PFQuerySubscription poll failed:" << error;
+		_currentInterval = qMin(qMax(_currentInterval * 2, 1), _maximumInterval);
+		_timer.start(_currentInterval);
+		return;
+	}
+
+	// Diff the new results against the previous ones
+	PFObjectList created;
+	PFObjectList updated;
+	QMap<QString, QString> versions;
+	foreach (PFObjectPtr object, objects)
+	{
+		PFDateTimePtr updatedAt = object->updatedAt();
+		QString version = updatedAt.isNull() ? QString() : updatedAt->toParseString();
+		versions.insert(object->objectId(), version);
+
+		if (!_versions.contains(object->objectId()))
+			created.append(object);
+		else if (_versions.value(object->objectId()) != version)
+			updated.append(object);
+	}
+
+	QStringList deletedObjectIds;
+	for (QMap<QString, QString>::const_iterator iter = _versions.constBegin(); iter != _versions.constEnd(); ++iter)
+	{
+		if (!versions.contains(iter.key()))
+			deletedObjectIds.append(iter.key());
+	}
+
+	// Store the new results
+	_objects = objects;
+	_versions = versions;
+	bool isFirstPoll = !_hasResults;
+	_hasResults = true;
+
+	// Only notify and reset the interval if something actually changed
+	bool changed = !created.isEmpty() || !updated.isEmpty() || !deletedObjectIds.isEmpty();
+	if (changed || isFirstPoll)
+	{
+		_currentInterval = _minimumInterval;
+		emit resultsChanged(created, updated, deletedObjectIds);
+	}
+	else
+	{
+		_currentInterval = qMin(qMax(_currentInterval * 2, 1), _maximumInterval);
+	}
+
+	_timer.start(_currentInterval);
+}
+
+}	// End of parse namespace
@@ -0,0 +1,91 @@
+//
+//  PFQuerySubscription.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFQUERYSUBSCRIPTION_H
+#define PARSE_PFQUERYSUBSCRIPTION_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QTimer>
+
+namespace parse {
+
+// Polls a single query on behalf of all the subscribers interested in it and only notifies them
+// about the objects that were created, updated or deleted since the previous poll. The polling
+// interval doubles every time a poll comes back unchanged (up to the maximum interval) and drops
+// back to the minimum interval as soon as something changes.
+class PFQuerySubscription : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods (the query is copied so the caller can keep using theirs)
+	static PFQuerySubscriptionPtr subscriptionWithQuery(PFQueryPtr query, int minimumInterval, int maximumInterval);
+
+	// Subscriber Methods - action signature: (PFObjectList created, PFObjectList updated, QStringList deletedObjectIds)
+	void addSubscriber(QObject* target, const char* action);
+	bool removeSubscriber(QObject* target);
+	bool hasSubscriber(QObject* target);
+	int subscriberCount();
+
+	// Polling Methods (intervals are in msecs)
+	void setPollingIntervals(int minimumInterval, int maximumInterval);
+	int currentInterval();
+	void pollNow();
+
+	// The results of the last successful poll
+	PFObjectList objects();
+
+protected slots:
+
+	// Polling Slots
+	void poll();
+	void handlePollCompleted(PFObjectList objects, PFErrorPtr error);
+
+signals:
+
+	// Emitted to all the subscribers when the results change
+	void resultsChanged(PFObjectList created, PFObjectList updated, QStringList deletedObjectIds);
+
+	// Emitted to a single new subscriber with the current results
+	void snapshotReady(PFObjectList created, PFObjectList updated, QStringList deletedObjectIds);
+
+protected:
+
+	// Constructor / Destructor
+	PFQuerySubscription();
+	~PFQuerySubscription();
+
+	// Instance members
+	PFQueryPtr						_query;
+	PFQueryPtr						_activeQuery;
+	PFObjectList					_objects;
+	QMap<QString, QString>			_versions;			// objectId -> updatedAt
+	QList<QPair<QObject*, QByteArray> >	_subscribers;
+	QTimer							_timer;
+	int								_minimumInterval;
+	int								_maximumInterval;
+	int								_currentInterval;
+	bool							_hasResults;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFQUERYSUBSCRIPTION_H
@@ -0,0 +1,259 @@
+//
+//  PFRequestScheduler.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+#include "PFRequestScheduler.h"
+#include "PFRetryReply.h"
+
+// Qt headers
+#include <QDebug>
+
+// C++ headers
+#include <cmath>
+
+namespace parse {
+
+// Static Globals
+static const QNetworkRequest::Attribute gPriorityAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+static const int gPriorityCount = 3;
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFRequestScheduler::PFRequestScheduler() :
+	_requestsPerSecond(0.0),
+	_burstSize(0),
+	_tokens(0.0),
+	_lastRefillUsecs(0),
+	_pausedUntilMsecs(0)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFRequestScheduler(" << QString().sprintf("%8p", this) << ")";
+
+	_weights[Interactive] = 4;
+	_weights[Background] = 2;
+	_weights[Bulk] = 1;
+	for (int i = 0; i < gPriorityCount; ++i)
+		_currentWeights[i] = 0;
+
+	_clock.start();
+	_dispatchTimer.setSingleShot(true);
+	QObject::connect(&_dispatchTimer, SIGNAL(timeout()), this, SLOT(dispatchQueued()));
+}
+
+PFRequestScheduler::~PFRequestScheduler()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFRequestScheduler(" << QString().sprintf("%8p", this) << ")";
+}
+
+#ifdef __APPLE__
+#pragma mark - User API
+#endif
+
+void PFRequestScheduler::setRequestsPerSecond(double requestsPerSecond)
+{
+	// Turning the limit on starts out with a full bucket
+	bool wasUnlimited = (_requestsPerSecond <= 0.0);
+	refillTokens();
+	_requestsPerSecond = qMax(0.0, requestsPerSecond);
+	_tokens = wasUnlimited ? double(burstSize()) : qMin(_tokens, double(burstSize()));
+	scheduleDispatch();
+}
+
+double PFRequestScheduler::requestsPerSecond()
+{
+	return _requestsPerSecond;
+}
+
+void PFRequestScheduler::setBurstSize(int burstSize)
+{
+	_burstSize = qMax(0, burstSize);
+	_tokens = qMin(_tokens, double(this->burstSize()));
+}
+
+int PFRequestScheduler::burstSize()
+{
+	if (_burstSize > 0)
+		return _burstSize;
+
+	return qMax(1, int(std::ceil(_requestsPerSecond)));
+}
+
+void PFRequestScheduler::setWeight(Priority priority, int weight)
+{
+	_weights[priority] = qMax(1, weight);
+}
+
+int PFRequestScheduler::weight(Priority priority)
+{
+	return _weights[priority];
+}
+
+void PFRequestScheduler::setPriorityForRequest(QNetworkRequest& request, Priority priority)
+{
+	request.setAttribute(gPriorityAttribute, int(priority));
+}
+
+PFRequestScheduler::Priority PFRequestScheduler::priorityForRequest(const QNetworkRequest& request)
+{
+	QVariant priority = request.attribute(gPriorityAttribute);
+	if (priority.isValid())
+		return Priority(qBound(int(Interactive), priority.toInt(), int(Bulk)));
+
+	// https://api.parse.com/1/<endpoint>/...
+	QString path = request.url().path();
+	if (path == "/1/batch")
+		return Bulk;
+	else if (path.startsWith("/1/files/"))
+		return Background;
+
+	return Interactive;
+}
+
+int PFRequestScheduler::queuedCount()
+{
+	int count = 0;
+	for (int i = 0; i < gPriorityCount; ++i)
+		count += _queues[i].count();
+
+	return count;
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+bool PFRequestScheduler::tryAcquire()
+{
+	// Queued requests go first
+	if (queuedCount() > 0 || _clock.elapsed() < _pausedUntilMsecs)
+		return false;
+	else if (_requestsPerSecond <= 0.0)
+		return true;
+
+	refillTokens();
+	if (_tokens < 1.0)
+		return false;
+
+	_tokens -= 1.0;
+	return true;
+}
+
+void PFRequestScheduler::enqueue(PFRetryReply* reply, Priority priority)
+{
+	_queues[priority].append(reply);
+	scheduleDispatch();
+}
+
+void PFRequestScheduler::pause(int msecs)
+{
+	qint64 pausedUntilMsecs = _clock.elapsed() + qMax(0, msecs);
+	if (pausedUntilMsecs <= _pausedUntilMsecs)
+		return;
+
+	qCDebug(PFLogManager) << "Request limit reached, holding requests for" << msecs << "msecs";
+	_pausedUntilMsecs = pausedUntilMsecs;
+	_tokens = 0.0;
+	scheduleDispatch();
+}
+
+int PFRequestScheduler::retryAfterForReply(QNetworkReply* reply, int defaultMsecs)
+{
+	// Only the delay in seconds form, servers don't send rate limits as dates
+	bool ok = false;
+	int retryAfter = reply->rawHeader("Retry-After").trimmed().toInt(&ok);
+	if (!ok || retryAfter < 0)
+		return defaultMsecs;
+
+	return retryAfter * 1000;
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Dispatch Slots
+#endif
+
+void PFRequestScheduler::dispatchQueued()
+{
+	while (queuedCount() > 0 && _clock.elapsed() >= _pausedUntilMsecs)
+	{
+		if (_requestsPerSecond > 0.0)
+		{
+			refillTokens();
+			if (_tokens < 1.0)
+				break;
+		}
+
+		// Replies that were aborted or deleted while they waited don't take a token
+		int priority = nextPriority();
+		QPointer<PFRetryReply> reply = _queues[priority].takeFirst();
+		if (reply.isNull() || reply->isFinished())
+			continue;
+
+		if (_requestsPerSecond > 0.0)
+			_tokens -= 1.0;
+		reply->dispatch();
+	}
+
+	scheduleDispatch();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Scheduling Helper Methods
+#endif
+
+void PFRequestScheduler::refillTokens()
+{
+	qint64 nowUsecs = _clock.nsecsElapsed() / 1000;
+	double refill = (nowUsecs - _lastRefillUsecs) * _requestsPerSecond / 1000000.0;
+	_tokens = qMin(_tokens + refill, double(burstSize()));
+	_lastRefillUsecs = nowUsecs;
+}
+
+int PFRequestScheduler::nextPriority()
+{
+	// Smooth weighted round robin between the queues with requests in them, every queue gains its weight and
+	// the one that gained the most so far goes next, giving up the total weight of the waiting queues
+	int totalWeight = 0;
+	int nextPriority = -1;
+	for (int i = 0; i < gPriorityCount; ++i)
+	{
+		if (_queues[i].isEmpty())
+			continue;
+
+		_currentWeights[i] += _weights[i];
+		totalWeight += _weights[i];
+		if (nextPriority < 0 || _currentWeights[i] > _currentWeights[nextPriority])
+			nextPriority = i;
+	}
+
+	_currentWeights[nextPriority] -= totalWeight;
+	return nextPriority;
+}
+
+void PFRequestScheduler::scheduleDispatch()
+{
+	if (queuedCount() == 0)
+	{
+		_dispatchTimer.stop();
+		return;
+	}
+
+	// Wait for the pause to end or the next token to come in
+	int delay = int(qMax(Q_INT64_C(0), _pausedUntilMsecs - _clock.elapsed()));
+	if (delay == 0 && _requestsPerSecond > 0.0)
+	{
+		refillTokens();
+		if (_tokens < 1.0)
+			delay = int(std::ceil((1.0 - _tokens) * 1000.0 / _requestsPerSecond));
+	}
+
+	_dispatchTimer.start(delay);
+}
+
+}	// End of parse namespace
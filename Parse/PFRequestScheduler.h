@@ -0,0 +1,117 @@
+//
+//  PFRequestScheduler.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFREQUESTSCHEDULER_H
+#define PARSE_PFREQUESTSCHEDULER_H
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QList>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+namespace parse {
+
+class PFRetryReply;
+
+// Keeps the REST API requests of the network access manager under the requests per second of the app. A token
+// bucket refills at that rate up to the burst size and every request sent takes a token. Requests that find
+// the bucket empty wait in one of three queues by priority and get the tokens as they come in, shared out
+// between the queues by their weights (interactive 4, background 2, bulk 1 by default) so bulk work keeps
+// moving without holding up what the user is waiting on.
+//
+// Requests the server rejects for going over the limit (http 429 or kPFErrorExceededQuota) hold every queue
+// for the Retry-After time (a second when the server doesn't say) instead of sending more requests that would
+// get rejected as well. The rate defaults to 0 which sends requests as they come, apps on a plan with a limit
+// set it to that limit (see PFManager::requestScheduler).
+class PFRequestScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	// The classes of work the queues are made of
+	enum Priority
+	{
+		Interactive = 0,	// What the user is waiting on (the default)
+		Background,			// File transfers
+		Bulk				// Batch requests of saveAll, deleteAll...
+	};
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Rate Methods - 0 requests per second turns the limit off, the burst size defaults to the rate
+	void setRequestsPerSecond(double requestsPerSecond);
+	double requestsPerSecond();
+	void setBurstSize(int burstSize);
+	int burstSize();
+
+	// Sets the share of the tokens the queue of the priority gets while other queues wait as well
+	void setWeight(Priority priority, int weight);
+	int weight(Priority priority);
+
+	// Priority Methods - requests without a priority of their own go in by what they're doing
+	static void setPriorityForRequest(QNetworkRequest& request, Priority priority);
+	static Priority priorityForRequest(const QNetworkRequest& request);
+
+	// Returns the number of requests waiting for a token
+	int queuedCount();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Constructor / Destructor (owned by PFNetworkAccessManager)
+	PFRequestScheduler();
+	~PFRequestScheduler();
+
+	// Takes a token for a request that can be sent right away, which is only the case when nothing is queued
+	bool tryAcquire();
+
+	// Queues the reply until a token is free, then calls PFRetryReply::dispatch
+	void enqueue(PFRetryReply* reply, Priority priority);
+
+	// Holds every request for the given msecs after the server rejected one for going over the limit
+	void pause(int msecs);
+
+	// Returns the msecs of the Retry-After header of the reply, or the default when it doesn't have one
+	static int retryAfterForReply(QNetworkReply* reply, int defaultMsecs = 1000);
+
+protected slots:
+
+	// Dispatch Slots
+	void dispatchQueued();
+
+protected:
+
+	// Scheduling Helper Methods
+	void refillTokens();
+	int nextPriority();
+	void scheduleDispatch();
+
+	// Instance members
+	QElapsedTimer						_clock;
+	double								_requestsPerSecond;
+	int									_burstSize;
+	double								_tokens;
+	qint64								_lastRefillUsecs;
+	qint64								_pausedUntilMsecs;
+	int									_weights[3];
+	int									_currentWeights[3];
+	QList<QPointer<PFRetryReply> >		_queues[3];
+	QTimer								_dispatchTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFREQUESTSCHEDULER_H
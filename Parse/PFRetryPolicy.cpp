@@ -0,0 +1,247 @@
+//
+//  PFRetryPolicy.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFError.h"
+#include "PFRetryPolicy.h"
+
+// Qt headers
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// C++ headers
+#include <cmath>
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - Static Helper Methods
+#endif
+
+// Returns whether the json holds an operation that adds to what's already stored (Batch operations nest theirs)
+static bool containsAdditiveOperation(const QJsonValue& jsonValue)
+{
+	if (jsonValue.isArray())
+	{
+		foreach (const QJsonValue& element, jsonValue.toArray())
+		{
+			if (containsAdditiveOperation(element))
+				return true;
+		}
+	}
+	else if (jsonValue.isObject())
+	{
+		QJsonObject jsonObject = jsonValue.toObject();
+		QString operation = jsonObject.value("__op").toString();
+		if (operation == "Increment" || operation == "Add")
+			return true;
+
+		for (QJsonObject::const_iterator iter = jsonObject.constBegin(); iter != jsonObject.constEnd(); ++iter)
+		{
+			if (containsAdditiveOperation(iter.value()))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFRetryPolicy::PFRetryPolicy() :
+	_maximumAttempts(3),
+	_initialBackoff(200),
+	_maximumBackoff(5000),
+	_backoffMultiplier(2.0),
+	_jitter(0.5),
+	_circuitBreakerEnabled(true),
+	_failureRateThreshold(0.5),
+	_failureWindowSize(20),
+	_minimumRequestCount(10),
+	_openDuration(30000)
+{
+	// No-op
+}
+
+PFRetryPolicy PFRetryPolicy::noRetryPolicy()
+{
+	PFRetryPolicy retryPolicy;
+	retryPolicy.setMaximumAttempts(1);
+	retryPolicy.setCircuitBreakerEnabled(false);
+
+	return retryPolicy;
+}
+
+#ifdef __APPLE__
+#pragma mark - Retry Methods
+#endif
+
+void PFRetryPolicy::setMaximumAttempts(int maximumAttempts)
+{
+	_maximumAttempts = qMax(1, maximumAttempts);
+}
+
+int PFRetryPolicy::maximumAttempts() const
+{
+	return _maximumAttempts;
+}
+
+void PFRetryPolicy::setInitialBackoff(int initialBackoff)
+{
+	_initialBackoff = qMax(0, initialBackoff);
+}
+
+int PFRetryPolicy::initialBackoff() const
+{
+	return _initialBackoff;
+}
+
+void PFRetryPolicy::setMaximumBackoff(int maximumBackoff)
+{
+	_maximumBackoff = qMax(0, maximumBackoff);
+}
+
+int PFRetryPolicy::maximumBackoff() const
+{
+	return _maximumBackoff;
+}
+
+void PFRetryPolicy::setBackoffMultiplier(double backoffMultiplier)
+{
+	_backoffMultiplier = qMax(1.0, backoffMultiplier);
+}
+
+double PFRetryPolicy::backoffMultiplier() const
+{
+	return _backoffMultiplier;
+}
+
+void PFRetryPolicy::setJitter(double jitter)
+{
+	_jitter = qBound(0.0, jitter, 1.0);
+}
+
+double PFRetryPolicy::jitter() const
+{
+	return _jitter;
+}
+
+#ifdef __APPLE__
+#pragma mark - Circuit Breaker Methods
+#endif
+
+void PFRetryPolicy::setCircuitBreakerEnabled(bool enabled)
+{
+	_circuitBreakerEnabled = enabled;
+}
+
+bool PFRetryPolicy::circuitBreakerEnabled() const
+{
+	return _circuitBreakerEnabled;
+}
+
+void PFRetryPolicy::setFailureRateThreshold(double failureRateThreshold)
+{
+	_failureRateThreshold = qBound(0.0, failureRateThreshold, 1.0);
+}
+
+double PFRetryPolicy::failureRateThreshold() const
+{
+	return _failureRateThreshold;
+}
+
+void PFRetryPolicy::setFailureWindowSize(int failureWindowSize)
+{
+	_failureWindowSize = qMax(1, failureWindowSize);
+}
+
+int PFRetryPolicy::failureWindowSize() const
+{
+	return _failureWindowSize;
+}
+
+void PFRetryPolicy::setMinimumRequestCount(int minimumRequestCount)
+{
+	_minimumRequestCount = qMax(1, minimumRequestCount);
+}
+
+int PFRetryPolicy::minimumRequestCount() const
+{
+	return _minimumRequestCount;
+}
+
+void PFRetryPolicy::setOpenDuration(int openDuration)
+{
+	_openDuration = qMax(0, openDuration);
+}
+
+int PFRetryPolicy::openDuration() const
+{
+	return _openDuration;
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+int PFRetryPolicy::backoffForAttempt(int failedAttempts, double random) const
+{
+	double backoff = _initialBackoff * std::pow(_backoffMultiplier, qMax(0, failedAttempts - 1));
+	backoff = qMin(backoff, double(_maximumBackoff));
+	backoff -= backoff * _jitter * qBound(0.0, random, 1.0);
+
+	return int(backoff + 0.5);
+}
+
+bool PFRetryPolicy::isIdempotent(QNetworkAccessManager::Operation operation, const QByteArray& body)
+{
+	switch (operation)
+	{
+		case QNetworkAccessManager::GetOperation:
+		case QNetworkAccessManager::HeadOperation:
+		case QNetworkAccessManager::DeleteOperation:
+			return true;
+		case QNetworkAccessManager::PutOperation:
+			return !containsAdditiveOperation(QJsonDocument::fromJson(body).object());
+		default:
+			return false;
+	}
+}
+
+bool PFRetryPolicy::isTransientFailure(QNetworkReply::NetworkError networkError, int statusCode, int parseErrorCode)
+{
+	if (networkError == QNetworkReply::NoError)
+		return false;
+
+	// The server told us what went wrong
+	if (parseErrorCode >= 0)
+		return parseErrorCode == kPFErrorInternalServer || parseErrorCode == kPFErrorConnectionFailed ||
+			   parseErrorCode == kPFErrorTimeout || parseErrorCode == kPFErrorExceededQuota;
+
+	if (statusCode > 0)
+		return statusCode == 429 || statusCode == 500 || statusCode == 502 || statusCode == 503 || statusCode == 504;
+
+	switch (networkError)
+	{
+		case QNetworkReply::ConnectionRefusedError:
+		case QNetworkReply::RemoteHostClosedError:
+		case QNetworkReply::TimeoutError:
+		case QNetworkReply::TemporaryNetworkFailureError:
+		case QNetworkReply::NetworkSessionFailedError:
+		case QNetworkReply::ProxyTimeoutError:
+		case QNetworkReply::UnknownNetworkError:
+			return true;
+		default:
+			return false;
+	}
+}
+
+}	// End of parse namespace
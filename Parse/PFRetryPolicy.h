@@ -0,0 +1,105 @@
+//
+//  PFRetryPolicy.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFRETRYPOLICY_H
+#define PARSE_PFRETRYPOLICY_H
+
+// Qt headers
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace parse {
+
+// How the network access manager retries failed requests and when it stops sending requests to a host
+// altogether (see PFNetworkAccessManager::setRetryPolicy).
+//
+// Only idempotent REST API requests are retried (GET, HEAD, DELETE and PUT without Increment or Add
+// operations) and only when they failed with a transient network error, a 5xx or 429 status or one of the
+// kPFErrorInternalServer, kPFErrorConnectionFailed, kPFErrorTimeout and kPFErrorExceededQuota Parse errors
+// (the PFRequestScheduler holds the retries of requests that went over the request limit). The wait before each
+// retry grows exponentially from the initial backoff up to the maximum backoff and the jitter randomly takes
+// up to that fraction off of it, so clients that failed together don't all come back at the same time.
+//
+// The circuit breaker keeps the outcome of the last requests to every host. Once the window holds at least
+// the minimum request count and the share of failures reaches the threshold, the circuit opens and every
+// request to the host fails right away with kPFErrorConnectionFailed. After the open duration a single trial
+// request goes through, closing the circuit again if it succeeds.
+class PFRetryPolicy
+{
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Constructor - 3 attempts backing off from 200 to 5000 msecs with 50% jitter, circuits open at 50%
+	// failures of the last 20 requests (at least 10) for 30 seconds
+	PFRetryPolicy();
+
+	// Returns a policy that never retries and never opens a circuit
+	static PFRetryPolicy noRetryPolicy();
+
+	// Retry Methods - attempts include the first one, so 1 turns retries off
+	void setMaximumAttempts(int maximumAttempts);
+	int maximumAttempts() const;
+	void setInitialBackoff(int initialBackoff);
+	int initialBackoff() const;
+	void setMaximumBackoff(int maximumBackoff);
+	int maximumBackoff() const;
+	void setBackoffMultiplier(double backoffMultiplier);
+	double backoffMultiplier() const;
+	void setJitter(double jitter);
+	double jitter() const;
+
+	// Circuit Breaker Methods
+	void setCircuitBreakerEnabled(bool enabled);
+	bool circuitBreakerEnabled() const;
+	void setFailureRateThreshold(double failureRateThreshold);
+	double failureRateThreshold() const;
+	void setFailureWindowSize(int failureWindowSize);
+	int failureWindowSize() const;
+	void setMinimumRequestCount(int minimumRequestCount);
+	int minimumRequestCount() const;
+	void setOpenDuration(int openDuration);
+	int openDuration() const;
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Returns the msecs to wait before the retry following the given number of failed attempts, where random
+	// is a uniformly distributed value in [0, 1) that picks the jitter
+	int backoffForAttempt(int failedAttempts, double random) const;
+
+	// Returns whether sending the request again can't change the result of sending it once
+	static bool isIdempotent(QNetworkAccessManager::Operation operation, const QByteArray& body);
+
+	// Returns whether the request failed in a way that can go away by itself. The parse error code is the
+	// code of the json body or -1 when it isn't known.
+	static bool isTransientFailure(QNetworkReply::NetworkError networkError, int statusCode, int parseErrorCode = -1);
+
+protected:
+
+	// Instance members
+	int			_maximumAttempts;
+	int			_initialBackoff;
+	int			_maximumBackoff;
+	double		_backoffMultiplier;
+	double		_jitter;
+	bool		_circuitBreakerEnabled;
+	double		_failureRateThreshold;
+	int			_failureWindowSize;
+	int			_minimumRequestCount;
+	int			_openDuration;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFRETRYPOLICY_H
@@ -0,0 +1,200 @@
+//
+//  PFRetryReply.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+#include "PFError.h"
+#include "PFNetworkAccessManager.h"
+#include "PFRequestScheduler.h"
+#include "PFRetryReply.h"
+
+// Qt headers
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace parse {
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFRetryReply::PFRetryReply(PFNetworkAccessManager* networkAccessManager, const QNetworkRequest& request,
+						   QNetworkAccessManager::Operation operation, QIODevice* outgoingData, const PFRetryPolicy& retryPolicy) :
+	PFNetworkReply(request, operation, false),
+	_networkAccessManager(networkAccessManager),
+	_retryPolicy(retryPolicy),
+	_attemptCount(0),
+	_queuedUsecs(-1)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFRetryReply(" << QString().sprintf("%8p", this) << ")";
+
+	// Every attempt sends the body again so it's read up front, requests that are only sent once stream it
+	if (outgoingData && retryPolicy.maximumAttempts() > 1)
+		_body = outgoingData->readAll();
+	else
+		_outgoingData = outgoingData;
+
+	_backoffTimer.setSingleShot(true);
+	QObject::connect(&_backoffTimer, SIGNAL(timeout()), this, SLOT(sendAttempt()));
+}
+
+PFRetryReply::~PFRetryReply()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFRetryReply(" << QString().sprintf("%8p", this) << ")";
+
+	if (_attempt)
+	{
+		_attempt->disconnect(this);
+		_attempt->abort();
+		_attempt->deleteLater();
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFRetryReply* PFRetryReply::replyWithRequest(PFNetworkAccessManager* networkAccessManager, const QNetworkRequest& request,
+											 QNetworkAccessManager::Operation operation, QIODevice* outgoingData,
+											 const PFRetryPolicy& retryPolicy)
+{
+	PFRetryReply* reply = new PFRetryReply(networkAccessManager, request, operation, outgoingData, retryPolicy);
+	reply->sendAttempt();
+
+	return reply;
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API
+#endif
+
+int PFRetryReply::attemptCount()
+{
+	return _attemptCount;
+}
+
+void PFRetryReply::dispatch()
+{
+	if (_queuedUsecs >= 0)
+	{
+		_networkAccessManager->recordQueueWait(url(), _networkAccessManager->elapsedUsecs() - _queuedUsecs);
+		_queuedUsecs = -1;
+	}
+
+	// Retries give up as soon as the circuit of the host opened, the first attempt was already let through
+	if (_attemptCount > 0 && !_networkAccessManager->allowRequest(url()))
+	{
+		_data = PFNetworkAccessManager::circuitOpenBody(url());
+		_networkError = QNetworkReply::TemporaryNetworkFailureError;
+		_networkErrorString = QString("Circuit open for host %1").arg(url().host());
+		finishReply();
+		return;
+	}
+
+	++_attemptCount;
+	if (_body.isEmpty())
+		_attempt = _networkAccessManager->sendRequestAttempt(operation(), request(), _outgoingData.data());
+	else
+		_attempt = _networkAccessManager->sendRequestAttempt(operation(), request(), _body);
+	QObject::connect(_attempt, SIGNAL(uploadProgress(qint64, qint64)), this, SLOT(handleAttemptUploadProgress(qint64, qint64)));
+	QObject::connect(_attempt, SIGNAL(finished()), this, SLOT(handleAttemptFinished()));
+}
+
+void PFRetryReply::abort()
+{
+	if (isFinished())
+		return;
+
+	_backoffTimer.stop();
+	if (_attempt)
+	{
+		_attempt->disconnect(this);
+		_attempt->abort();
+		_attempt->deleteLater();
+		_attempt = NULL;
+	}
+
+	PFNetworkReply::abort();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Attempt Slots
+#endif
+
+void PFRetryReply::sendAttempt()
+{
+	// Every attempt waits its turn with the request scheduler
+	PFRequestScheduler* requestScheduler = _networkAccessManager->requestScheduler();
+	if (requestScheduler->tryAcquire())
+	{
+		dispatch();
+	}
+	else
+	{
+		_queuedUsecs = _networkAccessManager->elapsedUsecs();
+		requestScheduler->enqueue(this, PFRequestScheduler::priorityForRequest(request()));
+	}
+}
+
+void PFRetryReply::handleAttemptUploadProgress(qint64 bytesSent, qint64 bytesTotal)
+{
+	emit uploadProgress(bytesSent, bytesTotal);
+}
+
+void PFRetryReply::handleAttemptFinished()
+{
+	QNetworkReply* attempt = qobject_cast<QNetworkReply*>(sender());
+	if (!attempt || attempt != _attempt)
+		return;
+
+	_attempt = NULL;
+	attempt->disconnect(this);
+	attempt->deleteLater();
+
+	// The parse error code decides over the status when the server sent one
+	QByteArray data = attempt->readAll();
+	QNetworkReply::NetworkError networkError = attempt->error();
+	int statusCode = attempt->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	int parseErrorCode = -1;
+	if (networkError != QNetworkReply::NoError)
+	{
+		QJsonObject jsonObject = QJsonDocument::fromJson(data).object();
+		if (jsonObject.contains("code"))
+			parseErrorCode = jsonObject.value("code").toInt();
+	}
+
+	// The server only says the app went over its limit in the body when the status doesn't
+	if (parseErrorCode == kPFErrorExceededQuota && statusCode != 429)
+		_networkAccessManager->requestScheduler()->pause(PFRequestScheduler::retryAfterForReply(attempt));
+
+	bool shouldRetry = (_attemptCount < _retryPolicy.maximumAttempts() &&
+						PFRetryPolicy::isTransientFailure(networkError, statusCode, parseErrorCode));
+	if (shouldRetry)
+	{
+		// Servers that ask for more time than the policy waits at most get the failure passed on
+		int backoff = _retryPolicy.backoffForAttempt(_attemptCount, _networkAccessManager->nextRandom());
+		int retryAfter = PFRequestScheduler::retryAfterForReply(attempt, -1);
+		if (retryAfter > _retryPolicy.maximumBackoff())
+			shouldRetry = false;
+		else
+			backoff = qMax(backoff, retryAfter);
+
+		if (shouldRetry)
+		{
+			qCDebug(PFLogManager).nospace() << "Request to " << url().toString() << " failed (" << attempt->errorString()
+											<< "), retrying in " << backoff << " msecs (attempt " << _attemptCount + 1
+											<< " of " << _retryPolicy.maximumAttempts() << ")";
+			_backoffTimer.start(backoff);
+			return;
+		}
+	}
+
+	finishWithReply(attempt, data);
+}
+
+}	// End of parse namespace
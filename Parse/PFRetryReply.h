@@ -0,0 +1,79 @@
+//
+//  PFRetryReply.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFRETRYREPLY_H
+#define PARSE_PFRETRYREPLY_H
+
+// Parse headers
+#include "PFNetworkReply.h"
+#include "PFRetryPolicy.h"
+
+// Qt headers
+#include <QPointer>
+#include <QTimer>
+
+namespace parse {
+
+class PFNetworkAccessManager;
+
+// The reply the network access manager hands out for requests its PFRetryPolicy can retry and for requests that
+// have to wait for the PFRequestScheduler. Every attempt waits for a token of the scheduler and is sent through
+// the manager as a request of its own, the attempts that failed in a transient way get sent again after the
+// backoff and the reply finishes with the data, headers and error of the last attempt.
+class PFRetryReply : public PFNetworkReply
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods - sends the first attempt as soon as the scheduler has a token for it
+	static PFRetryReply* replyWithRequest(PFNetworkAccessManager* networkAccessManager, const QNetworkRequest& request,
+										  QNetworkAccessManager::Operation operation, QIODevice* outgoingData,
+										  const PFRetryPolicy& retryPolicy);
+
+	// Returns the number of attempts sent so far
+	int attemptCount();
+
+	// Sends the next attempt (called by the scheduler once it has a token for it)
+	void dispatch();
+
+	// QNetworkReply Methods
+	virtual void abort();
+
+protected slots:
+
+	// Attempt Slots
+	void sendAttempt();
+	void handleAttemptUploadProgress(qint64 bytesSent, qint64 bytesTotal);
+	void handleAttemptFinished();
+
+protected:
+
+	// Constructor / Destructor
+	PFRetryReply(PFNetworkAccessManager* networkAccessManager, const QNetworkRequest& request,
+				 QNetworkAccessManager::Operation operation, QIODevice* outgoingData, const PFRetryPolicy& retryPolicy);
+	~PFRetryReply();
+
+	// Instance members
+	PFNetworkAccessManager*		_networkAccessManager;
+	QByteArray					_body;
+	QPointer<QIODevice>			_outgoingData;
+	PFRetryPolicy				_retryPolicy;
+	QPointer<QNetworkReply>		_attempt;
+	int							_attemptCount;
+	qint64						_queuedUsecs;
+	QTimer						_backoffTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFRETRYREPLY_H
@@ -0,0 +1,181 @@
+//
+//  PFSubscriptionManager.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFQuery.h"
+#include "PFQuerySubscription.h"
+#include "PFSubscriptionManager.h"
+
+// Qt headers
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace parse {
+
+// Static Globals
+static QMutex gPFSubscriptionManagerMutex;
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFSubscriptionManager::PFSubscriptionManager() :
+	_minimumInterval(5000),
+	_maximumInterval(120000)
+{
+	// No-op
+}
+
+PFSubscriptionManager::~PFSubscriptionManager()
+{
+	// No-op
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFSubscriptionManager* PFSubscriptionManager::sharedManager()
+{
+	QMutexLocker lock(&gPFSubscriptionManagerMutex);
+	static PFSubscriptionManager manager;
+	return &manager;
+}
+
+#ifdef __APPLE__
+#pragma mark - Subscription Methods
+#endif
+
+bool PFSubscriptionManager::subscribe(PFQueryPtr query, QObject* target, const char* action)
+{
+	// Make sure the parameters are valid
+	if (query.isNull() || !target || !action)
+	{
+		qWarning() << "PFSubscriptionManager::subscribe failed because the set up parameters were not valid";
+		return false;
+	}
+
+	// Find or create the shared subscription for the query
+	QString key = query->serializedQuery();
+	PFQuerySubscriptionPtr subscription = _subscriptions.value(key);
+	if (subscription.isNull())
+	{
+		subscription = PFQuerySubscription::subscriptionWithQuery(query, _minimumInterval, _maximumInterval);
+		_subscriptions.insert(key, subscription);
+	}
+
+	// Early out if the target is already subscribed
+	if (subscription->hasSubscriber(target))
+		return false;
+
+	subscription->addSubscriber(target, action);
+
+	// Track the subscriber so we can clean up if it gets destroyed without unsubscribing
+	if (!_subscriberKeys.contains(target))
+		QObject::connect(target, SIGNAL(destroyed(QObject*)), this, SLOT(handleSubscriberDestroyed(QObject*)));
+	_subscriberKeys[target].insert(key);
+
+	return true;
+}
+
+void PFSubscriptionManager::unsubscribe(PFQueryPtr query, QObject* target)
+{
+	if (query.isNull() || !target)
+		return;
+
+	removeSubscriberFromSubscription(target, query->serializedQuery());
+
+	// Stop watching the target once it has no more subscriptions
+	if (_subscriberKeys.value(target).isEmpty())
+	{
+		_subscriberKeys.remove(target);
+		QObject::disconnect(target, SIGNAL(destroyed(QObject*)), this, SLOT(handleSubscriberDestroyed(QObject*)));
+	}
+}
+
+void PFSubscriptionManager::unsubscribeAll(QObject* target)
+{
+	if (!target || !_subscriberKeys.contains(target))
+		return;
+
+	foreach (const QString& key, _subscriberKeys.value(target))
+		removeSubscriberFromSubscription(target, key);
+
+	_subscriberKeys.remove(target);
+	QObject::disconnect(target, SIGNAL(destroyed(QObject*)), this, SLOT(handleSubscriberDestroyed(QObject*)));
+}
+
+void PFSubscriptionManager::refresh(PFQueryPtr query)
+{
+	if (query.isNull())
+		return;
+
+	PFQuerySubscriptionPtr subscription = _subscriptions.value(query->serializedQuery());
+	if (!subscription.isNull())
+		subscription->pollNow();
+}
+
+#ifdef __APPLE__
+#pragma mark - Polling Interval Methods
+#endif
+
+void PFSubscriptionManager::setPollingIntervals(int minimumInterval, int maximumInterval)
+{
+	_minimumInterval = qMax(0, minimumInterval);
+	_maximumInterval = qMax(_minimumInterval, maximumInterval);
+}
+
+int PFSubscriptionManager::minimumInterval()
+{
+	return _minimumInterval;
+}
+
+int PFSubscriptionManager::maximumInterval()
+{
+	return _maximumInterval;
+}
+
+int PFSubscriptionManager::subscriptionCount()
+{
+	return _subscriptions.count();
+}
+
+#ifdef __APPLE__
+#pragma mark - Subscriber Cleanup Slots
+#endif
+
+void PFSubscriptionManager::handleSubscriberDestroyed(QObject* subscriber)
+{
+	// The subscriber is already gone so its signal connections have been cleaned up by Qt
+	foreach (const QString& key, _subscriberKeys.value(subscriber))
+		removeSubscriberFromSubscription(subscriber, key);
+
+	_subscriberKeys.remove(subscriber);
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Helper Methods
+#endif
+
+void PFSubscriptionManager::removeSubscriberFromSubscription(QObject* subscriber, const QString& key)
+{
+	if (_subscriberKeys.contains(subscriber))
+		_subscriberKeys[subscriber].remove(key);
+
+	PFQuerySubscriptionPtr subscription = _subscriptions.value(key);
+	if (subscription.isNull())
+		return;
+
+	// Stop polling the query once nobody is interested in it anymore
+	subscription->removeSubscriber(subscriber);
+	if (subscription->subscriberCount() == 0)
+		_subscriptions.remove(key);
+}
+
+}	// End of parse namespace
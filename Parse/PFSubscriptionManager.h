@@ -0,0 +1,85 @@
+//
+//  PFSubscriptionManager.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFSUBSCRIPTIONMANAGER_H
+#define PARSE_PFSUBSCRIPTIONMANAGER_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+namespace parse {
+
+// Lets any number of subscribers watch the results of a query without each of them polling the
+// server. Identical queries (same class and constraints) share a single PFQuerySubscription, so
+// the network load scales with the number of distinct queries rather than the number of widgets.
+class PFSubscriptionManager : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Creates a singleton instance of the PFSubscriptionManager
+	static PFSubscriptionManager* sharedManager();
+
+	// Subscribes the target to the results of the query. The first call delivers all the current results
+	// as created objects, after that only the differences between polls are delivered.
+	//   @param query The query to watch (it is copied so later changes to it are not picked up).
+	//   @param target The target to be notified when the results change.
+	//   @param action The slot to be notified when the results change - SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList)).
+	//   @return True if the subscription was added, false otherwise.
+	bool subscribe(PFQueryPtr query, QObject* target, const char* action);
+
+	// Removes the target from the subscription of the query (or from all of its subscriptions)
+	void unsubscribe(PFQueryPtr query, QObject* target);
+	void unsubscribeAll(QObject* target);
+
+	// Polls the query right away instead of waiting for the next interval
+	void refresh(PFQueryPtr query);
+
+	// The polling intervals (in msecs) used by subscriptions created after this call. Defaults to 5 secs and 2 mins.
+	void setPollingIntervals(int minimumInterval, int maximumInterval);
+	int minimumInterval();
+	int maximumInterval();
+
+	// The number of distinct queries currently being polled
+	int subscriptionCount();
+
+protected slots:
+
+	// Subscriber Cleanup Slots
+	void handleSubscriberDestroyed(QObject* subscriber);
+
+protected:
+
+	// Constructor / Destructor
+	PFSubscriptionManager();
+	~PFSubscriptionManager();
+
+	// Protected Helper Methods
+	void removeSubscriberFromSubscription(QObject* subscriber, const QString& key);
+
+	// Instance members
+	QHash<QString, PFQuerySubscriptionPtr>	_subscriptions;		// serialized query -> subscription
+	QHash<QObject*, QSet<QString> >			_subscriberKeys;	// subscriber -> serialized queries
+	int										_minimumInterval;
+	int										_maximumInterval;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFSUBSCRIPTIONMANAGER_H
@@ -0,0 +1,485 @@
+//
+//  PFSyncEngine.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFConversion.h"
+#include "PFDateTime.h"
+#include "PFError.h"
+#include "PFLogging.h"
+#include "PFManager.h"
+#include "PFObject.h"
+#include "PFQuery.h"
+#include "PFSyncEngine.h"
+
+// Qt headers
+#include <QDebug>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace parse {
+
+// Static Globals
+static const int gPageSize = 1000;				// maximum number of results the REST API returns per query
+static const QString gStoreDirectoryName = "PFSyncEngine";
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFSyncEngine::PFSyncEngine() :
+	_className(""),
+	_skip(0),
+	_reconciliationInterval(10),
+	_syncsSinceReconciliation(0),
+	_isSyncing(false),
+	_lastSyncSucceeded(false)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFSyncEngine(" << QString().sprintf("%8p", this) << ")";
+}
+
+PFSyncEngine::~PFSyncEngine()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFSyncEngine(" << QString().sprintf("%8p", this) << ")";
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFSyncEnginePtr PFSyncEngine::syncEngineWithClassName(const QString& className)
+{
+	if (className.isEmpty())
+	{
+		qWarning() << "PFSyncEngine::syncEngineWithClassName failed to create a new PFSyncEngine because the className was empty";
+		return PFSyncEnginePtr();
+	}
+	else
+	{
+		PFSyncEnginePtr syncEngine = PFSyncEnginePtr(new PFSyncEngine(), &QObject::deleteLater);
+		syncEngine->_className = className;
+		syncEngine->loadStore();
+		return syncEngine;
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Sync Methods
+#endif
+
+bool PFSyncEngine::sync()
+{
+	PFErrorPtr error;
+	return sync(error);
+}
+
+bool PFSyncEngine::sync(PFErrorPtr& error)
+{
+	// Block the async nature of the sync using our own event loop until the sync completes
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(syncCompleted(bool, PFErrorPtr)), &eventLoop, SLOT(quit()));
+	if (!syncInBackground())
+		return false;
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+
+	error = _lastSyncError;
+	return _lastSyncSucceeded;
+}
+
+bool PFSyncEngine::syncInBackground(QObject *target, const char *action)
+{
+	// Early out if we're already syncing
+	if (_isSyncing)
+	{
+		qWarning().nospace() << "WARNING: PFSyncEngine \"" << _className << "\" is already syncing";
+		return false;
+	}
+
+	// Reset the results of the last sync
+	_isSyncing = true;
+	_addedObjects.clear();
+	_changedObjects.clear();
+	_removedObjectIds.clear();
+	_serverObjectIds.clear();
+	_pendingWatermark = _watermark;
+	_boundaryObjectIds.clear();
+	_skip = 0;
+
+	// Connect the callbacks from this object to the target action
+	if (target)
+		QObject::connect(this, SIGNAL(syncCompleted(bool, PFErrorPtr)), target, action);
+
+	// Start pulling down everything that changed since the watermark
+	requestDeltaPage();
+
+	return true;
+}
+
+#ifdef __APPLE__
+#pragma mark - Reconciliation Methods
+#endif
+
+void PFSyncEngine::setReconciliationInterval(int syncCount)
+{
+	_reconciliationInterval = qMax(0, syncCount);
+}
+
+int PFSyncEngine::reconciliationInterval()
+{
+	return _reconciliationInterval;
+}
+
+void PFSyncEngine::setNeedsReconciliation()
+{
+	_syncsSinceReconciliation = qMax(_reconciliationInterval, 1);
+}
+
+#ifdef __APPLE__
+#pragma mark - Local Store Accessors
+#endif
+
+const QString& PFSyncEngine::className()
+{
+	return _className;
+}
+
+PFDateTimePtr PFSyncEngine::watermark()
+{
+	return _watermark;
+}
+
+PFObjectList PFSyncEngine::objects()
+{
+	return _objects.values();
+}
+
+PFObjectPtr PFSyncEngine::objectWithId(const QString& objectId)
+{
+	return _objects.value(objectId);
+}
+
+int PFSyncEngine::count()
+{
+	return _objects.count();
+}
+
+PFObjectList PFSyncEngine::addedObjects()
+{
+	return _addedObjects;
+}
+
+PFObjectList PFSyncEngine::changedObjects()
+{
+	return _changedObjects;
+}
+
+QStringList PFSyncEngine::removedObjectIds()
+{
+	return _removedObjectIds;
+}
+
+void PFSyncEngine::reset()
+{
+	cancel();
+
+	_watermark = PFDateTimePtr();
+	_objects.clear();
+	_addedObjects.clear();
+	_changedObjects.clear();
+	_removedObjectIds.clear();
+	_syncsSinceReconciliation = 0;
+
+	QFile::remove(storeFilepath());
+}
+
+#ifdef __APPLE__
+#pragma mark - Cancellation Methods
+#endif
+
+void PFSyncEngine::cancel()
+{
+	if (_isSyncing)
+	{
+		qCDebug(PFLogSync) << "Cancelling PFSyncEngine sync operation";
+		disconnect(SIGNAL(syncCompleted(bool, PFErrorPtr)));
+		if (!_activeQuery.isNull())
+			_activeQuery->cancel();
+		_activeQuery = PFQueryPtr();
+		_isSyncing = false;
+	}
+}
+
+#ifdef __APPLE__
+#pragma mark - Background Query Completion Slots
+#endif
+
+void PFSyncEngine::handleDeltaPageCompleted(PFObjectList objects, PFErrorPtr error)
+{
+	_activeQuery = PFQueryPtr();
+
+	// Keep whatever we already merged, the watermark stays where it was so the rest comes down next time
+	if (!error.isNull())
+	{
+		finishSync(error);
+		return;
+	}
+
+	// Merge the objects into the local store by objectId
+	PFDateTimePtr pageStartWatermark = _pendingWatermark;
+	foreach (PFObjectPtr object, objects)
+	{
+		if (object.isNull())
+			continue;
+
+		// Pages after the first one start at the watermark itself, so the objects on it come back again
+		const QString& objectId = object->objectId();
+		if (_boundaryObjectIds.contains(objectId))
+			continue;
+
+		if (_objects.contains(objectId))
+			_changedObjects.append(object);
+		else
+			_addedObjects.append(object);
+		_objects.insert(objectId, object);
+
+		// Results are sorted ascending, but be defensive about the watermark
+		PFDateTimePtr updatedAt = object->updatedAt();
+		if (updatedAt.isNull())
+			continue;
+		if (_pendingWatermark.isNull() || updatedAt->dateTime() > _pendingWatermark->dateTime())
+		{
+			_pendingWatermark = updatedAt;
+			_boundaryObjectIds.clear();
+		}
+		if (updatedAt->dateTime() == _pendingWatermark->dateTime())
+			_boundaryObjectIds.insert(objectId);
+	}
+
+	// Keep paging until we get a partial page back. The next page starts at the watermark rather than skipping
+	// over what came down, which would miss the objects that changed or share a timestamp in the meantime. Only
+	// a full page sharing a single timestamp has to skip past the objects seen on it.
+	if (objects.count() == gPageSize)
+	{
+		bool isStalled = (!pageStartWatermark.isNull() && _pendingWatermark->dateTime() == pageStartWatermark->dateTime());
+		_skip = isStalled ? _boundaryObjectIds.count() : 0;
+		requestDeltaPage();
+		return;
+	}
+
+	// Every change came down, the watermark only moves once the delta is complete
+	_watermark = _pendingWatermark;
+
+	// Check whether it's time to look for deletions
+	++_syncsSinceReconciliation;
+	if (_reconciliationInterval > 0 && _syncsSinceReconciliation >= _reconciliationInterval)
+		requestCount();
+	else
+		finishSync(PFErrorPtr());
+}
+
+void PFSyncEngine::handleCountCompleted(int count, PFErrorPtr error)
+{
+	_activeQuery = PFQueryPtr();
+
+	if (!error.isNull())
+	{
+		finishSync(error);
+		return;
+	}
+
+	// If the counts match then nothing was deleted since every new object came down with the delta
+	if (count == _objects.count())
+	{
+		_syncsSinceReconciliation = 0;
+		finishSync(PFErrorPtr());
+		return;
+	}
+
+	// Otherwise we need to compare the objectIds
+	_serverObjectIds.clear();
+	_skip = 0;
+	requestObjectIdPage();
+}
+
+void PFSyncEngine::handleObjectIdPageCompleted(PFObjectList objects, PFErrorPtr error)
+{
+	_activeQuery = PFQueryPtr();
+
+	if (!error.isNull())
+	{
+		finishSync(error);
+		return;
+	}
+
+	// Collect the objectIds
+	foreach (PFObjectPtr object, objects)
+	{
+		if (!object.isNull())
+			_serverObjectIds.insert(object->objectId());
+	}
+
+	// Keep paging until we get a partial page back
+	if (objects.count() == gPageSize)
+	{
+		_skip += gPageSize;
+		requestObjectIdPage();
+		return;
+	}
+
+	// Remove all the local objects that no longer exist on the server
+	foreach (const QString& objectId, _objects.keys())
+	{
+		if (!_serverObjectIds.contains(objectId))
+		{
+			_objects.remove(objectId);
+			_removedObjectIds.append(objectId);
+		}
+	}
+
+	_serverObjectIds.clear();
+	_syncsSinceReconciliation = 0;
+	finishSync(PFErrorPtr());
+}
+
+#ifdef __APPLE__
+#pragma mark - Sync Steps
+#endif
+
+void PFSyncEngine::requestDeltaPage()
+{
+	// The first page starts after the objects of the last sync, the later ones at the objects of the last page
+	_activeQuery = PFQuery::queryWithClassName(_className);
+	if (!_pendingWatermark.isNull() && _boundaryObjectIds.isEmpty())
+		_activeQuery->whereKeyGreaterThan("updatedAt", PFSerializable::toVariant(_pendingWatermark));
+	else if (!_pendingWatermark.isNull())
+		_activeQuery->whereKeyGreaterThanOrEqualTo("updatedAt", PFSerializable::toVariant(_pendingWatermark));
+	_activeQuery->orderByAscending("updatedAt");
+	_activeQuery->addAscendingOrder("objectId");
+	_activeQuery->setLimit(gPageSize);
+	if (_skip > 0)
+		_activeQuery->setSkip(_skip);
+
+	_activeQuery->findObjectsInBackground(this, SLOT(handleDeltaPageCompleted(PFObjectList, PFErrorPtr)));
+}
+
+void PFSyncEngine::requestCount()
+{
+	_activeQuery = PFQuery::queryWithClassName(_className);
+	_activeQuery->countObjectsInBackground(this, SLOT(handleCountCompleted(int, PFErrorPtr)));
+}
+
+void PFSyncEngine::requestObjectIdPage()
+{
+	// Only pull down the objectIds (the server always adds createdAt and updatedAt)
+	_activeQuery = PFQuery::queryWithClassName(_className);
+	_activeQuery->selectKeys(QStringList() << "objectId");
+	_activeQuery->orderByAscending("createdAt");
+	_activeQuery->setLimit(gPageSize);
+	if (_skip > 0)
+		_activeQuery->setSkip(_skip);
+
+	_activeQuery->findObjectsInBackground(this, SLOT(handleObjectIdPageCompleted(PFObjectList, PFErrorPtr)));
+}
+
+void PFSyncEngine::finishSync(PFErrorPtr error)
+{
+	// A delta that failed part way keeps the old watermark, the objects it merged come down again next time
+	_isSyncing = false;
+	_pendingWatermark = PFDateTimePtr();
+	_boundaryObjectIds.clear();
+	saveStore();
+
+	// Store the result for the synchronous sync
+	_lastSyncSucceeded = error.isNull();
+	_lastSyncError = error;
+
+	// Emit the signal that the sync has completed and then disconnect it
+	emit syncCompleted(_lastSyncSucceeded, error);
+	this->disconnect(SIGNAL(syncCompleted(bool, PFErrorPtr)));
+}
+
+#ifdef __APPLE__
+#pragma mark - Persistence Methods
+#endif
+
+QString PFSyncEngine::storeFilepath()
+{
+	QDir& cacheDirectory = PFManager::sharedManager()->cacheDirectory();
+	return cacheDirectory.filePath(gStoreDirectoryName + "/" + _className + ".json");
+}
+
+bool PFSyncEngine::loadStore()
+{
+	QFile file(storeFilepath());
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QJsonObject rootObject = QJsonDocument::fromJson(file.readAll()).object();
+	file.close();
+
+	if (rootObject["className"].toString() != _className)
+	{
+		qWarning() << "PFSyncEngine::loadStore ignored the store for" << _className << "because it is corrupt";
+		return false;
+	}
+
+	QString watermark = rootObject["watermark"].toString();
+	if (!watermark.isEmpty())
+		_watermark = PFDateTime::dateTimeFromParseString(watermark);
+	_syncsSinceReconciliation = rootObject["syncsSinceReconciliation"].toInt();
+
+	// Convert all the objects back into PFObjects
+	_objects.clear();
+	foreach (const QJsonValue& objectValue, rootObject["objects"].toArray())
+	{
+		QVariant objectVariant = PFConversion::convertJsonToVariant(objectValue);
+		PFObjectPtr object = PFObject::objectFromVariant(objectVariant);
+		if (!object.isNull())
+			_objects.insert(object->objectId(), object);
+	}
+
+	return true;
+}
+
+bool PFSyncEngine::saveStore()
+{
+	// Make sure the store directory exists
+	QDir& cacheDirectory = PFManager::sharedManager()->cacheDirectory();
+	cacheDirectory.mkpath(gStoreDirectoryName);
+
+	// Serialize the entire store
+	QJsonArray objectsArray;
+	foreach (PFObjectPtr object, _objects)
+	{
+		QJsonObject objectJson;
+		if (object->toObjectJson(objectJson))
+			objectsArray.append(objectJson);
+	}
+
+	QJsonObject rootObject;
+	rootObject["className"] = _className;
+	rootObject["watermark"] = _watermark.isNull() ? QString() : _watermark->toParseString();
+	rootObject["syncsSinceReconciliation"] = _syncsSinceReconciliation;
+	rootObject["objects"] = objectsArray;
+
+	// Atomically replace the previous store so a crash never leaves a half written file behind
+	QSaveFile file(storeFilepath());
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "PFSyncEngine::saveStore failed to open" << storeFilepath();
+		return false;
+	}
+
+	file.write(QJsonDocument(rootObject).toJson(QJsonDocument::Compact));
+	return file.commit();
+}
+
+}	// End of parse namespace
@@ -0,0 +1,126 @@
+//
+//  PFSyncEngine.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFSYNCENGINE_H
+#define PARSE_PFSYNCENGINE_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+namespace parse {
+
+// The sync engine keeps a local copy of every object in a class up to date by only downloading
+// the objects whose updatedAt is newer than the last sync (the watermark). The watermark and the
+// local store are persisted to the cache directory so the next app launch picks up where it left
+// off. Deletions can't be seen through updatedAt, so every few syncs the engine compares the local
+// object count with the server count and, if they differ, reconciles the objectIds.
+class PFSyncEngine : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Creation Methods (loads the previously persisted store for the class if one exists)
+	static PFSyncEnginePtr syncEngineWithClassName(const QString& className);
+
+	// Sync Methods - action signature: (bool succeeded, PFErrorPtr error)
+	bool sync();
+	bool sync(PFErrorPtr& error);
+	bool syncInBackground(QObject *target = 0, const char *action = 0);
+
+	// The number of syncs between count reconciliations (defaults to 10). Setting it to 1 will
+	// check for deletions on every sync, setting it to 0 disables deletion detection.
+	void setReconciliationInterval(int syncCount);
+	int reconciliationInterval();
+
+	// Forces the next sync to run the count reconciliation
+	void setNeedsReconciliation();
+
+	// Local Store Accessors
+	const QString& className();
+	PFDateTimePtr watermark();
+	PFObjectList objects();
+	PFObjectPtr objectWithId(const QString& objectId);
+	int count();
+
+	// Results of the last sync
+	PFObjectList addedObjects();
+	PFObjectList changedObjects();
+	QStringList removedObjectIds();
+
+	// Removes the local store and watermark (both in memory and on disk)
+	void reset();
+
+	// Cancels the current sync (if any). Ensures callbacks won't be called.
+	void cancel();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+protected slots:
+
+	// Background Query Completion Slots
+	void handleDeltaPageCompleted(PFObjectList objects, PFErrorPtr error);
+	void handleCountCompleted(int count, PFErrorPtr error);
+	void handleObjectIdPageCompleted(PFObjectList objects, PFErrorPtr error);
+
+signals:
+
+	// Background Sync Completion Signal
+	void syncCompleted(bool succeeded, PFErrorPtr error);
+
+protected:
+
+	// Constructor / Destructor
+	PFSyncEngine();
+	~PFSyncEngine();
+
+	// Sync Steps
+	void requestDeltaPage();
+	void requestCount();
+	void requestObjectIdPage();
+	void finishSync(PFErrorPtr error);
+
+	// Persistence Methods
+	QString storeFilepath();
+	bool loadStore();
+	bool saveStore();
+
+	// Instance members
+	QString						_className;
+	PFDateTimePtr				_watermark;
+	QMap<QString, PFObjectPtr>	_objects;
+	PFObjectList				_addedObjects;
+	PFObjectList				_changedObjects;
+	QStringList					_removedObjectIds;
+	QSet<QString>				_serverObjectIds;
+	PFDateTimePtr				_pendingWatermark;
+	QSet<QString>				_boundaryObjectIds;
+	PFQueryPtr					_activeQuery;
+	int							_skip;
+	int							_reconciliationInterval;
+	int							_syncsSinceReconciliation;
+	bool						_isSyncing;
+	bool						_lastSyncSucceeded;
+	PFErrorPtr					_lastSyncError;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFSYNCENGINE_H
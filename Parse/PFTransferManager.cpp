@@ -0,0 +1,232 @@
+//
+//  PFTransferManager.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFFile.h"
+#include "PFManager.h"
+#include "PFMetrics.h"
+#include "PFTransferManager.h"
+
+// Qt headers
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace parse {
+
+// Static Globals
+static QMutex gPFTransferManagerMutex;
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFTransferManager::PFTransferManager() :
+	_nextSequence(0),
+	_maximumConcurrentUploads(4),
+	_maximumConcurrentDownloads(6),
+	_startScheduled(false)
+{
+	_progressTimer.setInterval(100);
+	QObject::connect(&_progressTimer, SIGNAL(timeout()), this, SLOT(handleProgressTimeout()));
+}
+
+PFTransferManager::~PFTransferManager()
+{
+	// No-op
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFTransferManager* PFTransferManager::sharedManager()
+{
+	QMutexLocker lock(&gPFTransferManagerMutex);
+	static PFTransferManager manager;
+	return &manager;
+}
+
+#ifdef __APPLE__
+#pragma mark - Concurrency Methods
+#endif
+
+void PFTransferManager::setMaximumConcurrentUploads(int maximumConcurrentUploads)
+{
+	_maximumConcurrentUploads = qMax(1, maximumConcurrentUploads);
+	scheduleStart();
+}
+
+int PFTransferManager::maximumConcurrentUploads()
+{
+	return _maximumConcurrentUploads;
+}
+
+void PFTransferManager::setMaximumConcurrentDownloads(int maximumConcurrentDownloads)
+{
+	_maximumConcurrentDownloads = qMax(1, maximumConcurrentDownloads);
+	scheduleStart();
+}
+
+int PFTransferManager::maximumConcurrentDownloads()
+{
+	return _maximumConcurrentDownloads;
+}
+
+void PFTransferManager::setProgressInterval(int progressInterval)
+{
+	_progressTimer.setInterval(qMax(1, progressInterval));
+}
+
+int PFTransferManager::progressInterval()
+{
+	return _progressTimer.interval();
+}
+
+#ifdef __APPLE__
+#pragma mark - Group Methods
+#endif
+
+void PFTransferManager::cancelGroup(const QString& group)
+{
+	// Collect the files first since cancelling them modifies our containers
+	QList<PFFile*> files;
+	foreach (PFFile* file, _queueKeys.keys())
+	{
+		if (file->transferGroup() == group)
+			files.append(file);
+	}
+	foreach (PFFile* file, _activeUploads + _activeDownloads)
+	{
+		if (file->transferGroup() == group)
+			files.append(file);
+	}
+
+	foreach (PFFile* file, files)
+		file->cancel();
+}
+
+int PFTransferManager::queuedCount()
+{
+	return _queueKeys.count();
+}
+
+int PFTransferManager::activeCount()
+{
+	return _activeUploads.count() + _activeDownloads.count();
+}
+
+#ifdef __APPLE__
+#pragma mark - Backend API - Transfer Methods
+#endif
+
+void PFTransferManager::enqueue(PFFile* file, bool isUpload)
+{
+	if (!file || _queueKeys.contains(file))
+		return;
+
+	QueueKey key = qMakePair(-file->transferPriority(), _nextSequence++);
+	if (isUpload)
+		_queuedUploads.insert(key, file);
+	else
+		_queuedDownloads.insert(key, file);
+	_queueKeys.insert(file, key);
+	_enqueueUsecs.insert(file, PFManager::sharedManager()->metrics()->elapsedUsecs());
+
+	scheduleStart();
+}
+
+void PFTransferManager::updatePriority(PFFile* file)
+{
+	// Only queued transfers can be reprioritized, running ones are already running
+	if (!_queueKeys.contains(file))
+		return;
+
+	// Keep the original sequence so the file doesn't lose its place among its new peers
+	QueueKey oldKey = _queueKeys.value(file);
+	QueueKey newKey = qMakePair(-file->transferPriority(), oldKey.second);
+	if (_queuedUploads.remove(oldKey) > 0)
+		_queuedUploads.insert(newKey, file);
+	else if (_queuedDownloads.remove(oldKey) > 0)
+		_queuedDownloads.insert(newKey, file);
+	_queueKeys.insert(file, newKey);
+}
+
+void PFTransferManager::remove(PFFile* file)
+{
+	// Drop it from the queue if it hasn't started yet
+	if (_queueKeys.contains(file))
+	{
+		QueueKey key = _queueKeys.take(file);
+		_queuedUploads.remove(key);
+		_queuedDownloads.remove(key);
+		_enqueueUsecs.remove(file);
+		return;
+	}
+
+	// Otherwise free up its slot for the next transfer
+	if (_activeUploads.remove(file) || _activeDownloads.remove(file))
+		scheduleStart();
+
+	if (_activeUploads.isEmpty() && _activeDownloads.isEmpty())
+		_progressTimer.stop();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Scheduling Slots
+#endif
+
+void PFTransferManager::startPendingTransfers()
+{
+	_startScheduled = false;
+	startTransfers(_queuedUploads, _activeUploads, _maximumConcurrentUploads);
+	startTransfers(_queuedDownloads, _activeDownloads, _maximumConcurrentDownloads);
+
+	if (!_activeUploads.isEmpty() || !_activeDownloads.isEmpty())
+	{
+		if (!_progressTimer.isActive())
+			_progressTimer.start();
+	}
+}
+
+void PFTransferManager::handleProgressTimeout()
+{
+	foreach (PFFile* file, _activeUploads + _activeDownloads)
+		file->flushTransferProgress();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Scheduling Helper Methods
+#endif
+
+void PFTransferManager::scheduleStart()
+{
+	// Coalesce a burst of requests into a single pass through the queues
+	if (_startScheduled)
+		return;
+
+	_startScheduled = true;
+	QTimer::singleShot(0, this, SLOT(startPendingTransfers()));
+}
+
+void PFTransferManager::startTransfers(QMap<QueueKey, PFFile*>& queue, QSet<PFFile*>& active, int maximumConcurrent)
+{
+	PFMetrics* metrics = PFManager::sharedManager()->metrics();
+	while (active.count() < maximumConcurrent && !queue.isEmpty())
+	{
+		PFFile* file = queue.take(queue.firstKey());
+		_queueKeys.remove(file);
+		active.insert(file);
+		metrics->recordQueueWait("files", metrics->elapsedUsecs() - _enqueueUsecs.take(file));
+
+		// The file might finish (or fail) right away and remove itself again
+		file->startTransfer();
+	}
+}
+
+}	// End of parse namespace
@@ -0,0 +1,111 @@
+//
+//  PFTransferManager.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFTRANSFERMANAGER_H
+#define PARSE_PFTRANSFERMANAGER_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+namespace parse {
+
+// Schedules all the background PFFile uploads and downloads. Only a limited number of each run at the
+// same time, the rest wait in a queue ordered by priority (and then by the order they were requested).
+// Progress of the running transfers is reported at a fixed rate rather than for every network callback.
+class PFTransferManager : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	// Transfer priorities (higher priorities run first)
+	enum Priority
+	{
+		PriorityPrefetch = 0,
+		PriorityNormal = 1,
+		PriorityVisible = 2
+	};
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Creates a singleton instance of the PFTransferManager
+	static PFTransferManager* sharedManager();
+
+	// The number of uploads and downloads allowed to run at the same time. Default to 4 and 6.
+	void setMaximumConcurrentUploads(int maximumConcurrentUploads);
+	int maximumConcurrentUploads();
+	void setMaximumConcurrentDownloads(int maximumConcurrentDownloads);
+	int maximumConcurrentDownloads();
+
+	// How often (in msecs) the progress of the running transfers gets reported. Defaults to 100 msecs.
+	void setProgressInterval(int progressInterval);
+	int progressInterval();
+
+	// Cancels all the queued and running transfers of the files in the group (see PFFile::setTransferGroup)
+	void cancelGroup(const QString& group);
+
+	// The number of transfers waiting to start and currently running
+	int queuedCount();
+	int activeCount();
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Transfer Methods (called by PFFile)
+	void enqueue(PFFile* file, bool isUpload);
+	void updatePriority(PFFile* file);
+	void remove(PFFile* file);
+
+protected slots:
+
+	// Scheduling Slots
+	void startPendingTransfers();
+	void handleProgressTimeout();
+
+protected:
+
+	// Constructor / Destructor
+	PFTransferManager();
+	~PFTransferManager();
+
+	// Queue key - (negated priority, sequence) so the map iterates from highest priority down, then FIFO
+	typedef QPair<int, quint64> QueueKey;
+
+	// Scheduling Helper Methods
+	void scheduleStart();
+	void startTransfers(QMap<QueueKey, PFFile*>& queue, QSet<PFFile*>& active, int maximumConcurrent);
+
+	// Instance members
+	QMap<QueueKey, PFFile*>		_queuedUploads;
+	QMap<QueueKey, PFFile*>		_queuedDownloads;
+	QHash<PFFile*, QueueKey>	_queueKeys;
+	QHash<PFFile*, qint64>		_enqueueUsecs;
+	QSet<PFFile*>				_activeUploads;
+	QSet<PFFile*>				_activeDownloads;
+	quint64						_nextSequence;
+	int							_maximumConcurrentUploads;
+	int							_maximumConcurrentDownloads;
+	bool						_startScheduled;
+	QTimer						_progressTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFTRANSFERMANAGER_H
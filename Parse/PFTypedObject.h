@@ -0,0 +1,306 @@
+//
+//  PFTypedObject.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFTYPEDOBJECT_H
+#define PARSE_PFTYPEDOBJECT_H
+
+// Parse headers
+#include "PFObject.h"
+
+// Qt headers
+#include <QDebug>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+namespace parse {
+
+// Describes a single field in the constexpr field table of a PFTypedObject subclass
+struct PFFieldDescriptor
+{
+	const char* key;
+};
+
+// Names a field of a PFTypedObject subclass by its value type and its index in the field table
+template <typename T, int Index>
+struct PFField
+{
+	typedef T Type;
+	enum { index = Index };
+};
+
+// Converts field values to and from the variants stored in the object properties. Values that are already
+// stored as the field type are copied straight out of the variant rather than going through a conversion.
+template <typename T>
+struct PFFieldTraits
+{
+	static QVariant toVariant(const T& value)
+	{
+		return QVariant::fromValue(value);
+	}
+
+	static T fromVariant(const QVariant& variant)
+	{
+		if (variant.userType() == qMetaTypeId<T>())
+			return *static_cast<const T*>(variant.constData());
+
+		return variant.value<T>();
+	}
+};
+
+// Serializables (PFObjectPtr, PFFilePtr, PFDateTimePtr, typed objects...) are stored as PFSerializablePtr variants
+template <typename T>
+struct PFFieldTraits<QSharedPointer<T> >
+{
+	static QVariant toVariant(const QSharedPointer<T>& value)
+	{
+		return PFSerializable::toVariant(value);
+	}
+
+	static QSharedPointer<T> fromVariant(const QVariant& variant)
+	{
+		return variant.value<PFSerializablePtr>().template dynamicCast<T>();
+	}
+};
+
+// Base class for typed PFObject subclasses. The subclass names its parse class, lists its fields in a constexpr
+// table and declares a PFField for each one. Typed values live in a slot per field that the typed accessors
+// index directly, so they never look up a key or box the value into a variant. The slots only get written into
+// the properties when the generic property methods, the save or the serialization need them, and a slot is
+// read out of the properties once after they change (e.g. after a fetch).
+//
+//     class Game : public PFTypedObject<Game>
+//     {
+//     public:
+//         static const char* typedClassName() { return "Game"; }
+//         static constexpr PFFieldDescriptor fields[] = { {"name"}, {"score"} };
+//         typedef PFField<QString, 0> Name;
+//         typedef PFField<int, 1> Score;
+//
+//         QString name() { return valueForField<Name>(); }
+//         void setScore(int score) { setValueForField<Score>(score); }
+//
+//     protected:
+//         friend class PFTypedObject<Game>;
+//         Game() {}
+//     };
+//
+//     constexpr PFFieldDescriptor Game::fields[]; // In the source file
+//
+// Call Game::registerSubclass() once at startup so every "Game" object that gets fetched, queried or converted
+// out of json (PFConversion::convertJsonToVariant) is created as a Game.
+template <typename Derived>
+class PFTypedObject : public PFObject
+{
+public:
+
+	//=================================================================================
+	//                                  USER API
+	//=================================================================================
+
+	// Creation Methods
+	static QSharedPointer<Derived> object()
+	{
+		QSharedPointer<Derived> object = createTypedObject().template staticCast<Derived>();
+		object->_className = Derived::typedClassName();
+		applyDefaultACL(object);
+
+		return object;
+	}
+
+	static QSharedPointer<Derived> objectWithObjectId(const QString& objectId)
+	{
+		if (objectId.isEmpty())
+		{
+			qWarning() << "PFTypedObject::objectWithObjectId failed to create new object because the objectId is empty";
+			return QSharedPointer<Derived>();
+		}
+
+		QSharedPointer<Derived> object = createTypedObject().template staticCast<Derived>();
+		object->_className = Derived::typedClassName();
+		object->_objectId = objectId;
+
+		return object;
+	}
+
+	static QSharedPointer<Derived> objectFromVariant(const QVariant& variant)
+	{
+		return PFFieldTraits<QSharedPointer<Derived> >::fromVariant(variant);
+	}
+
+	// Registers the subclass so every object of the class name gets created as a Derived
+	static void registerSubclass()
+	{
+		registerSubclassFactory(Derived::typedClassName(), &PFTypedObject<Derived>::createTypedObject);
+	}
+
+	// Typed Field Methods
+	template <typename Field>
+	typename Field::Type valueForField()
+	{
+		static_assert(Field::index >= 0 && Field::index < fieldCount(), "PFField index is outside of the field table");
+		FieldSlot<typename Field::Type>* slot = fieldSlot<typename Field::Type>(Field::index);
+		if (slot->state == SlotEmpty)
+		{
+			// Read the value out of the properties once, it stays in the slot until the properties change
+			QVariantMap::const_iterator iter = _properties.constFind(fieldKey(Field::index));
+			slot->hasValue = (iter != _properties.constEnd());
+			slot->value = slot->hasValue ? PFFieldTraits<typename Field::Type>::fromVariant(iter.value()) : typename Field::Type();
+			slot->state = SlotClean;
+		}
+
+		return slot->value;
+	}
+
+	template <typename Field>
+	void setValueForField(const typename Field::Type& value)
+	{
+		static_assert(Field::index >= 0 && Field::index < fieldCount(), "PFField index is outside of the field table");
+		FieldSlot<typename Field::Type>* slot = fieldSlot<typename Field::Type>(Field::index);
+		slot->value = value;
+		slot->hasValue = true;
+		slot->state = SlotDirty;
+		_hasDirtyFields = true;
+	}
+
+	template <typename Field>
+	bool removeValueForField()
+	{
+		static_assert(Field::index >= 0 && Field::index < fieldCount(), "PFField index is outside of the field table");
+		return removeObjectForKey(fieldKey(Field::index));
+	}
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Field Table Methods
+	static constexpr int fieldCount()
+	{
+		return sizeof(Derived::fields) / sizeof(Derived::fields[0]);
+	}
+
+	static const QString& fieldKey(int index)
+	{
+		return fieldKeys().at(index);
+	}
+
+protected:
+
+	// The state of a slot compared to the properties
+	enum SlotState
+	{
+		SlotEmpty,		// Not read out of the properties yet
+		SlotClean,		// Same as the properties
+		SlotDirty		// Set since the properties were last written
+	};
+
+	// Slots are allocated the first time their field is used and then reused
+	struct FieldSlotBase
+	{
+		FieldSlotBase() : state(SlotEmpty), hasValue(false) {}
+		virtual ~FieldSlotBase() {}
+		virtual QVariant toVariant() const = 0;
+
+		SlotState	state;
+		bool		hasValue;
+	};
+
+	template <typename T>
+	struct FieldSlot : public FieldSlotBase
+	{
+		QVariant toVariant() const
+		{
+			return PFFieldTraits<T>::toVariant(value);
+		}
+
+		T value;
+	};
+
+	// Constructor / Destructor
+	PFTypedObject() :
+		_fieldSlots(fieldCount(), NULL),
+		_hasDirtyFields(false)
+	{}
+
+	~PFTypedObject()
+	{
+		qDeleteAll(_fieldSlots);
+	}
+
+	// Typed Field Helper Methods
+	template <typename T>
+	FieldSlot<T>* fieldSlot(int index)
+	{
+		FieldSlotBase*& slot = _fieldSlots[index];
+		if (!slot)
+			slot = new FieldSlot<T>();
+
+		return static_cast<FieldSlot<T>*>(slot);
+	}
+
+	// PFObject Typed Field Methods
+	virtual void writeTypedFields()
+	{
+		if (!_hasDirtyFields)
+			return;
+
+		_hasDirtyFields = false;
+		for (int i = 0; i < _fieldSlots.count(); ++i)
+		{
+			FieldSlotBase* slot = _fieldSlots.at(i);
+			if (slot && slot->state == SlotDirty)
+			{
+				storeObjectForKey(slot->toVariant(), fieldKey(i));
+				slot->state = SlotClean;
+			}
+		}
+	}
+
+	virtual void discardTypedFields()
+	{
+		// Pending values were written by the caller beforehand, only the copies read out of the properties go
+		foreach (FieldSlotBase* slot, _fieldSlots)
+		{
+			if (slot && slot->state == SlotClean)
+				slot->state = SlotEmpty;
+		}
+	}
+
+	// Subclass factory handed to PFObject::registerSubclassFactory
+	static PFObjectPtr createTypedObject()
+	{
+		return PFObjectPtr(new Derived(), &QObject::deleteLater);
+	}
+
+	// The field keys get built out of the field table once per subclass
+	static const QVector<QString>& fieldKeys()
+	{
+		static const QVector<QString> keys = buildFieldKeys();
+		return keys;
+	}
+
+	static QVector<QString> buildFieldKeys()
+	{
+		QVector<QString> keys;
+		keys.reserve(fieldCount());
+		for (int i = 0; i < fieldCount(); ++i)
+			keys.append(QString::fromLatin1(Derived::fields[i].key));
+
+		return keys;
+	}
+
+	// Instance members
+	QVector<FieldSlotBase*>		_fieldSlots;
+	bool						_hasDirtyFields;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFTYPEDOBJECT_H
@@ -20,9 +20,16 @@ class PFACL;
 class PFDateTime;
 class PFError;
 class PFFile;
+class PFFileCache;
+class PFLocalDatastore;
+class PFMetrics;
+class PFNetworkInterceptor;
 class PFObject;
 class PFQuery;
+class PFQuerySubscription;
 class PFSerializable;
+class PFSyncEngine;
+class PFUploadIndex;
 class PFUser;
 
 // Parse Typedefs
@@ -30,14 +37,24 @@ typedef QSharedPointer<PFACL> PFACLPtr;
 typedef QSharedPointer<PFDateTime> PFDateTimePtr;
 typedef QSharedPointer<PFError> PFErrorPtr;
 typedef QSharedPointer<PFFile> PFFilePtr;
+typedef QSharedPointer<PFFileCache> PFFileCachePtr;
+typedef QSharedPointer<PFLocalDatastore> PFLocalDatastorePtr;
+typedef QSharedPointer<PFMetrics> PFMetricsPtr;
+typedef QSharedPointer<PFNetworkInterceptor> PFNetworkInterceptorPtr;
 typedef QSharedPointer<PFObject> PFObjectPtr;
 typedef QSharedPointer<PFQuery> PFQueryPtr;
+typedef QSharedPointer<PFQuerySubscription> PFQuerySubscriptionPtr;
 typedef QSharedPointer<PFSerializable> PFSerializablePtr;
+typedef QSharedPointer<PFSyncEngine> PFSyncEnginePtr;
+typedef QSharedPointer<PFUploadIndex> PFUploadIndexPtr;
 typedef QSharedPointer<PFUser> PFUserPtr;
 
 // Parse Collection Typedefs
 typedef QList<PFObjectPtr> PFObjectList;
 
+// Parse Factory Typedefs
+typedef PFObjectPtr (*PFObjectFactory)();
+
 // Qt Typedefs
 typedef QSharedPointer<QByteArray> QByteArrayPtr;
 
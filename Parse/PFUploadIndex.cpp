@@ -0,0 +1,232 @@
+//
+//  PFUploadIndex.cpp
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+// Parse headers
+#include "PFLogging.h"
+#include "PFUploadIndex.h"
+
+// Qt headers
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace parse {
+
+// Static Globals
+static const QString gIndexFilename = "index.json";
+static const int gSaveIndexDelay = 1000;
+static const qint64 gHashReadBufferSize = 64 * 1024;
+
+#ifdef __APPLE__
+#pragma mark - Memory Management Methods
+#endif
+
+PFUploadIndex::PFUploadIndex() :
+	_isIndexLoaded(false)
+{
+	qCDebug(PFLogLifetime).nospace() << "Created PFUploadIndex(" << QString().sprintf("%8p", this) << ")";
+
+	_saveIndexTimer.setSingleShot(true);
+	QObject::connect(&_saveIndexTimer, SIGNAL(timeout()), this, SLOT(handleSaveIndexTimeout()));
+}
+
+PFUploadIndex::~PFUploadIndex()
+{
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFUploadIndex(" << QString().sprintf("%8p", this) << ")";
+
+	// Flush any pending index changes
+	if (_saveIndexTimer.isActive())
+		saveIndex();
+}
+
+#ifdef __APPLE__
+#pragma mark - Creation Methods
+#endif
+
+PFUploadIndexPtr PFUploadIndex::uploadIndexWithDirectory(const QDir& directory)
+{
+	PFUploadIndexPtr uploadIndex = PFUploadIndexPtr(new PFUploadIndex(), &QObject::deleteLater);
+	uploadIndex->_directory = directory;
+	uploadIndex->_directory.mkpath(uploadIndex->_directory.absolutePath());
+
+	return uploadIndex;
+}
+
+QString PFUploadIndex::hashForData(const QByteArray& data)
+{
+	return QString::fromUtf8(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+}
+
+QString PFUploadIndex::hashForDevice(QIODevice* device)
+{
+	// Feed the hash a chunk at a time so large files never have to fit in memory
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	QByteArray buffer;
+	while (!device->atEnd())
+	{
+		buffer = device->read(gHashReadBufferSize);
+		if (buffer.isEmpty())
+			return QString();
+		hash.addData(buffer);
+	}
+
+	return QString::fromUtf8(hash.result().toHex());
+}
+
+#ifdef __APPLE__
+#pragma mark - Entry Methods
+#endif
+
+bool PFUploadIndex::lookup(const QString& applicationId, const QString& hash, const QString& mimeType, QString& name, QString& url)
+{
+	loadIndex();
+	QHash<QString, Entry>::const_iterator iter = _entries.constFind(keyForEntry(applicationId, hash));
+	if (iter == _entries.constEnd() || iter->applicationId != applicationId || iter->mimeType != mimeType)
+		return false;
+
+	name = iter->name;
+	url = iter->url;
+	return true;
+}
+
+void PFUploadIndex::insert(const QString& applicationId, const QString& hash, const QString& mimeType, const QString& name, const QString& url)
+{
+	if (applicationId.isEmpty() || hash.isEmpty() || url.isEmpty())
+		return;
+
+	loadIndex();
+	Entry entry;
+	entry.applicationId = applicationId;
+	entry.mimeType = mimeType;
+	entry.name = name;
+	entry.url = url;
+	_entries.insert(keyForEntry(applicationId, hash), entry);
+	setNeedsSaveIndex();
+}
+
+void PFUploadIndex::removeUrl(const QString& url)
+{
+	loadIndex();
+	QHash<QString, Entry>::iterator iter = _entries.begin();
+	bool removed = false;
+	while (iter != _entries.end())
+	{
+		if (iter->url == url)
+		{
+			iter = _entries.erase(iter);
+			removed = true;
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	if (removed)
+		setNeedsSaveIndex();
+}
+
+void PFUploadIndex::clear()
+{
+	_entries.clear();
+	_isIndexLoaded = true;
+	_saveIndexTimer.stop();
+	QFile::remove(_directory.filePath(gIndexFilename));
+}
+
+int PFUploadIndex::count()
+{
+	loadIndex();
+	return _entries.count();
+}
+
+void PFUploadIndex::saveIndex()
+{
+	loadIndex();
+	_saveIndexTimer.stop();
+
+	QJsonObject entriesObject;
+	for (QHash<QString, Entry>::const_iterator iter = _entries.constBegin(); iter != _entries.constEnd(); ++iter)
+	{
+		QJsonObject entryObject;
+		entryObject["applicationId"] = iter->applicationId;
+		entryObject["mimeType"] = iter->mimeType;
+		entryObject["name"] = iter->name;
+		entryObject["url"] = iter->url;
+		entriesObject[iter.key()] = entryObject;
+	}
+
+	QJsonObject rootObject;
+	rootObject["entries"] = entriesObject;
+
+	QSaveFile file(_directory.filePath(gIndexFilename));
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "PFUploadIndex::saveIndex failed because the index file could not be opened";
+		return;
+	}
+
+	file.write(QJsonDocument(rootObject).toJson(QJsonDocument::Compact));
+	file.commit();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Timer Slots
+#endif
+
+void PFUploadIndex::handleSaveIndexTimeout()
+{
+	saveIndex();
+}
+
+#ifdef __APPLE__
+#pragma mark - Protected Index Helper Methods
+#endif
+
+QString PFUploadIndex::keyForEntry(const QString& applicationId, const QString& hash)
+{
+	return applicationId + "/" + hash;
+}
+
+void PFUploadIndex::loadIndex()
+{
+	// The index is small and only needed when saving files, so it's read on first use
+	if (_isIndexLoaded)
+		return;
+
+	_isIndexLoaded = true;
+	QFile file(_directory.filePath(gIndexFilename));
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	QJsonObject entriesObject = QJsonDocument::fromJson(file.readAll()).object()["entries"].toObject();
+	for (QJsonObject::const_iterator iter = entriesObject.constBegin(); iter != entriesObject.constEnd(); ++iter)
+	{
+		QJsonObject entryObject = iter.value().toObject();
+		Entry entry;
+		entry.applicationId = entryObject["applicationId"].toString();
+		entry.mimeType = entryObject["mimeType"].toString();
+		entry.name = entryObject["name"].toString();
+		entry.url = entryObject["url"].toString();
+		// Entries without an application id can't be matched to the app that owns them, so they're dropped
+		if (!entry.applicationId.isEmpty() && !entry.url.isEmpty())
+			_entries.insert(iter.key(), entry);
+	}
+}
+
+void PFUploadIndex::setNeedsSaveIndex()
+{
+	// Batch up a burst of changes into a single write
+	if (!_saveIndexTimer.isActive())
+		_saveIndexTimer.start(gSaveIndexDelay);
+}
+
+}	// End of parse namespace
@@ -0,0 +1,91 @@
+//
+//  PFUploadIndex.h
+//  Parse
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef PARSE_PFUPLOADINDEX_H
+#define PARSE_PFUPLOADINDEX_H
+
+// Parse headers
+#include "PFTypedefs.h"
+
+// Qt headers
+#include <QDir>
+#include <QHash>
+#include <QIODevice>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+namespace parse {
+
+// Remembers which file contents have already been uploaded. Entries map the application id and the SHA-256
+// hash of the file contents to the name and url Parse returned for it, so saving an identical file again
+// can reuse the existing upload instead of sending the bytes a second time. The index is persisted to a json file
+// in its directory, read the first time it's needed and written shortly after a change.
+class PFUploadIndex : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	//=================================================================================
+	//                                BACKEND API
+	//=================================================================================
+
+	// Creation Methods
+	static PFUploadIndexPtr uploadIndexWithDirectory(const QDir& directory);
+
+	// Returns the hex encoded SHA-256 hash of the data or of the device contents (read in chunks)
+	static QString hashForData(const QByteArray& data);
+	static QString hashForDevice(QIODevice* device);
+
+	// Entry Methods - lookup only succeeds if the previous upload was made by the same application with
+	// the same mime type (files uploaded to one app can't be referenced from another)
+	bool lookup(const QString& applicationId, const QString& hash, const QString& mimeType, QString& name, QString& url);
+	void insert(const QString& applicationId, const QString& hash, const QString& mimeType, const QString& name, const QString& url);
+	void removeUrl(const QString& url);
+	void clear();
+	int count();
+
+	// Writes the index out to disk (this normally happens automatically shortly after a change)
+	void saveIndex();
+
+protected slots:
+
+	// Timer Slots
+	void handleSaveIndexTimeout();
+
+protected:
+
+	// Constructor / Destructor
+	PFUploadIndex();
+	~PFUploadIndex();
+
+	// Entry struct
+	struct Entry
+	{
+		QString applicationId;
+		QString mimeType;
+		QString name;
+		QString url;
+	};
+
+	// Index Helper Methods
+	static QString keyForEntry(const QString& applicationId, const QString& hash);
+	void loadIndex();
+	void setNeedsSaveIndex();
+
+	// Instance members
+	QDir					_directory;
+	QHash<QString, Entry>	_entries;
+	bool					_isIndexLoaded;
+	QTimer					_saveIndexTimer;
+};
+
+}	// End of parse namespace
+
+#endif	// End of PARSE_PFUPLOADINDEX_H
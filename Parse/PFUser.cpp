@@ -10,7 +10,9 @@
 #include "PFConversion.h"
 #include "PFDateTime.h"
 #include "PFError.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
 #include "PFQuery.h"
 #include "PFUser.h"
 
@@ -39,13 +41,13 @@ PFUser::PFUser() : PFObject(),
 	_password(""),
 	_sessionToken("")
 {
-	qDebug().nospace() << "Created PFUser(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Created PFUser(" << QString().sprintf("%8p", this) << ")";
 	_className = "_User";
 }
 
 PFUser::~PFUser()
 {
-	qDebug().nospace() << "Destroyed PFUser(" << QString().sprintf("%8p", this) << ")";
+	qCDebug(PFLogLifetime).nospace() << "Destroyed PFUser(" << QString().sprintf("%8p", this) << ")";
 }
 
 #ifdef __APPLE__
@@ -205,7 +207,7 @@ void PFUser::signUpWithUserInBackground(PFUserPtr user, QObject* target, const c
 
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->post(request, data);
+	gSignUpUser->_backgroundReply = networkAccessManager->post(request, data);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), gSignUpUser.data(), SLOT(handleSignUpReply(QNetworkReply*)));
 	if (target)
 		QObject::connect(gSignUpUser.data(), SIGNAL(signUpCompleted(bool, PFErrorPtr)), target, action);
@@ -272,7 +274,7 @@ void PFUser::logInWithUsernameAndPasswordInBackground(const QString& username, c
 
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->get(request);
+	gLogInUser->_backgroundReply = networkAccessManager->get(request);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), gLogInUser.data(), SLOT(handleLogInReply(QNetworkReply*)));
 	if (target)
 		QObject::connect(gLogInUser.data(), SIGNAL(logInCompleted(bool, PFErrorPtr)), target, action);
@@ -344,7 +346,7 @@ void PFUser::requestPasswordResetForEmailInBackground(const QString& email, QObj
 
 	// Execute the request and connect the callbacks
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
-	networkAccessManager->post(request, data);
+	gPasswordResetUser->_backgroundReply = networkAccessManager->post(request, data);
 	QObject::connect(networkAccessManager, SIGNAL(finished(QNetworkReply*)), gPasswordResetUser.data(), SLOT(handleRequestPasswordResetReply(QNetworkReply*)));
 	if (target)
 		QObject::connect(gPasswordResetUser.data(), SIGNAL(requestPasswordResetCompleted(bool, PFErrorPtr)), target, action);
@@ -404,12 +406,29 @@ const QString PFUser::pfClassName() const
 	return "PFUser";
 }
 
+bool PFUser::toObjectJson(QJsonObject& jsonObject)
+{
+	// Serialize the base object then add the keys not tracked in the properties (never the password or session token)
+	if (!PFObject::toObjectJson(jsonObject))
+		return false;
+
+	jsonObject["username"] = _username;
+	jsonObject["email"] = _email;
+	return true;
+}
+
 #ifdef __APPLE__
 #pragma mark - Background Network Reply Completion Slots
 #endif
 
 void PFUser::handleSignUpReply(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -433,6 +452,12 @@ void PFUser::handleSignUpReply(QNetworkReply* networkReply)
 
 void PFUser::handleLogInReply(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -456,6 +481,12 @@ void PFUser::handleLogInReply(QNetworkReply* networkReply)
 
 void PFUser::handleRequestPasswordResetReply(QNetworkReply* networkReply)
 {
+	// The manager reports every reply it finishes (including the attempts of retried requests), only the
+	// reply this instance was handed counts
+	if (networkReply != _backgroundReply)
+		return;
+	_backgroundReply = NULL;
+
 	// Disconnect the network access manager as well as all the connected signals to this instance
 	QNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
 	networkAccessManager->disconnect(this);
@@ -593,7 +624,7 @@ QNetworkRequest PFUser::createFetchNetworkRequest()
 bool PFUser::deserializeSignUpNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
@@ -620,7 +651,7 @@ bool PFUser::deserializeSignUpNetworkReply(QNetworkReply* networkReply, PFErrorP
 bool PFUser::deserializeLogInNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
@@ -645,7 +676,7 @@ bool PFUser::deserializeLogInNetworkReply(QNetworkReply* networkReply, PFErrorPt
 bool PFUser::deserializePasswordResetNetworkReply(QNetworkReply* networkReply, PFErrorPtr& error)
 {
 	// Parse the json reply
-	QJsonDocument doc = QJsonDocument::fromJson(networkReply->readAll());
+	QJsonDocument doc = PFManager::sharedManager()->metrics()->decodeReply(networkReply);
 	QJsonObject jsonObject = doc.object();
 
 	// Extract the JSON payload
@@ -112,6 +112,7 @@ public:
 	static QVariant fromJson(const QJsonObject& jsonObject);
 	virtual bool toJson(QJsonObject& jsonObject);
 	virtual const QString pfClassName() const;
+	virtual bool toObjectJson(QJsonObject& jsonObject);
 
 protected slots:
 
@@ -10,15 +10,36 @@
 #define PARSE_PARSE_H
 
 #include "PFACL.h"
+#include "PFBinaryEncoding.h"
+#include "PFCircuitBreaker.h"
 #include "PFConversion.h"
 #include "PFDateTime.h"
 #include "PFError.h"
 #include "PFFile.h"
+#include "PFFileCache.h"
+#include "PFHistogram.h"
+#include "PFImageLoader.h"
+#include "PFLocalDatastore.h"
+#include "PFLogging.h"
 #include "PFManager.h"
+#include "PFMetrics.h"
+#include "PFMimeTypeResolver.h"
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
 #include "PFObject.h"
 #include "PFQuery.h"
+#include "PFQuerySubscription.h"
+#include "PFRequestScheduler.h"
+#include "PFRetryPolicy.h"
+#include "PFRetryReply.h"
 #include "PFSerializable.h"
+#include "PFSubscriptionManager.h"
+#include "PFSyncEngine.h"
+#include "PFTransferManager.h"
+#include "PFTypedObject.h"
 #include "PFTypedefs.h"
+#include "PFUploadIndex.h"
 #include "PFUser.h"
 
 #endif	// End of PARSE_PARSE_H
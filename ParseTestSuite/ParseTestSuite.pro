@@ -1,7 +1,8 @@
 
 # Configuration Settings
 CONFIG += console
-QT += widgets network testlib
+QT += widgets network sql testlib
+QMAKE_CXXFLAGS += -std=c++11
 TARGET = ParseTestSuite
 TEMPLATE = app
 
@@ -13,8 +14,8 @@ INCLUDEPATH +=	../Parse moc
 # Build directories
 MOC_DIR = moc
 
-# Kill Debug and Warning Output
-DEFINES += QT_NO_DEBUG_OUTPUT QT_NO_WARNING_OUTPUT
+# Kill Warning Output (debug output goes through the parse.* logging categories like it does in the library)
+DEFINES += QT_NO_WARNING_OUTPUT
 
 # Mac Settings
 macx {
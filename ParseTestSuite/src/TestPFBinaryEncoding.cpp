@@ -0,0 +1,285 @@
+//
+//  TestPFBinaryEncoding.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFACL.h"
+#include "PFBinaryEncoding.h"
+#include "PFConversion.h"
+#include "PFDateTime.h"
+#include "PFObject.h"
+#include "TestRunner.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace parse;
+
+class TestPFBinaryEncoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Json Encoding Methods
+	void test_roundTripScalars();
+	void test_roundTripContainers();
+	void test_roundTripTypes();
+	void test_roundTripObjectJson();
+	void test_decodeInvalidData();
+
+	// Variant Encoding Methods
+	void test_roundTripVariant();
+
+	// Size Methods
+	void test_encodedSize();
+
+	// Benchmark Methods
+	void test_encodeBenchmark_data();
+	void test_encodeBenchmark();
+	void test_decodeBenchmark_data();
+	void test_decodeBenchmark();
+
+private:
+
+	// Helper Methods
+	static QJsonObject createObjectJson(int index);
+	static QJsonArray createObjectJsonList();
+	static void verifyRoundTrip(const QJsonValue& jsonValue);
+};
+
+QJsonObject TestPFBinaryEncoding::createObjectJson(int index)
+{
+	// A typical object as the REST API returns it
+	PFObjectPtr object = PFObject::objectWithClassName("GameScore", QString("obj%1").arg(index));
+	object->setObjectForKey(QString("Player %1").arg(index), "playerName");
+	object->setObjectForKey(1000 + index, "score");
+	object->setObjectForKey(index % 2 == 0, "cheatMode");
+	object->setObjectForKey(index * 0.25, "accuracy");
+	object->setObjectForKey(PFDateTime::toVariant(PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z")), "startedAt");
+	object->setObjectForKey(PFObject::toVariant(PFObject::objectWithClassName("Player", QString("player%1").arg(index))), "player");
+	object->setObjectForKey(QVariantList() << "board" << "classic", "tags");
+	PFACLPtr acl = PFACL::ACL();
+	acl->setPublicReadAccess(true);
+	acl->setWriteAccessForUserId(true, QString("user%1").arg(index));
+	object->setACL(acl);
+
+	QJsonObject jsonObject;
+	object->toObjectJson(jsonObject);
+	jsonObject["createdAt"] = QString("2013-09-15T09:32:00.123Z");
+	jsonObject["updatedAt"] = QString("2013-09-16T10:00:00.000Z");
+	return jsonObject;
+}
+
+QJsonArray TestPFBinaryEncoding::createObjectJsonList()
+{
+	QJsonArray jsonArray;
+	for (int i = 0; i < 100; ++i)
+		jsonArray.append(createObjectJson(i));
+
+	return jsonArray;
+}
+
+void TestPFBinaryEncoding::verifyRoundTrip(const QJsonValue& jsonValue)
+{
+	QByteArray data = PFBinaryEncoding::encodeJson(jsonValue);
+	QCOMPARE(PFBinaryEncoding::isBinaryEncoded(data), true);
+
+	QJsonValue decodedValue;
+	QCOMPARE(PFBinaryEncoding::decodeJson(data, decodedValue), true);
+	QCOMPARE(decodedValue, jsonValue);
+}
+
+void TestPFBinaryEncoding::test_roundTripScalars()
+{
+	verifyRoundTrip(QJsonValue(QJsonValue::Null));
+	verifyRoundTrip(QJsonValue(true));
+	verifyRoundTrip(QJsonValue(false));
+	verifyRoundTrip(QJsonValue(0.0));
+	verifyRoundTrip(QJsonValue(-0.0));
+	verifyRoundTrip(QJsonValue(42.0));
+	verifyRoundTrip(QJsonValue(-42.0));
+	verifyRoundTrip(QJsonValue(9007199254740992.0));
+	verifyRoundTrip(QJsonValue(1.0e300));
+	verifyRoundTrip(QJsonValue(3.14159));
+	verifyRoundTrip(QJsonValue(QString()));
+	verifyRoundTrip(QJsonValue(QString("Some string")));
+	verifyRoundTrip(QJsonValue(QString::fromUtf8("\xe2\x98\x83 unicode")));
+
+	// Date strings only get the compact form when they are in the exact parse format
+	verifyRoundTrip(QJsonValue(QString("2013-09-15T09:32:00.123Z")));
+	verifyRoundTrip(QJsonValue(QString("2013-09-15T09:32:00Z")));
+	verifyRoundTrip(QJsonValue(QString("2013-19-15T09:32:00.123Z")));
+}
+
+void TestPFBinaryEncoding::test_roundTripContainers()
+{
+	QJsonArray jsonArray;
+	jsonArray.append(1.0);
+	jsonArray.append(QString("two"));
+	jsonArray.append(QJsonArray());
+	jsonArray.append(QJsonObject());
+	verifyRoundTrip(jsonArray);
+
+	QJsonObject nestedObject;
+	nestedObject["array"] = jsonArray;
+	nestedObject["two"] = QString("two");
+	QJsonObject jsonObject;
+	jsonObject["nested"] = nestedObject;
+	jsonObject["two"] = QString("two");
+	verifyRoundTrip(jsonObject);
+}
+
+void TestPFBinaryEncoding::test_roundTripTypes()
+{
+	QJsonObject dateObject;
+	dateObject["__type"] = QString("Date");
+	dateObject["iso"] = QString("2013-09-15T09:32:00.123Z");
+	verifyRoundTrip(dateObject);
+
+	QJsonObject pointerObject;
+	pointerObject["__type"] = QString("Pointer");
+	pointerObject["className"] = QString("GameScore");
+	pointerObject["objectId"] = QString("1234");
+	verifyRoundTrip(pointerObject);
+
+	QJsonObject fileObject;
+	fileObject["__type"] = QString("File");
+	fileObject["name"] = QString("tfss-image.png");
+	fileObject["url"] = QString("http://files.parse.com/tfss-image.png");
+	verifyRoundTrip(fileObject);
+
+	// Typed objects that don't have the expected shape go through the generic object form
+	dateObject["extra"] = true;
+	verifyRoundTrip(dateObject);
+	pointerObject["objectId"] = 1234.0;
+	verifyRoundTrip(pointerObject);
+}
+
+void TestPFBinaryEncoding::test_roundTripObjectJson()
+{
+	QJsonObject jsonObject = createObjectJson(7);
+	verifyRoundTrip(jsonObject);
+
+	// The decoded json converts back into the same object
+	QJsonValue decodedValue;
+	QCOMPARE(PFBinaryEncoding::decodeJson(PFBinaryEncoding::encodeJson(jsonObject), decodedValue), true);
+	PFObjectPtr object = PFObject::objectFromVariant(PFConversion::convertJsonToVariant(decodedValue));
+	QCOMPARE(object.isNull(), false);
+	QCOMPARE(object->className(), QString("GameScore"));
+	QCOMPARE(object->objectId(), QString("obj7"));
+	QCOMPARE(object->objectForKey("score").toInt(), 1007);
+	QCOMPARE(object->ACL()->publicReadAccess(), true);
+	QCOMPARE(object->ACL()->writeAccessForUserId("user7"), true);
+}
+
+void TestPFBinaryEncoding::test_decodeInvalidData()
+{
+	QJsonValue jsonValue;
+	QCOMPARE(PFBinaryEncoding::decodeJson(QByteArray(), jsonValue), false);
+	QCOMPARE(PFBinaryEncoding::decodeJson(QByteArray("{\"key\":1}"), jsonValue), false);
+
+	// Truncated, trailing bytes and unknown versions
+	QByteArray data = PFBinaryEncoding::encodeJson(createObjectJson(1));
+	QCOMPARE(PFBinaryEncoding::decodeJson(data.left(data.size() - 1), jsonValue), false);
+	QCOMPARE(PFBinaryEncoding::decodeJson(data + QByteArray(1, '\0'), jsonValue), false);
+	QByteArray versionData = data;
+	versionData[3] = char(PFBinaryEncoding::formatVersion() + 1);
+	QCOMPARE(PFBinaryEncoding::decodeJson(versionData, jsonValue), false);
+
+	// Every truncation fails rather than reading out of bounds
+	for (int i = 0; i < data.size(); ++i)
+		QCOMPARE(PFBinaryEncoding::decodeJson(data.left(i), jsonValue), false);
+}
+
+void TestPFBinaryEncoding::test_roundTripVariant()
+{
+	QVariantMap variantMap;
+	variantMap["name"] = QString("Chess");
+	variantMap["score"] = 42;
+	variantMap["date"] = PFDateTime::toVariant(PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z"));
+	variantMap["pointer"] = PFObject::toVariant(PFObject::objectWithClassName("Player", "1234"));
+
+	QVariant variant = PFBinaryEncoding::decodeVariant(PFBinaryEncoding::encodeVariant(variantMap));
+	QVariantMap decodedMap = variant.toMap();
+	QCOMPARE(decodedMap["name"].toString(), QString("Chess"));
+	QCOMPARE(decodedMap["score"].toInt(), 42);
+	QCOMPARE(PFDateTime::dateTimeFromVariant(decodedMap["date"])->toParseString(), QString("2013-09-15T09:32:00.123Z"));
+	QCOMPARE(PFObject::objectFromVariant(decodedMap["pointer"])->objectId(), QString("1234"));
+
+	QCOMPARE(PFBinaryEncoding::decodeVariant(QByteArray("garbage")).isValid(), false);
+}
+
+void TestPFBinaryEncoding::test_encodedSize()
+{
+	QJsonArray jsonArray = createObjectJsonList();
+	int jsonSize = QJsonDocument(jsonArray).toJson(QJsonDocument::Compact).size();
+	int binarySize = PFBinaryEncoding::encodeJson(jsonArray).size();
+	qDebug() << "Encoded" << jsonArray.size() << "objects into" << jsonSize << "json bytes and" << binarySize << "binary bytes";
+	QVERIFY(binarySize * 2 < jsonSize);
+
+	// A single object has no repeated objects to share its strings with but is still smaller
+	QJsonObject jsonObject = createObjectJson(1);
+	QVERIFY(PFBinaryEncoding::encodeJson(jsonObject).size() < QJsonDocument(jsonObject).toJson(QJsonDocument::Compact).size());
+}
+
+void TestPFBinaryEncoding::test_encodeBenchmark_data()
+{
+	QTest::addColumn<bool>("binary");
+	QTest::newRow("binary") << true;
+	QTest::newRow("json") << false;
+}
+
+void TestPFBinaryEncoding::test_encodeBenchmark()
+{
+	QFETCH(bool, binary);
+	QJsonArray jsonArray = createObjectJsonList();
+	QBENCHMARK
+	{
+		if (binary)
+			PFBinaryEncoding::encodeJson(jsonArray);
+		else
+			QJsonDocument(jsonArray).toJson(QJsonDocument::Compact);
+	}
+}
+
+void TestPFBinaryEncoding::test_decodeBenchmark_data()
+{
+	QTest::addColumn<bool>("binary");
+	QTest::newRow("binary") << true;
+	QTest::newRow("json") << false;
+}
+
+void TestPFBinaryEncoding::test_decodeBenchmark()
+{
+	QFETCH(bool, binary);
+	QJsonArray jsonArray = createObjectJsonList();
+	QByteArray data = binary ? PFBinaryEncoding::encodeJson(jsonArray) : QJsonDocument(jsonArray).toJson(QJsonDocument::Compact);
+	QBENCHMARK
+	{
+		if (binary)
+		{
+			QJsonValue jsonValue;
+			PFBinaryEncoding::decodeJson(data, jsonValue);
+		}
+		else
+		{
+			QJsonDocument::fromJson(data);
+		}
+	}
+}
+
+DECLARE_TEST(TestPFBinaryEncoding)
+#include "TestPFBinaryEncoding.moc"
@@ -0,0 +1,187 @@
+//
+//  TestPFCircuitBreaker.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFCircuitBreaker.h"
+#include "TestRunner.h"
+
+using namespace parse;
+
+class TestPFCircuitBreaker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// State Methods
+	void test_staysClosedBelowMinimumRequests();
+	void test_opensAtThreshold();
+	void test_halfOpenTrialSucceeds();
+	void test_halfOpenTrialFails();
+	void test_halfOpenTrialCanceled();
+	void test_windowForgetsOldOutcomes();
+	void test_hostsAreIndependent();
+	void test_disabled();
+
+private:
+
+	// Helper Methods
+	static PFRetryPolicy createRetryPolicy();
+};
+
+PFRetryPolicy TestPFCircuitBreaker::createRetryPolicy()
+{
+	PFRetryPolicy retryPolicy;
+	retryPolicy.setFailureWindowSize(10);
+	retryPolicy.setMinimumRequestCount(4);
+	retryPolicy.setFailureRateThreshold(0.5);
+	retryPolicy.setOpenDuration(1000);
+
+	return retryPolicy;
+}
+
+void TestPFCircuitBreaker::test_staysClosedBelowMinimumRequests()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	for (int i = 0; i < 3; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Closed);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 0), true);
+}
+
+void TestPFCircuitBreaker::test_opensAtThreshold()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	circuitBreaker.recordSuccess("api.parse.com");
+	circuitBreaker.recordSuccess("api.parse.com");
+	circuitBreaker.recordFailure("api.parse.com", 0);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Closed);
+
+	// 2 failures out of 4 requests
+	circuitBreaker.recordFailure("api.parse.com", 100);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 100), PFCircuitBreaker::Open);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 100), false);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1099), false);
+}
+
+void TestPFCircuitBreaker::test_halfOpenTrialSucceeds()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	for (int i = 0; i < 4; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 1000), PFCircuitBreaker::HalfOpen);
+
+	// Only a single trial request goes through
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1000), true);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1001), false);
+
+	circuitBreaker.recordSuccess("api.parse.com");
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 1002), PFCircuitBreaker::Closed);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1002), true);
+
+	// The closed circuit starts with an empty window
+	for (int i = 0; i < 3; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 1003);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 1003), PFCircuitBreaker::Closed);
+}
+
+void TestPFCircuitBreaker::test_halfOpenTrialFails()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	for (int i = 0; i < 4; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1500), true);
+	circuitBreaker.recordFailure("api.parse.com", 1600);
+
+	// Open for another full duration
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 2599), PFCircuitBreaker::Open);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 2599), false);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 2600), true);
+}
+
+void TestPFCircuitBreaker::test_halfOpenTrialCanceled()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	for (int i = 0; i < 4; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+
+	// A canceled trial hands the trial to the next request
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1000), true);
+	circuitBreaker.recordCanceled("api.parse.com");
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1001), true);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 1002), false);
+}
+
+void TestPFCircuitBreaker::test_windowForgetsOldOutcomes()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+
+	// 4 failures followed by 10 successes push the failures out of the window
+	for (int i = 0; i < 4; ++i)
+	{
+		circuitBreaker.recordSuccess("api.parse.com");
+		circuitBreaker.recordSuccess("api.parse.com");
+		circuitBreaker.recordSuccess("api.parse.com");
+		circuitBreaker.recordFailure("api.parse.com", 0);
+	}
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Closed);
+
+	for (int i = 0; i < 10; ++i)
+		circuitBreaker.recordSuccess("api.parse.com");
+	for (int i = 0; i < 4; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Closed);
+
+	circuitBreaker.recordFailure("api.parse.com", 0);
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Open);
+}
+
+void TestPFCircuitBreaker::test_hostsAreIndependent()
+{
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(createRetryPolicy());
+	for (int i = 0; i < 4; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 0), false);
+	QCOMPARE(circuitBreaker.allowRequest("files.parse.com", 0), true);
+
+	circuitBreaker.reset();
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 0), true);
+}
+
+void TestPFCircuitBreaker::test_disabled()
+{
+	PFRetryPolicy retryPolicy = createRetryPolicy();
+	retryPolicy.setCircuitBreakerEnabled(false);
+	PFCircuitBreaker circuitBreaker;
+	circuitBreaker.setRetryPolicy(retryPolicy);
+	for (int i = 0; i < 10; ++i)
+		circuitBreaker.recordFailure("api.parse.com", 0);
+
+	QCOMPARE(circuitBreaker.stateForHost("api.parse.com", 0), PFCircuitBreaker::Closed);
+	QCOMPARE(circuitBreaker.allowRequest("api.parse.com", 0), true);
+}
+
+DECLARE_TEST(TestPFCircuitBreaker)
+#include "TestPFCircuitBreaker.moc"
@@ -0,0 +1,279 @@
+//
+//  TestPFConversion.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFConversion.h"
+#include "PFDateTime.h"
+#include "PFFile.h"
+#include "PFObject.h"
+#include "TestRunner.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+using namespace parse;
+
+class TestPFConversion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Recursive Conversion Methods
+	void test_convertVariantToJson();
+	void test_convertVariantHashToJson();
+	void test_convertJsonToVariant();
+	void test_roundTrip();
+
+	// Comparison Methods
+	void test_equalityKey();
+	void test_areEqual();
+
+	// Benchmark Methods
+	void test_convertVariantToJsonBenchmark_data();
+	void test_convertVariantToJsonBenchmark();
+	void test_convertJsonToVariantBenchmark_data();
+	void test_convertJsonToVariantBenchmark();
+
+private:
+
+	// Helper Methods
+	static QVariant createDocument(const QString& shape);
+};
+
+QVariant TestPFConversion::createDocument(const QString& shape)
+{
+	if (shape == "flat")
+	{
+		// A single wide object of scalars
+		QVariantMap map;
+		for (int i = 0; i < 1000; ++i)
+		{
+			map[QString("string_%1").arg(i)] = QString("value_%1").arg(i);
+			map[QString("number_%1").arg(i)] = i;
+			map[QString("bool_%1").arg(i)] = (i % 2 == 0);
+		}
+		return map;
+	}
+	else if (shape == "deep")
+	{
+		// A long chain of nested objects
+		QVariantMap map;
+		map["leaf"] = QString("leaf");
+		for (int i = 0; i < 200; ++i)
+		{
+			QVariantMap parentMap;
+			parentMap["child"] = map;
+			parentMap["depth"] = i;
+			map = parentMap;
+		}
+		return map;
+	}
+	else if (shape == "list")
+	{
+		// A long list of small records
+		QVariantList list;
+		for (int i = 0; i < 1000; ++i)
+		{
+			QVariantMap record;
+			record["name"] = QString("record_%1").arg(i);
+			record["score"] = i * 1.5;
+			record["tags"] = QVariantList() << "a" << "b" << "c";
+			list.append(record);
+		}
+		return list;
+	}
+	else // mixed
+	{
+		// Records holding Parse types, hashes and nested lists
+		QVariantList list;
+		PFDateTimePtr dateTime = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+		for (int i = 0; i < 200; ++i)
+		{
+			QVariantHash hash;
+			hash["createdAt"] = PFSerializable::toVariant(dateTime);
+			hash["matrix"] = QVariantList() << QVariant(QVariantList() << 1 << 2) << QVariant(QVariantList() << 3 << 4);
+			hash["title"] = QString("title_%1").arg(i);
+			list.append(hash);
+		}
+		return list;
+	}
+}
+
+void TestPFConversion::test_convertVariantToJson()
+{
+	// Scalars
+	QCOMPARE(PFConversion::convertVariantToJson(QVariant(true)), QJsonValue(true));
+	QCOMPARE(PFConversion::convertVariantToJson(QVariant(42)), QJsonValue(42.0));
+	QCOMPARE(PFConversion::convertVariantToJson(QVariant(1.5)), QJsonValue(1.5));
+	QCOMPARE(PFConversion::convertVariantToJson(QVariant(QString("text"))), QJsonValue(QString("text")));
+	QCOMPARE(PFConversion::convertVariantToJson(QVariant()), QJsonValue());
+
+	// Nested containers
+	QVariantMap map;
+	map["list"] = QVariantList() << 1 << "two" << false;
+	map["map"] = QVariantMap();
+	QJsonObject jsonObject = PFConversion::convertVariantToJson(map).toObject();
+	QCOMPARE(jsonObject.count(), 2);
+	QJsonArray jsonArray = jsonObject["list"].toArray();
+	QCOMPARE(jsonArray.count(), 3);
+	QCOMPARE(jsonArray.at(0), QJsonValue(1.0));
+	QCOMPARE(jsonArray.at(1), QJsonValue(QString("two")));
+	QCOMPARE(jsonArray.at(2), QJsonValue(false));
+	QCOMPARE(jsonObject["map"].isObject(), true);
+
+	// Parse types
+	PFDateTimePtr dateTime = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+	QJsonObject dateObject = PFConversion::convertVariantToJson(PFSerializable::toVariant(dateTime)).toObject();
+	QCOMPARE(dateObject["__type"].toString(), QString("Date"));
+	QCOMPARE(dateObject["iso"].toString(), QString("2013-09-15T09:32:00.123Z"));
+}
+
+void TestPFConversion::test_convertVariantHashToJson()
+{
+	// Hashes used to be silently dropped
+	QVariantHash hash;
+	hash["first"] = 1;
+	hash["second"] = QVariantHash();
+	hash["third"] = QVariantList() << "a";
+	QJsonObject jsonObject = PFConversion::convertVariantToJson(hash).toObject();
+	QCOMPARE(jsonObject.count(), 3);
+	QCOMPARE(jsonObject["first"], QJsonValue(1.0));
+	QCOMPARE(jsonObject["second"].isObject(), true);
+	QCOMPARE(jsonObject["third"].toArray().count(), 1);
+}
+
+void TestPFConversion::test_convertJsonToVariant()
+{
+	QJsonObject fileObject;
+	fileObject["__type"] = QString("File");
+	fileObject["name"] = QString("1234-file.txt");
+	fileObject["url"] = QString("http://files.parse.com/app/1234-file.txt");
+
+	QJsonObject jsonObject;
+	jsonObject["number"] = 3.0;
+	jsonObject["list"] = QJsonArray() << QJsonValue(QString("a")) << QJsonValue(true);
+	jsonObject["file"] = fileObject;
+
+	QVariantMap map = PFConversion::convertJsonToVariant(jsonObject).toMap();
+	QCOMPARE(map.count(), 3);
+	QCOMPARE(map["number"].toDouble(), 3.0);
+	QCOMPARE(map["list"].toList().count(), 2);
+	QCOMPARE(map["list"].toList().at(0).toString(), QString("a"));
+	QCOMPARE(map["list"].toList().at(1).toBool(), true);
+	PFFilePtr file = PFFile::fileFromVariant(map["file"]);
+	QCOMPARE(file.isNull(), false);
+	QCOMPARE(file->name(), QString("1234-file.txt"));
+
+	// Unknown Parse types convert to an invalid variant
+	QJsonObject unknownObject;
+	unknownObject["__type"] = QString("Unknown");
+	QCOMPARE(PFConversion::convertJsonToVariant(unknownObject).isValid(), false);
+}
+
+void TestPFConversion::test_roundTrip()
+{
+	// Every document shape should survive a trip through json
+	QStringList shapes = QStringList() << "flat" << "deep" << "list";
+	foreach (const QString& shape, shapes)
+	{
+		QVariant document = createDocument(shape);
+		QJsonValue jsonValue = PFConversion::convertVariantToJson(document);
+		QCOMPARE(PFConversion::convertVariantToJson(PFConversion::convertJsonToVariant(jsonValue)), jsonValue);
+	}
+}
+
+void TestPFConversion::test_equalityKey()
+{
+	// Scalars are tagged with their type
+	QCOMPARE(PFConversion::equalityKey(QVariant()), QString("Null"));
+	QCOMPARE(PFConversion::equalityKey(QVariant(true)), QString("Bool:true"));
+	QCOMPARE(PFConversion::equalityKey(QVariant(1)), PFConversion::equalityKey(QVariant(1.0)));
+	QVERIFY(PFConversion::equalityKey(QVariant(1)) != PFConversion::equalityKey(QVariant(QString("1"))));
+	QVERIFY(PFConversion::equalityKey(QVariant(true)) != PFConversion::equalityKey(QVariant(QString("true"))));
+
+	// Parse types are keyed by what identifies them in the cloud
+	PFDateTimePtr dateTime = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+	QCOMPARE(PFConversion::equalityKey(PFSerializable::toVariant(dateTime)), QString("Date:2013-09-15T09:32:00.123Z"));
+	PFObjectPtr object = PFObject::objectWithClassName("Game", "1234");
+	QCOMPARE(PFConversion::equalityKey(PFObject::toVariant(object)), QString("Pointer:Game:1234"));
+	PFFilePtr file = PFFile::fileWithNameAndUrl("1234-file.txt", "http://files.parse.com/app/1234-file.txt");
+	QCOMPARE(PFConversion::equalityKey(PFFile::toVariant(file)), QString("File:1234-file.txt:http://files.parse.com/app/1234-file.txt"));
+
+	// Unsaved objects only match themselves
+	PFObjectPtr unsaved1 = PFObject::objectWithClassName("Game");
+	PFObjectPtr unsaved2 = PFObject::objectWithClassName("Game");
+	QCOMPARE(PFConversion::equalityKey(PFObject::toVariant(unsaved1)), PFConversion::equalityKey(PFObject::toVariant(unsaved1)));
+	QVERIFY(PFConversion::equalityKey(PFObject::toVariant(unsaved1)) != PFConversion::equalityKey(PFObject::toVariant(unsaved2)));
+
+	// Containers compare by value
+	QVariantMap map1, map2;
+	map1["a"] = 1;
+	map2["a"] = 1.0;
+	QCOMPARE(PFConversion::equalityKey(map1), PFConversion::equalityKey(map2));
+}
+
+void TestPFConversion::test_areEqual()
+{
+	QCOMPARE(PFConversion::areEqual(QVariant(1), QVariant(1)), true);
+	QCOMPARE(PFConversion::areEqual(QVariant(1), QVariant(2)), false);
+	QCOMPARE(PFConversion::areEqual(QVariant(1), QVariant(QString("1"))), false);
+	QCOMPARE(PFConversion::areEqual(QVariant(true), QVariant(QString("true"))), false);
+
+	PFDateTimePtr dateTime1 = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+	PFDateTimePtr dateTime2 = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+	PFDateTimePtr dateTime3 = PFDateTime::dateTimeFromParseString("2014-09-15T09:32:00.123Z");
+	QCOMPARE(PFConversion::areEqual(PFSerializable::toVariant(dateTime1), PFSerializable::toVariant(dateTime2)), true);
+	QCOMPARE(PFConversion::areEqual(PFSerializable::toVariant(dateTime1), PFSerializable::toVariant(dateTime3)), false);
+}
+
+void TestPFConversion::test_convertVariantToJsonBenchmark_data()
+{
+	QTest::addColumn<QVariant>("document");
+	QTest::newRow("flat") << createDocument("flat");
+	QTest::newRow("deep") << createDocument("deep");
+	QTest::newRow("list") << createDocument("list");
+	QTest::newRow("mixed") << createDocument("mixed");
+}
+
+void TestPFConversion::test_convertVariantToJsonBenchmark()
+{
+	QFETCH(QVariant, document);
+	QBENCHMARK
+	{
+		PFConversion::convertVariantToJson(document);
+	}
+}
+
+void TestPFConversion::test_convertJsonToVariantBenchmark_data()
+{
+	QTest::addColumn<QJsonValue>("jsonValue");
+	QTest::newRow("flat") << PFConversion::convertVariantToJson(createDocument("flat"));
+	QTest::newRow("deep") << PFConversion::convertVariantToJson(createDocument("deep"));
+	QTest::newRow("list") << PFConversion::convertVariantToJson(createDocument("list"));
+	QTest::newRow("mixed") << PFConversion::convertVariantToJson(createDocument("mixed"));
+}
+
+void TestPFConversion::test_convertJsonToVariantBenchmark()
+{
+	QFETCH(QJsonValue, jsonValue);
+	QBENCHMARK
+	{
+		PFConversion::convertJsonToVariant(jsonValue);
+	}
+}
+
+DECLARE_TEST(TestPFConversion)
+#include "TestPFConversion.moc"
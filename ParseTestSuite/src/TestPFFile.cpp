@@ -6,11 +6,20 @@
 //  Copyright (c) 2013 Christian Noon. All rights reserved.
 //
 
+#include "PFError.h"
 #include "PFFile.h"
+#include "PFFileCache.h"
 #include "PFManager.h"
 #include "PFObject.h"
+#include "PFTransferManager.h"
 #include "TestRunner.h"
 
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QThreadPool>
+#include <QUuid>
+
 using namespace parse;
 
 class TestPFFile : public QObject
@@ -49,6 +58,13 @@ public slots:
 		emit getDataEnded();
 	}
 
+	void getDataPathCompleted(QString filepath, PFErrorPtr error)
+	{
+		_getDataFilepath = filepath;
+		_getDataError = error;
+		emit getDataEnded();
+	}
+
 	void deleteCompleted(bool succeeded, PFErrorPtr error)
 	{
 		_deleteSucceeded = succeeded;
@@ -137,6 +153,7 @@ private slots:
 	void test_fileWithNameAndContentsAtPath();
 	void test_fileFromVariant();
 	void test_fileWithNameAndUrl();
+	void test_creationBenchmark();
 
 	// Getter Methods
 	void test_filepath();
@@ -147,6 +164,8 @@ private slots:
 	// Save Methods
 	void test_save();
 	void test_saveWithError();
+	void test_saveFromPath();
+	void test_saveDeduplicated();
 	void test_saveInBackground();
 	void test_saveInBackgroundWithProgress();
 
@@ -159,6 +178,9 @@ private slots:
 	void test_getData();
 	void test_getDataInBackground();
 	void test_getDataInBackgroundWithProgress();
+	void test_getDataPathInBackground();
+	void test_resumeDownload();
+	void test_revalidateDataInBackground();
 
 	// Delete Methods
 	void test_delete();
@@ -167,6 +189,7 @@ private slots:
 
 	// Cancellation Methods
 	void test_cancel();
+	void test_concurrentTransfers();
 
 	// PFSerializable Methods
 	void test_fromJson();
@@ -189,6 +212,7 @@ private:
 	bool			_checkUrlForFileSucceeded;
 	bool			_getDataSucceeded;
 	PFErrorPtr		_getDataError;
+	QString			_getDataFilepath;
 	bool			_deleteSucceeded;
 	PFErrorPtr		_deleteError;
 };
@@ -313,6 +337,22 @@ void TestPFFile::test_filepath()
 	QCOMPARE(_nameUrlFile->filepath(), QString(""));
 }
 
+void TestPFFile::test_creationBenchmark()
+{
+	// Measures the creation throughput of an import sized batch of files (the mime type lookups dominate)
+	QByteArrayPtr imageData = QByteArrayPtr(new QByteArray(QByteArray::fromHex("89504e470d0a1a0a") + QByteArray(1024 * 1024, '\0')));
+	QString imagePath = QDir(_dataPath).absoluteFilePath("small_image.jpg");
+	QBENCHMARK
+	{
+		for (int i = 0; i < 1000; ++i)
+		{
+			PFFile::fileWithData(imageData);
+			PFFile::fileWithNameAndData("image.png", imageData);
+			PFFile::fileWithNameAndContentsAtPath("small_image.jpg", imagePath);
+		}
+	}
+}
+
 void TestPFFile::test_name()
 {
 	QCOMPARE(_dataFile->name(), QString("parse_file-no_name.txt"));
@@ -381,6 +421,77 @@ void TestPFFile::test_saveWithError()
 	QCOMPARE(error, PFErrorPtr());
 }
 
+void TestPFFile::test_saveFromPath()
+{
+	// Save the zip file straight from disk without ever loading it into memory
+	QString filename = "archive_file.zip";
+	QString filepath = QDir(_dataPath).absoluteFilePath(filename);
+	PFFilePtr zipFile = PFFile::fileWithNameAndContentsAtPath(filename, filepath);
+	QCOMPARE(zipFile->save(), true);
+	QCOMPARE(zipFile->url().isEmpty(), false);
+
+	// Pull it back out of the cloud and make sure the streamed upload matches the file on disk
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(zipFile->name(), zipFile->url());
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(getDataEnded()), &eventLoop, SLOT(quit()));
+	QCOMPARE(cloudFile->getDataInBackground(this, SLOT(getDataCompleted(QByteArray*, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataSucceeded, true);
+	QFile expectedFile(filepath);
+	expectedFile.open(QIODevice::ReadOnly);
+	QCOMPARE(*(cloudFile->getData()), expectedFile.readAll());
+	expectedFile.close();
+	QCOMPARE(zipFile->deleteFile(), true);
+
+	// Invalid Case - the file was removed from disk before the upload started
+	QString tempFilepath = QDir(_dataPath).absoluteFilePath("temp_plain_text.txt");
+	QFile::copy(QDir(_dataPath).absoluteFilePath("plain_text.txt"), tempFilepath);
+	PFFilePtr removedFile = PFFile::fileWithNameAndContentsAtPath("temp_plain_text.txt", tempFilepath);
+	QCOMPARE(removedFile.isNull(), false);
+	QFile::remove(tempFilepath);
+	PFErrorPtr error;
+	QCOMPARE(removedFile->save(error), false);
+	QCOMPARE(error->errorCode(), kPFErrorFileUploadReadFailed);
+}
+
+void TestPFFile::test_saveDeduplicated()
+{
+	// Upload some contents that have never been uploaded before
+	QByteArrayPtr data = QByteArrayPtr(new QByteArray(QUuid::createUuid().toByteArray()));
+	PFFilePtr firstFile = PFFile::fileWithNameAndData("dedup.txt", data);
+	QCOMPARE(firstFile->save(), true);
+	QCOMPARE(firstFile->url().isEmpty(), false);
+
+	// Saving the same contents again should hand back the first upload without a POST
+	PFFilePtr secondFile = PFFile::fileWithNameAndData("dedup_copy.txt", QByteArrayPtr(new QByteArray(*data)));
+	QCOMPARE(secondFile->save(), true);
+	QCOMPARE(secondFile->isDirty(), false);
+	QCOMPARE(secondFile->name(), firstFile->name());
+	QCOMPARE(secondFile->url(), firstFile->url());
+
+	// The same goes for background saves
+	PFFilePtr thirdFile = PFFile::fileWithNameAndData("dedup_copy.txt", QByteArrayPtr(new QByteArray(*data)));
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(saveEnded()), &eventLoop, SLOT(quit()));
+	QCOMPARE(thirdFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_saveSucceeded, true);
+	QCOMPARE(thirdFile->url(), firstFile->url());
+
+	// Different contents still get uploaded
+	PFFilePtr otherFile = PFFile::fileWithNameAndData("dedup.txt", QByteArrayPtr(new QByteArray(QUuid::createUuid().toByteArray())));
+	QCOMPARE(otherFile->save(), true);
+	QCOMPARE(otherFile->url() == firstFile->url(), false);
+
+	// Once deleted, the upload can't be reused anymore
+	QCOMPARE(firstFile->deleteFile(), true);
+	PFFilePtr fourthFile = PFFile::fileWithNameAndData("dedup.txt", QByteArrayPtr(new QByteArray(*data)));
+	QCOMPARE(fourthFile->save(), true);
+	QCOMPARE(fourthFile->url() == firstFile->url(), false);
+	QCOMPARE(fourthFile->deleteFile(), true);
+	QCOMPARE(otherFile->deleteFile(), true);
+}
+
 void TestPFFile::test_saveInBackground()
 {
 	// Use an event loop to block until we receive the completion
@@ -530,6 +641,16 @@ void TestPFFile::test_isDataAvailable()
 	QCOMPARE(_nameContentsFile->isDataAvailable(), true);
 	QCOMPARE(_nameUrlFile->isDataAvailable(), false);
 
+	// Source files removed from disk are no longer available
+	QString tempFilepath = QDir(_dataPath).absoluteFilePath("temp_available.txt");
+	QFile::copy(QDir(_dataPath).absoluteFilePath("plain_text.txt"), tempFilepath);
+	PFFilePtr removedFile = PFFile::fileWithNameAndContentsAtPath("temp_available.txt", tempFilepath);
+	QCOMPARE(removedFile->isDataAvailable(), true);
+	QCOMPARE(removedFile->dataFilepath(), tempFilepath);
+	QFile::remove(tempFilepath);
+	QCOMPARE(removedFile->isDataAvailable(), false);
+	QCOMPARE(removedFile->dataFilepath().isEmpty(), true);
+
 	// Put the data file in the cloud
 	bool saved = _dataFile->save();
 	QCOMPARE(saved, true);
@@ -604,6 +725,19 @@ void TestPFFile::test_getDataInBackground()
 	QObject::connect(this, SIGNAL(getDataEnded()), &eventLoop, SLOT(quit()));
 	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
 	QCOMPARE(cloudFile->getData() != NULL, true);
+
+	// Invalid Case - the download can't be moved into the cache, which is a cache error rather than a network one
+	QString cacheKey = PFFileCache::keyForUrl(zipFile->url());
+	QString cacheFilepath = PFManager::sharedManager()->fileCache()->filepathForKey(cacheKey);
+	PFManager::sharedManager()->fileCache()->remove(cacheKey);
+	QDir().mkpath(cacheFilepath);
+	PFFilePtr blockedFile = PFFile::fileWithNameAndUrl(zipFile->name(), zipFile->url());
+	QCOMPARE(blockedFile->getDataInBackground(this, SLOT(getDataCompleted(QByteArray*, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataSucceeded, false);
+	QCOMPARE(_getDataError.isNull(), false);
+	QCOMPARE(_getDataError->errorCode(), kPFErrorFileCacheWriteFailed);
+	QDir(cacheFilepath).removeRecursively();
 }
 
 void TestPFFile::test_getDataInBackgroundWithProgress()
@@ -634,6 +768,144 @@ void TestPFFile::test_getDataInBackgroundWithProgress()
 	QCOMPARE(cloudFile->getData() != NULL, true);
 }
 
+void TestPFFile::test_getDataPathInBackground()
+{
+	// Test the files where the data is already on disk
+	QCOMPARE(_nameDataFile->getDataPathInBackground(NULL, ""), false);
+	QCOMPARE(_nameContentsFile->getDataPathInBackground(NULL, ""), false);
+	QCOMPARE(_nameContentsFile->dataFilepath(), QDir(_dataPath).absoluteFilePath("plain_text.txt"));
+
+	// Put the test zip file in the cloud
+	QString filename = "archive_file.zip";
+	QString filepath = QDir(_dataPath).absoluteFilePath(filename);
+	PFFilePtr zipFile = PFFile::fileWithNameAndContentsAtPath(filename, filepath);
+	QCOMPARE(zipFile->save(), true);
+
+	// Download it to the cache and make sure only the path comes back
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(zipFile->name(), zipFile->url());
+	QCOMPARE(cloudFile->dataFilepath(), QString(""));
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(getDataEnded()), &eventLoop, SLOT(quit()));
+	_getDataFilepath = QString();
+	_getDataError = PFErrorPtr();
+	QCOMPARE(cloudFile->getDataPathInBackground(this, SLOT(getDataPathCompleted(QString, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataError.isNull(), true);
+	QCOMPARE(_getDataFilepath.isEmpty(), false);
+	QCOMPARE(_getDataFilepath, cloudFile->dataFilepath());
+
+	// The cached file should match the original byte for byte
+	QFile expectedFile(filepath);
+	expectedFile.open(QIODevice::ReadOnly);
+	QFile cachedFile(_getDataFilepath);
+	cachedFile.open(QIODevice::ReadOnly);
+	QByteArray expectedData = expectedFile.readAll();
+	QCOMPARE(cachedFile.readAll(), expectedData);
+
+	// Getting the data out of the cache maps the file rather than copying it
+	QByteArray* data = cloudFile->getData();
+	QCOMPARE(data != NULL, true);
+	QCOMPARE(*data, expectedData);
+	QCOMPARE(cloudFile->isDataMapped(), true);
+
+	// The shared data points into the same mapping and keeps it alive after the file is gone
+	QByteArrayPtr sharedData = cloudFile->getSharedData();
+	QCOMPARE(sharedData.isNull(), false);
+	QCOMPARE(sharedData->constData() == data->constData(), true);
+	QPointer<PFFile> destroyedFile = cloudFile.data();
+	cloudFile = PFFilePtr();
+	QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+	QCOMPARE(destroyedFile.isNull(), true);
+	QCOMPARE(*sharedData, expectedData);
+
+	// Source files are read rather than mapped
+	QCOMPARE(_nameContentsFile->getData() != NULL, true);
+	QCOMPARE(_nameContentsFile->isDataMapped(), false);
+}
+
+void TestPFFile::test_resumeDownload()
+{
+	// Put the test zip file in the cloud
+	QString filename = "archive_file.zip";
+	QString filepath = QDir(_dataPath).absoluteFilePath(filename);
+	PFFilePtr zipFile = PFFile::fileWithNameAndContentsAtPath(filename, filepath);
+	QCOMPARE(zipFile->save(), true);
+	QFile expectedFile(filepath);
+	expectedFile.open(QIODevice::ReadOnly);
+	QByteArray expectedData = expectedFile.readAll();
+
+	// The upload may have been deduplicated against an earlier test, so drop any copy that's already cached
+	QString cacheKey = PFFileCache::keyForUrl(zipFile->url());
+	PFManager::sharedManager()->fileCache()->remove(cacheKey);
+	QThreadPool::globalInstance()->waitForDone();
+
+	// Leave the first half of the file behind as if an earlier download had been interrupted. The validator
+	// is stale so the server can either resume or send the whole file back, both have to end up correct.
+	QString partialFilepath = PFManager::sharedManager()->fileCache()->filepathForKey(cacheKey) + ".partial";
+	QFile partialFile(partialFilepath);
+	partialFile.open(QIODevice::WriteOnly);
+	partialFile.write(expectedData.left(expectedData.size() / 2));
+	partialFile.close();
+	QFile validatorsFile(partialFilepath + ".json");
+	validatorsFile.open(QIODevice::WriteOnly);
+	QJsonObject validatorsObject;
+	validatorsObject["url"] = zipFile->url();
+	validatorsObject["etag"] = QString("\"stale\"");
+	validatorsFile.write(QJsonDocument(validatorsObject).toJson());
+	validatorsFile.close();
+
+	// Download it and make sure the partial file was moved into the cache
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(zipFile->name(), zipFile->url());
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(getDataEnded()), &eventLoop, SLOT(quit()));
+	_getDataFilepath = QString();
+	_getDataError = PFErrorPtr();
+	QCOMPARE(cloudFile->getDataPathInBackground(this, SLOT(getDataPathCompleted(QString, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataError.isNull(), true);
+	QCOMPARE(QFileInfo(partialFilepath).exists(), false);
+	QCOMPARE(QFileInfo(partialFilepath + ".json").exists(), false);
+
+	// The cached file should match the original byte for byte
+	QFile cachedFile(_getDataFilepath);
+	cachedFile.open(QIODevice::ReadOnly);
+	QCOMPARE(cachedFile.readAll(), expectedData);
+}
+
+void TestPFFile::test_revalidateDataInBackground()
+{
+	// Put some new contents in the cloud and download them into the cache
+	QByteArrayPtr data = QByteArrayPtr(new QByteArray(QUuid::createUuid().toByteArray()));
+	PFFilePtr uploadFile = PFFile::fileWithNameAndData("revalidate.txt", data);
+	QCOMPARE(uploadFile->save(), true);
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(uploadFile->name(), uploadFile->url());
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(getDataEnded()), &eventLoop, SLOT(quit()));
+	QCOMPARE(cloudFile->getDataPathInBackground(this, SLOT(getDataPathCompleted(QString, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataError.isNull(), true);
+
+	// The cache entry should have picked up the validators from the response
+	QString etag;
+	QString lastModified;
+	QString cacheKey = PFFileCache::keyForUrl(cloudFile->url());
+	QCOMPARE(PFManager::sharedManager()->fileCache()->validatorsForKey(cacheKey, etag, lastModified), true);
+
+	// Revalidating an unchanged file should hand back the same cached file
+	_getDataFilepath = QString();
+	_getDataError = PFErrorPtr();
+	QCOMPARE(cloudFile->revalidateDataInBackground(this, SLOT(getDataPathCompleted(QString, PFErrorPtr))), true);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_getDataError.isNull(), true);
+	QCOMPARE(_getDataFilepath, cloudFile->dataFilepath());
+	QCOMPARE(*(cloudFile->getData()), *data);
+
+	// Checking the url doubles as a revalidation and keeps the unchanged file cached
+	QCOMPARE(cloudFile->checkUrlForFile(), true);
+	QCOMPARE(cloudFile->isDataAvailable(), true);
+	QCOMPARE(uploadFile->deleteFile(), true);
+}
+
 void TestPFFile::test_delete()
 {
 	// Create a couple different files
@@ -739,6 +1011,39 @@ void TestPFFile::test_cancel()
 	cloudFile->cancel();
 }
 
+void TestPFFile::test_concurrentTransfers()
+{
+	// Queue up the upload of a copy of the plain text file, then move the copy out from under it so the data
+	// has to be downloaded again
+	QString filepath = QDir::temp().absoluteFilePath("TestPFFile-concurrent.txt");
+	QFile::remove(filepath);
+	QFile::copy(QDir(_dataPath).absoluteFilePath("plain_text.txt"), filepath);
+	PFFilePtr file = PFFile::fileWithNameAndContentsAtPath("plain_text.txt", filepath);
+	PFTransferManager* transferManager = PFTransferManager::sharedManager();
+	int transferCount = transferManager->queuedCount() + transferManager->activeCount();
+	QCOMPARE(file->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr))), true);
+	QFile::remove(filepath);
+	QCOMPARE(file->isDataAvailable(), false);
+
+	// A file only runs one transfer at a time, so the downloads are rejected while the save is queued
+	QCOMPARE(file->getDataInBackground(this, SLOT(getDataCompleted(QByteArray*, PFErrorPtr))), false);
+	QCOMPARE(file->getDataPathInBackground(), false);
+	QCOMPARE(file->revalidateDataInBackground(), false);
+	QCOMPARE(transferManager->queuedCount() + transferManager->activeCount(), transferCount + 1);
+
+	// Cancelling the save cleans up after it and leaves nothing behind in the queue
+	file->cancel();
+	QCOMPARE(transferManager->queuedCount() + transferManager->activeCount(), transferCount);
+
+	// Files being downloaded can't be saved either (they only get here once they've already been saved)
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(_nameUrlFile->name(), _nameUrlFile->url());
+	QCOMPARE(cloudFile->getDataInBackground(), true);
+	QCOMPARE(cloudFile->saveInBackground(), false);
+	QCOMPARE(cloudFile->save(), false);
+	cloudFile->cancel();
+	QCOMPARE(transferManager->queuedCount() + transferManager->activeCount(), transferCount);
+}
+
 void TestPFFile::test_fromJson()
 {
 	// Convert the name url file to json
@@ -0,0 +1,249 @@
+//
+//  TestPFFileCache.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFFileCache.h"
+#include "TestRunner.h"
+
+#include <QThreadPool>
+
+using namespace parse;
+
+class TestPFFileCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		_directory = QDir::temp();
+		_directory.mkdir("TestPFFileCache");
+		_directory.cd("TestPFFileCache");
+	}
+
+	void cleanupTestCase()
+	{
+		QThreadPool::globalInstance()->waitForDone();
+		_directory.removeRecursively();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		_fileCache = PFFileCache::fileCacheWithDirectory(_directory);
+	}
+
+	void cleanup()
+	{
+		_fileCache->clear();
+		_fileCache->saveIndex();
+		_fileCache = PFFileCachePtr();
+		QThreadPool::globalInstance()->waitForDone();
+	}
+
+	// Creation Methods
+	void test_fileCacheWithDirectory();
+	void test_keyForUrl();
+
+	// Entry Methods
+	void test_insert();
+	void test_remove();
+	void test_validatorsForKey();
+
+	// Size Methods
+	void test_evict();
+	void test_removeStalePartialDownloads();
+
+	// Index Methods
+	void test_saveIndex();
+	void test_isIndexLoaded();
+
+private:
+
+	// Helper Methods
+	QString addEntry(const QString& url, int size)
+	{
+		QString key = PFFileCache::keyForUrl(url);
+		QFile file(_fileCache->filepathForKey(key));
+		file.open(QIODevice::WriteOnly);
+		file.write(QByteArray(size, 'x'));
+		file.close();
+		_fileCache->insert(key, size);
+		return key;
+	}
+
+	// Instance members
+	QDir			_directory;
+	PFFileCachePtr	_fileCache;
+};
+
+void TestPFFileCache::test_fileCacheWithDirectory()
+{
+	QCOMPARE(_fileCache.isNull(), false);
+	QCOMPARE(_fileCache->count(), 0);
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(0));
+	QCOMPARE(_fileCache->maximumSize(), Q_INT64_C(256 * 1024 * 1024));
+}
+
+void TestPFFileCache::test_keyForUrl()
+{
+	// Files with the same name but different urls should never collide
+	QString key1 = PFFileCache::keyForUrl("http://files.parse.com/app/1234-image.png");
+	QString key2 = PFFileCache::keyForUrl("http://files.parse.com/app/5678-image.png");
+	QCOMPARE(key1 == key2, false);
+	QCOMPARE(key1, PFFileCache::keyForUrl("http://files.parse.com/app/1234-image.png"));
+	QCOMPARE(key1.length(), 40);
+}
+
+void TestPFFileCache::test_insert()
+{
+	QString key = addEntry("http://files.parse.com/app/insert.txt", 10);
+	QCOMPARE(_fileCache->contains(key), true);
+	QCOMPARE(_fileCache->count(), 1);
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(10));
+
+	// Replacing an entry shouldn't count it twice
+	_fileCache->insert(key, 20);
+	QCOMPARE(_fileCache->count(), 1);
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(20));
+}
+
+void TestPFFileCache::test_remove()
+{
+	QString key = addEntry("http://files.parse.com/app/remove.txt", 10);
+	_fileCache->remove(key);
+	QCOMPARE(_fileCache->contains(key), false);
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(0));
+
+	// The file gets deleted in the background
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(QFileInfo(_fileCache->filepathForKey(key)).exists(), false);
+
+	// Writing the key again before the background deletion runs shouldn't lose the new file
+	QString thumbnailDirectory = _fileCache->thumbnailDirectoryForKey(key);
+	addEntry("http://files.parse.com/app/remove.txt", 10);
+	QDir().mkpath(thumbnailDirectory);
+	_fileCache->remove(key);
+	addEntry("http://files.parse.com/app/remove.txt", 20);
+	QDir().mkpath(thumbnailDirectory);
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(QFileInfo(_fileCache->filepathForKey(key)).size(), Q_INT64_C(20));
+	QCOMPARE(QFileInfo(thumbnailDirectory).isDir(), true);
+	QCOMPARE(_directory.entryList(QStringList() << "*.deleted-*", QDir::Files).isEmpty(), true);
+}
+
+void TestPFFileCache::test_validatorsForKey()
+{
+	// Entries without validators can't be revalidated
+	QString etag;
+	QString lastModified;
+	QString key = addEntry("http://files.parse.com/app/validators.txt", 10);
+	QCOMPARE(_fileCache->validatorsForKey(key, etag, lastModified), false);
+
+	// The validators should survive an index reload
+	_fileCache->insert(key, 10, "\"1234\"", "Fri, 10 Jan 2014 12:00:00 GMT");
+	QCOMPARE(_fileCache->validatorsForKey(key, etag, lastModified), true);
+	QCOMPARE(etag, QString("\"1234\""));
+	QCOMPARE(lastModified, QString("Fri, 10 Jan 2014 12:00:00 GMT"));
+	_fileCache->saveIndex();
+
+	PFFileCachePtr reloadedCache = PFFileCache::fileCacheWithDirectory(_directory);
+	etag.clear();
+	lastModified.clear();
+	QCOMPARE(reloadedCache->validatorsForKey(key, etag, lastModified), true);
+	QCOMPARE(etag, QString("\"1234\""));
+	QCOMPARE(lastModified, QString("Fri, 10 Jan 2014 12:00:00 GMT"));
+}
+
+void TestPFFileCache::test_evict()
+{
+	_fileCache->setMaximumSize(100);
+	QString key1 = addEntry("http://files.parse.com/app/evict1.txt", 40);
+	QString key2 = addEntry("http://files.parse.com/app/evict2.txt", 40);
+
+	// Use the first entry so the second one becomes the least recently used
+	_fileCache->touch(key1);
+	QString key3 = addEntry("http://files.parse.com/app/evict3.txt", 40);
+
+	// Eviction happens once we get back to the event loop
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(120));
+	QTest::qWait(10);
+	QCOMPARE(_fileCache->totalSize(), Q_INT64_C(80));
+	QCOMPARE(_fileCache->contains(key1), true);
+	QCOMPARE(_fileCache->contains(key2), false);
+	QCOMPARE(_fileCache->contains(key3), true);
+
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(QFileInfo(_fileCache->filepathForKey(key2)).exists(), false);
+}
+
+void TestPFFileCache::test_removeStalePartialDownloads()
+{
+	// Leave a partial download behind along with its validators
+	QString key = PFFileCache::keyForUrl("http://files.parse.com/app/partial.txt");
+	QString partialFilepath = _fileCache->filepathForKey(key) + ".partial";
+	QFile partialFile(partialFilepath);
+	partialFile.open(QIODevice::WriteOnly);
+	partialFile.write(QByteArray(10, 'x'));
+	partialFile.close();
+	QFile validatorsFile(partialFilepath + ".json");
+	validatorsFile.open(QIODevice::WriteOnly);
+	validatorsFile.write("{\"etag\":\"1234\"}");
+	validatorsFile.close();
+	QString entryKey = addEntry("http://files.parse.com/app/complete.txt", 10);
+
+	// Recent downloads are kept around to be resumed
+	_fileCache->removeStalePartialDownloads(24 * 60 * 60 * 1000);
+	QCOMPARE(QFileInfo(partialFilepath).exists(), true);
+	QCOMPARE(QFileInfo(partialFilepath + ".json").exists(), true);
+
+	// Stale ones go along with their validators, without touching the entries
+	_fileCache->removeStalePartialDownloads(0);
+	QCOMPARE(QFileInfo(partialFilepath).exists(), false);
+	QCOMPARE(QFileInfo(partialFilepath + ".json").exists(), false);
+	QCOMPARE(_fileCache->contains(entryKey), true);
+	QCOMPARE(QFileInfo(_fileCache->filepathForKey(entryKey)).exists(), true);
+
+	// Clearing the cache removes the partial downloads no matter how old they are
+	partialFile.open(QIODevice::WriteOnly);
+	partialFile.write(QByteArray(10, 'x'));
+	partialFile.close();
+	_fileCache->clear();
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(QFileInfo(partialFilepath).exists(), false);
+}
+
+void TestPFFileCache::test_saveIndex()
+{
+	QString key1 = addEntry("http://files.parse.com/app/index1.txt", 10);
+	QString key2 = addEntry("http://files.parse.com/app/index2.txt", 20);
+	_fileCache->saveIndex();
+
+	// A new cache on the same directory should pick the entries back up
+	PFFileCachePtr reloadedCache = PFFileCache::fileCacheWithDirectory(_directory);
+	QCOMPARE(reloadedCache->count(), 2);
+	QCOMPARE(reloadedCache->contains(key1), true);
+	QCOMPARE(reloadedCache->contains(key2), true);
+	QCOMPARE(reloadedCache->totalSize(), Q_INT64_C(30));
+}
+
+void TestPFFileCache::test_isIndexLoaded()
+{
+	addEntry("http://files.parse.com/app/loaded.txt", 10);
+	_fileCache->saveIndex();
+
+	// The index gets loaded in the background
+	PFFileCachePtr reloadedCache = PFFileCache::fileCacheWithDirectory(_directory);
+	QThreadPool::globalInstance()->waitForDone();
+	QCOMPARE(reloadedCache->isIndexLoaded(), true);
+	QCOMPARE(reloadedCache->count(), 1);
+}
+
+DECLARE_TEST(TestPFFileCache)
+#include "TestPFFileCache.moc"
@@ -0,0 +1,167 @@
+//
+//  TestPFHistogram.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFHistogram.h"
+#include "TestRunner.h"
+
+using namespace parse;
+
+class TestPFHistogram : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Bucket Methods
+	void test_bucketBoundaries();
+
+	// Recording Methods
+	void test_emptyHistogram();
+	void test_record();
+	void test_recordOutOfRange();
+	void test_merge();
+	void test_reset();
+
+	// Statistics Methods
+	void test_valueAtPercentile();
+
+	// Benchmark Methods
+	void test_recordBenchmark();
+};
+
+void TestPFHistogram::test_bucketBoundaries()
+{
+	// Every value lands in a bucket that covers it and the buckets cover the range without gaps
+	for (qint64 value = 0; value < 100000; ++value)
+	{
+		int index = PFHistogram::bucketIndexForValue(value);
+		QVERIFY(PFHistogram::lowestValueForBucket(index) <= value);
+		QVERIFY(PFHistogram::highestValueForBucket(index) >= value);
+	}
+	for (int i = 0; i < PFHistogram::bucketCount() - 1; ++i)
+		QCOMPARE(PFHistogram::highestValueForBucket(i) + 1, PFHistogram::lowestValueForBucket(i + 1));
+
+	// The last bucket ends at the largest trackable value
+	int lastIndex = PFHistogram::bucketCount() - 1;
+	QCOMPARE(PFHistogram::bucketIndexForValue(PFHistogram::maximumTrackableValue()), lastIndex);
+	QCOMPARE(PFHistogram::highestValueForBucket(lastIndex), PFHistogram::maximumTrackableValue());
+
+	// Buckets stay within about 3% of their values
+	for (int i = 64; i < PFHistogram::bucketCount(); ++i)
+	{
+		qint64 lowest = PFHistogram::lowestValueForBucket(i);
+		qint64 width = PFHistogram::highestValueForBucket(i) - lowest + 1;
+		QVERIFY(width * 32 <= lowest);
+	}
+}
+
+void TestPFHistogram::test_emptyHistogram()
+{
+	PFHistogram histogram;
+	QCOMPARE(histogram.count(), Q_INT64_C(0));
+	QCOMPARE(histogram.minimum(), Q_INT64_C(0));
+	QCOMPARE(histogram.maximum(), Q_INT64_C(0));
+	QCOMPARE(histogram.mean(), 0.0);
+	QCOMPARE(histogram.valueAtPercentile(50.0), Q_INT64_C(0));
+}
+
+void TestPFHistogram::test_record()
+{
+	PFHistogram histogram;
+	histogram.record(10);
+	histogram.record(20);
+	histogram.record(30);
+	QCOMPARE(histogram.count(), Q_INT64_C(3));
+	QCOMPARE(histogram.minimum(), Q_INT64_C(10));
+	QCOMPARE(histogram.maximum(), Q_INT64_C(30));
+	QCOMPARE(histogram.mean(), 20.0);
+}
+
+void TestPFHistogram::test_recordOutOfRange()
+{
+	PFHistogram histogram;
+	histogram.record(-5);
+	histogram.record(PFHistogram::maximumTrackableValue() * 2);
+	QCOMPARE(histogram.count(), Q_INT64_C(2));
+	QCOMPARE(histogram.minimum(), Q_INT64_C(0));
+	QCOMPARE(histogram.maximum(), PFHistogram::maximumTrackableValue());
+}
+
+void TestPFHistogram::test_merge()
+{
+	PFHistogram histogram1;
+	histogram1.record(100);
+	PFHistogram histogram2;
+	histogram2.record(5);
+	histogram2.record(1000);
+
+	histogram1.merge(histogram2);
+	QCOMPARE(histogram1.count(), Q_INT64_C(3));
+	QCOMPARE(histogram1.minimum(), Q_INT64_C(5));
+	QCOMPARE(histogram1.maximum(), Q_INT64_C(1000));
+
+	// Merging into an empty histogram copies it
+	PFHistogram histogram3;
+	histogram3.merge(histogram2);
+	QCOMPARE(histogram3.count(), Q_INT64_C(2));
+	QCOMPARE(histogram3.valueAtPercentile(100.0), Q_INT64_C(1000));
+}
+
+void TestPFHistogram::test_reset()
+{
+	PFHistogram histogram;
+	histogram.record(42);
+	histogram.reset();
+	QCOMPARE(histogram.count(), Q_INT64_C(0));
+	QCOMPARE(histogram.maximum(), Q_INT64_C(0));
+	histogram.record(7);
+	QCOMPARE(histogram.minimum(), Q_INT64_C(7));
+}
+
+void TestPFHistogram::test_valueAtPercentile()
+{
+	// Values below 64 are exact
+	PFHistogram histogram;
+	for (qint64 value = 1; value <= 50; ++value)
+		histogram.record(value);
+	QCOMPARE(histogram.valueAtPercentile(0.0), Q_INT64_C(1));
+	QCOMPARE(histogram.valueAtPercentile(50.0), Q_INT64_C(25));
+	QCOMPARE(histogram.valueAtPercentile(100.0), Q_INT64_C(50));
+
+	// Larger values are within the bucket precision
+	PFHistogram latencies;
+	for (qint64 value = 1; value <= 100000; ++value)
+		latencies.record(value * 10);
+	qint64 p50 = latencies.valueAtPercentile(50.0);
+	qint64 p99 = latencies.valueAtPercentile(99.0);
+	QVERIFY(qAbs(p50 - 500000) <= 500000 / 32);
+	QVERIFY(qAbs(p99 - 990000) <= 990000 / 32);
+	QCOMPARE(latencies.valueAtPercentile(100.0), Q_INT64_C(1000000));
+}
+
+void TestPFHistogram::test_recordBenchmark()
+{
+	PFHistogram histogram;
+	QBENCHMARK
+	{
+		for (qint64 value = 0; value < 100000; ++value)
+			histogram.record(value * 37);
+	}
+	QVERIFY(histogram.count() > 0);
+}
+
+DECLARE_TEST(TestPFHistogram)
+#include "TestPFHistogram.moc"
@@ -0,0 +1,177 @@
+//
+//  TestPFImageLoader.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFError.h"
+#include "PFFile.h"
+#include "PFFileCache.h"
+#include "PFImageLoader.h"
+#include "PFManager.h"
+#include "TestRunner.h"
+
+#include <QImageReader>
+
+using namespace parse;
+
+class TestPFImageLoader : public QObject
+{
+    Q_OBJECT
+
+public slots:
+
+	void getImageCompleted(QImage image, PFErrorPtr error)
+	{
+		_image = image;
+		_error = error;
+		emit getImageEnded();
+	}
+
+signals:
+
+	void getImageEnded();
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		// Set the data path
+		QDir currentDir = QDir::current();
+#ifdef __APPLE__
+		currentDir.cdUp();
+#endif
+		_dataPath = currentDir.absoluteFilePath("data");
+		_imagePath = QDir(_dataPath).absoluteFilePath("small_image.jpg");
+		_imageSize = QImageReader(_imagePath).size();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		PFImageLoader::sharedLoader()->clearMemoryCache();
+		_image = QImage();
+		_error = PFErrorPtr();
+	}
+
+	void cleanup()
+	{
+		PFImageLoader::sharedLoader()->setPersistsThumbnails(false);
+	}
+
+	// Creation Methods
+	void test_sharedLoader();
+	void test_keyForImage();
+
+	// Get Image Methods
+	void test_getImageInBackground();
+	void test_getScaledImageInBackground();
+	void test_getImageInBackgroundInvalidData();
+	void test_persistsThumbnails();
+
+private:
+
+	// Helper Methods
+	bool waitForImage(PFFilePtr file, const QSize& size)
+	{
+		QEventLoop eventLoop;
+		QObject::connect(this, SIGNAL(getImageEnded()), &eventLoop, SLOT(quit()));
+		if (!file->getImageInBackground(size, this, SLOT(getImageCompleted(QImage, PFErrorPtr))))
+			return false;
+		eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+		return true;
+	}
+
+	// Instance members
+	QString		_dataPath;
+	QString		_imagePath;
+	QSize		_imageSize;
+
+	// Instance members for callbacks
+	QImage		_image;
+	PFErrorPtr	_error;
+};
+
+void TestPFImageLoader::test_sharedLoader()
+{
+	PFImageLoader* loader1 = PFImageLoader::sharedLoader();
+	PFImageLoader* loader2 = PFImageLoader::sharedLoader();
+	QCOMPARE(loader1, loader2);
+	QCOMPARE(loader1->maximumCacheSize(), 32 * 1024 * 1024);
+	QCOMPARE(loader1->persistsThumbnails(), false);
+}
+
+void TestPFImageLoader::test_keyForImage()
+{
+	QCOMPARE(PFImageLoader::keyForImage("", QSize(10, 10)), QString());
+	QCOMPARE(PFImageLoader::keyForImage("abc", QSize()), QString("abc"));
+	QCOMPARE(PFImageLoader::keyForImage("abc", QSize(10, 20)), QString("abc@10x20"));
+}
+
+void TestPFImageLoader::test_getImageInBackground()
+{
+	PFFilePtr file = PFFile::fileWithNameAndContentsAtPath("small_image.jpg", _imagePath);
+	QCOMPARE(waitForImage(file, QSize()), true);
+	QCOMPARE(_error.isNull(), true);
+	QCOMPARE(_image.size(), _imageSize);
+
+	// The second request should be served out of the memory cache
+	QImage cachedImage;
+	QCOMPARE(PFImageLoader::sharedLoader()->cachedImage(PFImageLoader::keyForImage("file:" + _imagePath, QSize()), cachedImage), true);
+	QCOMPARE(waitForImage(file, QSize()), true);
+	QCOMPARE(_image, cachedImage);
+}
+
+void TestPFImageLoader::test_getScaledImageInBackground()
+{
+	// The image should be scaled down to fit without changing the aspect ratio
+	PFFilePtr file = PFFile::fileWithNameAndContentsAtPath("small_image.jpg", _imagePath);
+	QSize size(_imageSize.width() / 2, _imageSize.height() / 2);
+	QCOMPARE(waitForImage(file, size), true);
+	QCOMPARE(_error.isNull(), true);
+	QCOMPARE(_image.size(), _imageSize.scaled(size, Qt::KeepAspectRatio));
+
+	// Images never get scaled up
+	QCOMPARE(waitForImage(file, _imageSize * 2), true);
+	QCOMPARE(_image.size(), _imageSize);
+}
+
+void TestPFImageLoader::test_getImageInBackgroundInvalidData()
+{
+	QByteArrayPtr data = QByteArrayPtr(new QByteArray(QString("Not an image").toUtf8()));
+	PFFilePtr file = PFFile::fileWithNameAndData("not_an_image.txt", data);
+	QCOMPARE(waitForImage(file, QSize()), true);
+	QCOMPARE(_image.isNull(), true);
+	QCOMPARE(_error.isNull(), false);
+	QCOMPARE(_error->errorCode(), kPFErrorInvalidImageData);
+}
+
+void TestPFImageLoader::test_persistsThumbnails()
+{
+	PFImageLoader::sharedLoader()->setPersistsThumbnails(true);
+
+	// Put the image in the cloud and load a thumbnail of it through a fresh file
+	PFFilePtr uploadFile = PFFile::fileWithNameAndContentsAtPath("small_image.jpg", _imagePath);
+	QCOMPARE(uploadFile->save(), true);
+	PFFilePtr cloudFile = PFFile::fileWithNameAndUrl(uploadFile->name(), uploadFile->url());
+	QSize size(32, 32);
+	QCOMPARE(waitForImage(cloudFile, size), true);
+	QCOMPARE(_error.isNull(), true);
+
+	// The thumbnail should have been written next to the cached file
+	QString cacheKey = PFFileCache::keyForUrl(cloudFile->url());
+	QString thumbnailDirectory = PFManager::sharedManager()->fileCache()->thumbnailDirectoryForKey(cacheKey);
+	QCOMPARE(QFileInfo(QDir(thumbnailDirectory).filePath("32x32.png")).isFile(), true);
+
+	// With the memory cache gone, the thumbnail is read back instead of decoding the original
+	PFImageLoader::sharedLoader()->clearMemoryCache();
+	QImage thumbnail = _image;
+	QCOMPARE(waitForImage(cloudFile, size), true);
+	QCOMPARE(_image.size(), thumbnail.size());
+}
+
+DECLARE_TEST(TestPFImageLoader)
+#include "TestPFImageLoader.moc"
@@ -0,0 +1,444 @@
+//
+//  TestPFLocalDatastore.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFDateTime.h"
+#include "PFError.h"
+#include "PFLocalDatastore.h"
+#include "PFManager.h"
+#include "PFObject.h"
+#include "PFQuery.h"
+#include "TestRunner.h"
+
+#include <QJsonArray>
+
+using namespace parse;
+
+class TestPFLocalDatastore : public QObject
+{
+    Q_OBJECT
+
+public slots:
+
+	void findObjectsCompleted(PFObjectList objects, PFErrorPtr error)
+	{
+		_findObjects = objects;
+		_findObjectsError = error;
+		emit findObjectsEnded();
+	}
+
+signals:
+
+	void findObjectsEnded();
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		// Create some games that look like they came from the cloud
+		QStringList names = QStringList() << "Chess" << "Checkers" << "Go" << "Backgammon";
+		for (int i = 0; i < names.count(); ++i)
+		{
+			PFObjectPtr game = PFObject::objectWithClassName("LocalGame", QString("game_%1").arg(i));
+			game->setObjectForKey(names.at(i), "name");
+			game->setObjectForKey(i * 10, "score");
+			game->setObjectForKey(QVariantList() << QString("board") << QString(i % 2 == 0 ? "classic" : "modern"), "tags");
+			_games.append(game);
+		}
+	}
+
+	void cleanupTestCase()
+	{
+		PFManager::sharedManager()->localDatastore()->clear();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		PFManager::sharedManager()->localDatastore()->clear();
+		_findObjects.clear();
+		_findObjectsError = PFErrorPtr();
+	}
+
+	void cleanup() {}
+
+	// Pin Methods
+	void test_pin();
+	void test_pinUnsavedObject();
+	void test_pinWithName();
+	void test_unpinAllObjectsWithName();
+	void test_fetchFromLocalDatastore();
+	void test_updateObject();
+
+	// Query Methods
+	void test_findObjects();
+	void test_findObjectsOrderAndPagination();
+	void test_fromPinWithName();
+	void test_countObjects();
+	void test_getObjectWithId();
+	void test_findObjectsInBackground();
+	void test_matchesWhere();
+
+	// Index Methods
+	void test_declareIndex();
+
+	// Benchmark Methods
+	void test_findObjectsBenchmark_data();
+	void test_findObjectsBenchmark();
+
+private:
+
+	// Instance members
+	PFObjectList	_games;
+
+	// Instance members for callbacks
+	PFObjectList	_findObjects;
+	PFErrorPtr		_findObjectsError;
+};
+
+void TestPFLocalDatastore::test_pin()
+{
+	PFLocalDatastore* localDatastore = PFManager::sharedManager()->localDatastore();
+	QCOMPARE(localDatastore->count(), 0);
+	QCOMPARE(_games.at(0)->pin(), true);
+	QCOMPARE(localDatastore->count(), 1);
+
+	// Pinning twice doesn't duplicate the object
+	QCOMPARE(_games.at(0)->pin(), true);
+	QCOMPARE(localDatastore->count(), 1);
+
+	// Pin them all
+	QCOMPARE(PFObject::pinAll(_games), true);
+	QCOMPARE(localDatastore->count(), _games.count());
+
+	// Unpin
+	QCOMPARE(_games.at(0)->unpin(), true);
+	QCOMPARE(localDatastore->count(), _games.count() - 1);
+	QCOMPARE(PFObject::unpinAll(_games), true);
+	QCOMPARE(localDatastore->count(), 0);
+}
+
+void TestPFLocalDatastore::test_pinUnsavedObject()
+{
+	PFObjectPtr game = PFObject::objectWithClassName("LocalGame");
+	PFErrorPtr error;
+	QCOMPARE(game->pin(error), false);
+	QCOMPARE(error.isNull(), false);
+	QCOMPARE(error->errorCode(), kPFErrorMissingObjectId);
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 0);
+}
+
+void TestPFLocalDatastore::test_pinWithName()
+{
+	// The object stays until the last pin goes away
+	PFObjectPtr game = _games.at(0);
+	QCOMPARE(game->pinWithName("favorites"), true);
+	QCOMPARE(game->pinWithName("recent"), true);
+	QCOMPARE(game->unpinWithName("favorites"), true);
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 1);
+	QCOMPARE(game->unpinWithName("recent"), true);
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 0);
+}
+
+void TestPFLocalDatastore::test_unpinAllObjectsWithName()
+{
+	PFErrorPtr error;
+	QCOMPARE(PFObject::pinAllWithName(_games, "favorites", error), true);
+	QCOMPARE(_games.at(0)->pin(), true);
+	QCOMPARE(PFObject::unpinAllObjectsWithName("favorites", error), true);
+	QCOMPARE(error.isNull(), true);
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 1);
+}
+
+void TestPFLocalDatastore::test_fetchFromLocalDatastore()
+{
+	QCOMPARE(_games.at(1)->pin(), true);
+
+	// Load it into a fresh object
+	PFObjectPtr game = PFObject::objectWithClassName("LocalGame", "game_1");
+	QCOMPARE(game->isDataAvailable(), false);
+	QCOMPARE(game->fetchFromLocalDatastore(), true);
+	QCOMPARE(game->isDataAvailable(), true);
+	QCOMPARE(game->objectForKey("name").toString(), QString("Checkers"));
+	QCOMPARE(game->objectForKey("score").toInt(), 10);
+	QCOMPARE(game->objectForKey("tags").toList().count(), 2);
+	QCOMPARE(game->allKeys().contains("objectId"), false);
+
+	// Objects that aren't pinned can't be fetched
+	PFObjectPtr missingGame = PFObject::objectWithClassName("LocalGame", "missing");
+	QCOMPARE(missingGame->fetchFromLocalDatastore(), false);
+}
+
+void TestPFLocalDatastore::test_updateObject()
+{
+	PFObjectPtr game = PFObject::objectWithClassName("LocalGame", "game_update");
+	game->setObjectForKey(QString("Old"), "name");
+	QCOMPARE(game->pin(), true);
+
+	// Saves and fetches call this to keep the pinned copy in sync
+	game->setObjectForKey(QString("New"), "name");
+	PFManager::sharedManager()->localDatastore()->updateObject(game.data());
+	PFObjectPtr storedGame = PFObject::objectWithClassName("LocalGame", "game_update");
+	QCOMPARE(storedGame->fetchFromLocalDatastore(), true);
+	QCOMPARE(storedGame->objectForKey("name").toString(), QString("New"));
+
+	// Objects that aren't pinned aren't added
+	PFManager::sharedManager()->localDatastore()->updateObject(_games.at(0).data());
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 1);
+
+	// Deletes drop the pinned copy
+	PFManager::sharedManager()->localDatastore()->removeObject(game.data());
+	QCOMPARE(PFManager::sharedManager()->localDatastore()->count(), 0);
+}
+
+void TestPFLocalDatastore::test_findObjects()
+{
+	QCOMPARE(PFObject::pinAll(_games), true);
+
+	// Equality
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyEqualTo("name", QString("Go"));
+	PFObjectList objects = query->findObjects();
+	QCOMPARE(objects.count(), 1);
+	QCOMPARE(objects.at(0)->objectId(), QString("game_2"));
+	QCOMPARE(objects.at(0)->objectForKey("score").toInt(), 20);
+
+	// Equality against a list matches any element
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyEqualTo("tags", QString("classic"));
+	QCOMPARE(query->findObjects().count(), 2);
+
+	// Ranges
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyGreaterThanOrEqualTo("score", 10);
+	query->whereKeyLessThan("score", 30);
+	QCOMPARE(query->findObjects().count(), 2);
+
+	// Lists
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyContainedIn("name", QVariantList() << QString("Chess") << QString("Go") << QString("Poker"));
+	QCOMPARE(query->findObjects().count(), 2);
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyNotContainedIn("name", QVariantList() << QString("Chess") << QString("Go"));
+	QCOMPARE(query->findObjects().count(), 2);
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyContainsAllObjects("tags", QVariantList() << QString("board") << QString("modern"));
+	QCOMPARE(query->findObjects().count(), 2);
+
+	// Existence and inequality
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyDoesNotExist("name");
+	QCOMPARE(query->findObjects().count(), 0);
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyNotEqualTo("name", QString("Chess"));
+	QCOMPARE(query->findObjects().count(), 3);
+
+	// Other classes are never returned
+	query = PFQuery::queryWithClassName("OtherGame");
+	query->fromLocalDatastore();
+	QCOMPARE(query->findObjects().count(), 0);
+}
+
+void TestPFLocalDatastore::test_findObjectsOrderAndPagination()
+{
+	QCOMPARE(PFObject::pinAll(_games), true);
+
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->orderByDescending("score");
+	PFObjectList objects = query->findObjects();
+	QCOMPARE(objects.count(), 4);
+	QCOMPARE(objects.at(0)->objectForKey("name").toString(), QString("Backgammon"));
+	QCOMPARE(objects.at(3)->objectForKey("name").toString(), QString("Chess"));
+
+	query->orderByAscending("name");
+	query->setSkip(1);
+	query->setLimit(2);
+	objects = query->findObjects();
+	QCOMPARE(objects.count(), 2);
+	QCOMPARE(objects.at(0)->objectForKey("name").toString(), QString("Checkers"));
+	QCOMPARE(objects.at(1)->objectForKey("name").toString(), QString("Chess"));
+
+	// The first object is the first one in order
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->orderByAscending("score");
+	QCOMPARE(query->getFirstObject()->objectForKey("name").toString(), QString("Chess"));
+}
+
+void TestPFLocalDatastore::test_fromPinWithName()
+{
+	PFErrorPtr error;
+	QCOMPARE(PFObject::pinAll(_games), true);
+	QCOMPARE(PFObject::pinAllWithName(_games.mid(0, 2), "favorites", error), true);
+
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromPinWithName("favorites");
+	QCOMPARE(query->isFromLocalDatastore(), true);
+	QCOMPARE(query->findObjects().count(), 2);
+
+	query->fromLocalDatastore();
+	QCOMPARE(query->findObjects().count(), 4);
+}
+
+void TestPFLocalDatastore::test_countObjects()
+{
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	QCOMPARE(query->countObjects(), 0);
+
+	QCOMPARE(PFObject::pinAll(_games), true);
+	QCOMPARE(query->countObjects(), 4);
+	query->whereKeyGreaterThan("score", 0);
+	QCOMPARE(query->countObjects(), 3);
+}
+
+void TestPFLocalDatastore::test_getObjectWithId()
+{
+	QCOMPARE(PFObject::pinAll(_games), true);
+
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	PFObjectPtr game = query->getObjectWithId("game_3");
+	QCOMPARE(game.isNull(), false);
+	QCOMPARE(game->objectForKey("name").toString(), QString("Backgammon"));
+
+	// Missing objects come back null without an error
+	PFErrorPtr error;
+	QCOMPARE(query->getObjectWithId("missing", error).isNull(), true);
+	QCOMPARE(error.isNull(), true);
+}
+
+void TestPFLocalDatastore::test_findObjectsInBackground()
+{
+	QCOMPARE(PFObject::pinAll(_games), true);
+
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyEqualTo("tags", QString("modern"));
+
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(findObjectsEnded()), &eventLoop, SLOT(quit()));
+	query->findObjectsInBackground(this, SLOT(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+
+	// The results never arrive synchronously
+	QCOMPARE(_findObjects.count(), 0);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_findObjectsError.isNull(), true);
+	QCOMPARE(_findObjects.count(), 2);
+}
+
+void TestPFLocalDatastore::test_matchesWhere()
+{
+	QJsonObject jsonObject;
+	jsonObject["createdAt"] = QString("2013-09-15T09:32:00.123Z");
+	jsonObject["score"] = 5.0;
+
+	// Dates are compared with the createdAt / updatedAt strings
+	PFDateTimePtr dateTime = PFDateTime::dateTimeFromParseString("2014-01-01T00:00:00.000Z");
+	QJsonObject dateJson;
+	dateTime->toJson(dateJson);
+	QJsonObject dateConstraint;
+	dateConstraint["$lt"] = dateJson;
+	QJsonObject where;
+	where["createdAt"] = dateConstraint;
+	PFErrorPtr error;
+	QCOMPARE(PFLocalDatastore::matchesWhere(jsonObject, where, error), true);
+
+	// Unsupported constraints are errors rather than silently ignored
+	QJsonObject regexConstraint;
+	regexConstraint["$regex"] = QString("^a");
+	where = QJsonObject();
+	where["score"] = regexConstraint;
+	QCOMPARE(PFLocalDatastore::matchesWhere(jsonObject, where, error), false);
+	QCOMPARE(error.isNull(), false);
+	QCOMPARE(error->errorCode(), kPFErrorInvalidQuery);
+}
+
+void TestPFLocalDatastore::test_declareIndex()
+{
+	PFLocalDatastore* localDatastore = PFManager::sharedManager()->localDatastore();
+	QCOMPARE(PFObject::pinAll(_games), true);
+
+	// Indexing existing objects shouldn't change any results
+	QCOMPARE(localDatastore->declareIndex("LocalGame", "score"), true);
+	QCOMPARE(localDatastore->declareIndex("LocalGame", "tags"), true);
+	QCOMPARE(localDatastore->indexedKeys("LocalGame"), QStringList() << "score" << "tags");
+	QCOMPARE(localDatastore->indexedKeys("OtherGame").isEmpty(), true);
+
+	PFQueryPtr query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyGreaterThan("score", 5);
+	query->whereKeyLessThanOrEqualTo("score", 20);
+	QCOMPARE(query->findObjects().count(), 2);
+
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyEqualTo("tags", QString("modern"));
+	QCOMPARE(query->findObjects().count(), 2);
+
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyContainedIn("score", QVariantList() << 0 << 30);
+	QCOMPARE(query->findObjects().count(), 2);
+
+	// Objects pinned after the index was declared are indexed too
+	PFObjectPtr game = PFObject::objectWithClassName("LocalGame", "game_indexed");
+	game->setObjectForKey(15, "score");
+	QCOMPARE(game->pin(), true);
+	query = PFQuery::queryWithClassName("LocalGame");
+	query->fromLocalDatastore();
+	query->whereKeyEqualTo("score", 15);
+	QCOMPARE(query->findObjects().count(), 1);
+}
+
+void TestPFLocalDatastore::test_findObjectsBenchmark_data()
+{
+	QTest::addColumn<QString>("key");
+	QTest::newRow("indexed") << "bucket";
+	QTest::newRow("unindexed") << "rating";
+}
+
+void TestPFLocalDatastore::test_findObjectsBenchmark()
+{
+	QFETCH(QString, key);
+
+	// Pin a large class where only one of two keys with the same values is indexed, so the unindexed query
+	// has to scan every object of the class
+	PFLocalDatastore* localDatastore = PFManager::sharedManager()->localDatastore();
+	QCOMPARE(localDatastore->declareIndex("LocalRecord", "bucket"), true);
+	PFObjectList records;
+	for (int i = 0; i < 20000; ++i)
+	{
+		PFObjectPtr record = PFObject::objectWithClassName("LocalRecord", QString("record_%1").arg(i));
+		record->setObjectForKey(i % 100, "bucket");
+		record->setObjectForKey(i % 100, "rating");
+		record->setObjectForKey(QString("Record %1").arg(i), "name");
+		records.append(record);
+	}
+	QCOMPARE(PFObject::pinAll(records), true);
+
+	QBENCHMARK
+	{
+		PFQueryPtr query = PFQuery::queryWithClassName("LocalRecord");
+		query->fromLocalDatastore();
+		query->whereKeyEqualTo(key, 42);
+		QCOMPARE(query->findObjects().count(), 200);
+	}
+}
+
+DECLARE_TEST(TestPFLocalDatastore)
+#include "TestPFLocalDatastore.moc"
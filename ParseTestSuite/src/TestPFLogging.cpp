@@ -0,0 +1,125 @@
+//
+//  TestPFLogging.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFConversion.h"
+#include "PFLogging.h"
+#include "PFObject.h"
+#include "TestRunner.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+using namespace parse;
+
+class TestPFLogging : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup()
+	{
+		PFLogLifetime().setEnabled(QtDebugMsg, false);
+		PFLogObject().setEnabled(QtDebugMsg, false);
+	}
+
+	// Category Methods
+	void test_categoryNames();
+	void test_quietCategoriesDisabled();
+
+	// Benchmark Methods
+	void test_deserializationBenchmark_data();
+	void test_deserializationBenchmark();
+
+private:
+
+	// Helper Methods
+	static QJsonArray createObjectJsonList();
+};
+
+QJsonArray TestPFLogging::createObjectJsonList()
+{
+	// Every object carries a date and a pointer so each one creates several SDK objects
+	QJsonArray jsonArray;
+	for (int i = 0; i < 1000; ++i)
+	{
+		QJsonObject dateObject;
+		dateObject["__type"] = QString("Date");
+		dateObject["iso"] = QString("2013-09-15T09:32:00.123Z");
+		QJsonObject pointerObject;
+		pointerObject["__type"] = QString("Pointer");
+		pointerObject["className"] = QString("Player");
+		pointerObject["objectId"] = QString("player%1").arg(i);
+
+		QJsonObject jsonObject;
+		jsonObject["__type"] = QString("Object");
+		jsonObject["className"] = QString("GameScore");
+		jsonObject["objectId"] = QString("obj%1").arg(i);
+		jsonObject["score"] = double(i);
+		jsonObject["startedAt"] = dateObject;
+		jsonObject["player"] = pointerObject;
+		jsonObject["createdAt"] = QString("2013-09-15T09:32:00.123Z");
+		jsonArray.append(jsonObject);
+	}
+
+	return jsonArray;
+}
+
+void TestPFLogging::test_categoryNames()
+{
+	QCOMPARE(QString(PFLogLifetime().categoryName()), QString("parse.lifetime"));
+	QCOMPARE(QString(PFLogObject().categoryName()), QString("parse.object"));
+	QCOMPARE(QString(PFLogQuery().categoryName()), QString("parse.query"));
+	QCOMPARE(QString(PFLogFile().categoryName()), QString("parse.file"));
+	QCOMPARE(QString(PFLogSync().categoryName()), QString("parse.sync"));
+	QCOMPARE(QString(PFLogManager().categoryName()), QString("parse.manager"));
+	QCOMPARE(QString(PFLogMetrics().categoryName()), QString("parse.metrics"));
+}
+
+void TestPFLogging::test_quietCategoriesDisabled()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+	// The per object categories are quiet unless turned on
+	QCOMPARE(PFLogLifetime().isDebugEnabled(), false);
+	QCOMPARE(PFLogObject().isDebugEnabled(), false);
+	QCOMPARE(PFLogLifetime().isWarningEnabled(), true);
+#endif
+
+	PFLogLifetime().setEnabled(QtDebugMsg, true);
+	QCOMPARE(PFLogLifetime().isDebugEnabled(), true);
+}
+
+void TestPFLogging::test_deserializationBenchmark_data()
+{
+	QTest::addColumn<bool>("lifetimeLogging");
+	QTest::newRow("disabled") << false;
+	QTest::newRow("enabled") << true;
+}
+
+void TestPFLogging::test_deserializationBenchmark()
+{
+	// Converts a query sized batch of objects with the lifetime messages on and off. Each object logs its
+	// creation along with the creation of its dates and pointer.
+	QFETCH(bool, lifetimeLogging);
+	QJsonArray jsonArray = createObjectJsonList();
+	PFLogLifetime().setEnabled(QtDebugMsg, lifetimeLogging);
+	QBENCHMARK
+	{
+		QVariantList objects = PFConversion::convertJsonToVariant(jsonArray).toList();
+		QCOMPARE(objects.count(), 1000);
+	}
+}
+
+DECLARE_TEST(TestPFLogging)
+#include "TestPFLogging.moc"
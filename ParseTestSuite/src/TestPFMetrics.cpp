@@ -0,0 +1,153 @@
+//
+//  TestPFMetrics.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFManager.h"
+#include "PFMetrics.h"
+#include "TestRunner.h"
+
+#include <QNetworkAccessManager>
+#include <QSignalSpy>
+
+using namespace parse;
+
+class TestPFMetrics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Backend API
+	void test_endpointForUrl();
+	void test_recordMethods();
+	void test_trackReply();
+	void test_managerReportsReplies();
+
+	// User API
+	void test_reset();
+	void test_setDumpInterval();
+
+private:
+
+	// Helper Methods
+	static void waitForReply(QNetworkReply* reply);
+};
+
+void TestPFMetrics::waitForReply(QNetworkReply* reply)
+{
+	QEventLoop eventLoop;
+	QObject::connect(reply, SIGNAL(finished()), &eventLoop, SLOT(quit()));
+	if (!reply->isFinished())
+		eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+}
+
+void TestPFMetrics::test_endpointForUrl()
+{
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/classes/GameScore")), QString("classes"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/classes/GameScore/1234")), QString("classes"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/batch")), QString("batch"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/users/1234")), QString("users"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/requestPasswordReset")), QString("users"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/login?username=a&password=b")), QString("login"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/files/image.png")), QString("files"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("http://files.parse.com/tfss-image.png")), QString("files"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl("https://api.parse.com/1/functions/hello")), QString("other"));
+	QCOMPARE(PFMetrics::endpointForUrl(QUrl()), QString("other"));
+}
+
+void TestPFMetrics::test_recordMethods()
+{
+	PFMetricsPtr metrics = PFMetrics::metrics();
+	QCOMPARE(metrics->snapshot().isEmpty(), true);
+
+	metrics->recordQueueWait("files", 2000);
+	metrics->recordDecodeTime("classes", 500);
+	metrics->recordDecodeTime("classes", 1500);
+	metrics->recordError("classes", "parse:101");
+	metrics->recordError("classes", "parse:101");
+
+	QJsonObject snapshot = metrics->snapshot();
+	QCOMPARE(snapshot.keys(), QStringList() << "classes" << "files");
+
+	QJsonObject classesObject = snapshot["classes"].toObject();
+	QCOMPARE(classesObject["requests"].toDouble(), 0.0);
+	QCOMPARE(classesObject["errors"].toObject()["parse:101"].toDouble(), 2.0);
+	QJsonObject decodeObject = classesObject["decodeTime"].toObject();
+	QCOMPARE(decodeObject["count"].toDouble(), 2.0);
+	QCOMPARE(decodeObject["min"].toDouble(), 0.5);
+	QCOMPARE(decodeObject["mean"].toDouble(), 1.0);
+
+	QJsonObject queueWaitObject = snapshot["files"].toObject()["queueWait"].toObject();
+	QCOMPARE(queueWaitObject["count"].toDouble(), 1.0);
+	QCOMPARE(queueWaitObject["max"].toDouble(), 2.0);
+}
+
+void TestPFMetrics::test_trackReply()
+{
+	// Nothing listens on port 1 so the request fails right away
+	PFMetricsPtr metrics = PFMetrics::metrics();
+	QNetworkAccessManager networkAccessManager;
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("http://127.0.0.1:1/missing")));
+	metrics->trackReply(reply, 0);
+	waitForReply(reply);
+
+	QJsonObject filesObject = metrics->snapshot()["files"].toObject();
+	QCOMPARE(filesObject["requests"].toDouble(), 1.0);
+	QCOMPARE(filesObject["latency"].toObject()["count"].toDouble(), 1.0);
+	QCOMPARE(filesObject["errors"].toObject().isEmpty(), false);
+	QVERIFY(filesObject["errors"].toObject().keys().first().startsWith("network:"));
+
+	reply->deleteLater();
+}
+
+void TestPFMetrics::test_managerReportsReplies()
+{
+	PFMetrics* metrics = PFManager::sharedManager()->metrics();
+	metrics->reset();
+
+	QNetworkReply* reply = PFManager::sharedManager()->networkAccessManager()->get(QNetworkRequest(QUrl("http://127.0.0.1:1/missing")));
+	waitForReply(reply);
+	QCOMPARE(metrics->snapshot()["files"].toObject()["requests"].toDouble(), 1.0);
+
+	reply->deleteLater();
+	metrics->reset();
+}
+
+void TestPFMetrics::test_reset()
+{
+	PFMetricsPtr metrics = PFMetrics::metrics();
+	metrics->recordDecodeTime("classes", 10);
+	metrics->reset();
+	QCOMPARE(metrics->snapshot().isEmpty(), true);
+}
+
+void TestPFMetrics::test_setDumpInterval()
+{
+	PFMetricsPtr metrics = PFMetrics::metrics();
+	QCOMPARE(metrics->dumpInterval(), 0);
+
+	metrics->recordDecodeTime("classes", 10);
+	QSignalSpy spy(metrics.data(), SIGNAL(metricsDumped(QJsonObject)));
+	metrics->setDumpInterval(10);
+	QCOMPARE(metrics->dumpInterval(), 10);
+	QVERIFY(spy.wait(1000));
+	QCOMPARE(spy.first().first().toJsonObject().contains("classes"), true);
+
+	metrics->setDumpInterval(0);
+	QCOMPARE(metrics->dumpInterval(), 0);
+}
+
+DECLARE_TEST(TestPFMetrics)
+#include "TestPFMetrics.moc"
@@ -0,0 +1,105 @@
+//
+//  TestPFMimeTypeResolver.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFMimeTypeResolver.h"
+#include "TestRunner.h"
+
+using namespace parse;
+
+class TestPFMimeTypeResolver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		// Set the data path
+		QDir currentDir = QDir::current();
+#ifdef __APPLE__
+		currentDir.cdUp();
+#endif
+		_dataPath = currentDir.absoluteFilePath("data");
+	}
+
+	// Creation Methods
+	void test_sharedResolver();
+
+	// Lookup Methods
+	void test_mimeTypeForData();
+	void test_mimeTypeForFileName();
+	void test_mimeTypeForFile();
+
+	// Benchmark Methods
+	void test_mimeTypeForFileNameBenchmark();
+
+private:
+
+	// Instance members
+	QString _dataPath;
+};
+
+void TestPFMimeTypeResolver::test_sharedResolver()
+{
+	PFMimeTypeResolver* resolver1 = PFMimeTypeResolver::sharedResolver();
+	PFMimeTypeResolver* resolver2 = PFMimeTypeResolver::sharedResolver();
+	QCOMPARE(resolver1, resolver2);
+	QCOMPARE(PFMimeTypeResolver::headerSize(), Q_INT64_C(16 * 1024));
+}
+
+void TestPFMimeTypeResolver::test_mimeTypeForData()
+{
+	// Plain text
+	QByteArray text = QString("Some sample data to test with").toUtf8();
+	QCOMPARE(PFMimeTypeResolver::sharedResolver()->mimeTypeForData(text).name(), QString("text/plain"));
+
+	// A png header followed by a lot of data should be recognized from the header alone
+	QByteArray png = QByteArray::fromHex("89504e470d0a1a0a") + QByteArray(4 * 1024 * 1024, '\0');
+	QCOMPARE(PFMimeTypeResolver::sharedResolver()->mimeTypeForData(png).name(), QString("image/png"));
+}
+
+void TestPFMimeTypeResolver::test_mimeTypeForFileName()
+{
+	PFMimeTypeResolver* resolver = PFMimeTypeResolver::sharedResolver();
+	QCOMPARE(resolver->mimeTypeForFileName("image.png").name(), QString("image/png"));
+	QCOMPARE(resolver->mimeTypeForFileName("IMAGE.PNG").name(), QString("image/png"));
+	QCOMPARE(resolver->mimeTypeForFileName("another_image.png").name(), QString("image/png"));
+	QCOMPARE(resolver->mimeTypeForFileName("archive.zip").name(), QString("application/zip"));
+
+	// Names with multiple suffixes get looked up as a whole
+	QCOMPARE(resolver->mimeTypeForFileName("archive.tar.gz").name(), QString("application/x-compressed-tar"));
+	QCOMPARE(resolver->mimeTypeForFileName("archive.gz").name(), QString("application/gzip"));
+
+	// Unknown extensions have to be sniffed
+	QCOMPARE(resolver->mimeTypeForFileName("no_extension").isValid(), false);
+	QCOMPARE(resolver->mimeTypeForFileName("file.unknown_extension").isValid(), false);
+}
+
+void TestPFMimeTypeResolver::test_mimeTypeForFile()
+{
+	PFMimeTypeResolver* resolver = PFMimeTypeResolver::sharedResolver();
+	QString imagePath = QDir(_dataPath).absoluteFilePath("small_image.jpg");
+	QCOMPARE(resolver->mimeTypeForFile("small_image.jpg", imagePath).name(), QString("image/jpeg"));
+
+	// Without a usable extension the header of the file gets sniffed
+	QCOMPARE(resolver->mimeTypeForFile("small_image", imagePath).name(), QString("image/jpeg"));
+}
+
+void TestPFMimeTypeResolver::test_mimeTypeForFileNameBenchmark()
+{
+	PFMimeTypeResolver* resolver = PFMimeTypeResolver::sharedResolver();
+	QBENCHMARK
+	{
+		for (int i = 0; i < 1000; ++i)
+			resolver->mimeTypeForFileName(QString("image_%1.jpg").arg(i));
+	}
+}
+
+DECLARE_TEST(TestPFMimeTypeResolver)
+#include "TestPFMimeTypeResolver.moc"
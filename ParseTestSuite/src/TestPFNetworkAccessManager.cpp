@@ -0,0 +1,593 @@
+//
+//  TestPFNetworkAccessManager.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFError.h"
+#include "PFManager.h"
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
+#include "PFObject.h"
+#include "PFRetryPolicy.h"
+#include "TestRunner.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QStringList>
+
+using namespace parse;
+
+// Records the order the hooks run in and tags the request with a header
+class RecordingInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	RecordingInterceptor(const QString& name, QStringList* calls) : _name(name), _calls(calls) {}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		_calls->append("send:" + _name);
+		context.request.setRawHeader(QString("X-Intercepted-" + _name).toUtf8(), "1");
+		context.userData[_name] = context.startUsecs;
+	}
+
+	virtual void didFinishReply(PFNetworkContext& context, QNetworkReply* reply)
+	{
+		Q_UNUSED(reply);
+		_calls->append("finish:" + _name);
+		_lastContext = context;
+	}
+
+	QString					_name;
+	QStringList*			_calls;
+	PFNetworkContext		_lastContext;
+};
+
+// Answers every request itself
+class ReplyingInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	ReplyingInterceptor(int statusCode, const QByteArray& data) : _statusCode(statusCode), _data(data) {}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		_lastBody = context.body();
+		_lastRequest = context.request;
+		context.reply = PFNetworkReply::replyWithData(context.request, context.operation, _statusCode, _data);
+	}
+
+	int						_statusCode;
+	QByteArray				_data;
+	QByteArray				_lastBody;
+	QNetworkRequest			_lastRequest;
+};
+
+// Replaces the request body
+class BodyInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		context.setBody(context.body().toUpper());
+	}
+};
+
+// Fails the first requests before answering them
+class FlakyInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	FlakyInterceptor(int failureCount, int statusCode, const QByteArray& data) :
+		_failureCount(failureCount), _statusCode(statusCode), _data(data), _requestCount(0), _attemptCount(0) {}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		_bodies.append(context.body());
+		if (_requestCount++ < _failureCount)
+			context.reply = PFNetworkReply::replyWithData(context.request, context.operation, _statusCode, _data);
+		else
+			context.reply = PFNetworkReply::replyWithData(context.request, context.operation, 200, "{\"objectId\":\"1234\"}");
+		if (PFNetworkAccessManager::isAttemptReply(context.reply))
+			++_attemptCount;
+	}
+
+	int						_failureCount;
+	int						_statusCode;
+	QByteArray				_data;
+	int						_requestCount;
+	int						_attemptCount;
+	QList<QByteArray>		_bodies;
+};
+
+class TestPFNetworkAccessManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup()
+	{
+		PFNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+		foreach (PFNetworkInterceptorPtr interceptor, networkAccessManager->interceptors())
+			networkAccessManager->removeInterceptor(interceptor);
+	}
+
+	// Interceptor Methods
+	void test_addRemoveInterceptor();
+	void test_interceptorOrder();
+	void test_interceptedReply();
+	void test_interceptedErrorReply();
+	void test_replaceBody();
+	void test_sdkRequestsPassThroughInterceptors();
+
+	// Retry Methods
+	void test_retryTransientFailure();
+	void test_retryGivesUp();
+	void test_noRetryForPermanentFailure();
+	void test_noRetryForNonIdempotentRequests();
+	void test_retryResendsBody();
+	void test_abortDuringBackoff();
+	void test_circuitOpensAndFailsFast();
+
+	// Deduplication Methods
+	void test_identicalGetsShareRequest();
+	void test_sessionsDontShareRequest();
+	void test_abortSharedRequest();
+
+	// Benchmark Methods
+	void test_interceptorChainBenchmark_data();
+	void test_interceptorChainBenchmark();
+
+private:
+
+	// Helper Methods
+	static void waitForReply(QNetworkReply* reply);
+	static PFRetryPolicy createRetryPolicy();
+};
+
+void TestPFNetworkAccessManager::waitForReply(QNetworkReply* reply)
+{
+	QEventLoop eventLoop;
+	QObject::connect(reply, SIGNAL(finished()), &eventLoop, SLOT(quit()));
+	if (!reply->isFinished())
+		eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+}
+
+PFRetryPolicy TestPFNetworkAccessManager::createRetryPolicy()
+{
+	// Short backoffs keep the tests fast, the circuit breaker stays out of the way unless a test sets it up
+	PFRetryPolicy retryPolicy;
+	retryPolicy.setInitialBackoff(10);
+	retryPolicy.setMaximumBackoff(50);
+	retryPolicy.setCircuitBreakerEnabled(false);
+
+	return retryPolicy;
+}
+
+void TestPFNetworkAccessManager::test_addRemoveInterceptor()
+{
+	PFNetworkAccessManager networkAccessManager;
+	PFNetworkInterceptorPtr interceptor = PFNetworkInterceptorPtr(new PFNetworkInterceptor());
+	networkAccessManager.addInterceptor(interceptor);
+	networkAccessManager.addInterceptor(interceptor);
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr());
+	QCOMPARE(networkAccessManager.interceptors().count(), 1);
+
+	networkAccessManager.removeInterceptor(interceptor);
+	QCOMPARE(networkAccessManager.interceptors().isEmpty(), true);
+}
+
+void TestPFNetworkAccessManager::test_interceptorOrder()
+{
+	QStringList calls;
+	QSharedPointer<RecordingInterceptor> first = QSharedPointer<RecordingInterceptor>(new RecordingInterceptor("first", &calls));
+	QSharedPointer<RecordingInterceptor> second = QSharedPointer<RecordingInterceptor>(new RecordingInterceptor("second", &calls));
+	QSharedPointer<ReplyingInterceptor> replying = QSharedPointer<ReplyingInterceptor>(new ReplyingInterceptor(200, "{}"));
+	QSharedPointer<RecordingInterceptor> skipped = QSharedPointer<RecordingInterceptor>(new RecordingInterceptor("skipped", &calls));
+
+	// Without retries or shared requests the context holds the reply the manager hands out rather than the one
+	// of an attempt
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(PFRetryPolicy::noRetryPolicy());
+	networkAccessManager.setRequestDeduplicationEnabled(false);
+	networkAccessManager.addInterceptor(first);
+	networkAccessManager.addInterceptor(second);
+	networkAccessManager.addInterceptor(replying);
+	networkAccessManager.addInterceptor(skipped);
+
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore")));
+	waitForReply(reply);
+
+	// Requests run through the chain in order up to the interceptor that answered, replies in reverse
+	QCOMPARE(calls, QStringList() << "send:first" << "send:second" << "finish:second" << "finish:first");
+
+	// Earlier interceptors changed the request the later ones saw
+	QCOMPARE(replying->_lastRequest.rawHeader("X-Intercepted-first"), QByteArray("1"));
+	QCOMPARE(replying->_lastRequest.rawHeader("X-Intercepted-second"), QByteArray("1"));
+
+	// Timing context and user data carry over to the finish hook
+	PFNetworkContext context = first->_lastContext;
+	QCOMPARE(context.reply, reply);
+	QCOMPARE(context.userData["first"].toLongLong(), context.startUsecs);
+	QVERIFY(context.sendUsecs >= context.startUsecs);
+	QVERIFY(context.finishedUsecs >= context.sendUsecs);
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_interceptedReply()
+{
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new ReplyingInterceptor(200, "{\"objectId\":\"1234\"}")));
+	QSignalSpy spy(&networkAccessManager, SIGNAL(finished(QNetworkReply*)));
+
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore/1234")));
+	QCOMPARE(reply->isFinished(), false);
+	waitForReply(reply);
+
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+	QCOMPARE(reply->readAll(), QByteArray("{\"objectId\":\"1234\"}"));
+
+	// The manager reports intercepted replies like any other
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(spy.first().first().value<QNetworkReply*>(), reply);
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_interceptedErrorReply()
+{
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	PFNetworkReply* reply = PFNetworkReply::replyWithError(request, QNetworkAccessManager::GetOperation,
+														   QNetworkReply::TimeoutError, "Timed out");
+	waitForReply(reply);
+	QCOMPARE(reply->error(), QNetworkReply::TimeoutError);
+	QCOMPARE(reply->errorString(), QString("Timed out"));
+	delete reply;
+
+	QCOMPARE(PFNetworkReply::networkErrorForStatusCode(201), QNetworkReply::NoError);
+	QCOMPARE(PFNetworkReply::networkErrorForStatusCode(404), QNetworkReply::ContentNotFoundError);
+	QCOMPARE(PFNetworkReply::networkErrorForStatusCode(500), QNetworkReply::UnknownContentError);
+}
+
+void TestPFNetworkAccessManager::test_replaceBody()
+{
+	QSharedPointer<ReplyingInterceptor> replying = QSharedPointer<ReplyingInterceptor>(new ReplyingInterceptor(201, "{}"));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new BodyInterceptor()));
+	networkAccessManager.addInterceptor(replying);
+
+	QNetworkReply* reply = networkAccessManager.post(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore")), QByteArray("{\"name\":\"chess\"}"));
+	waitForReply(reply);
+	QCOMPARE(replying->_lastBody, QByteArray("{\"NAME\":\"CHESS\"}"));
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_sdkRequestsPassThroughInterceptors()
+{
+	// Fault injection - the fetch fails with the Parse error from the injected reply without touching the network
+	QSharedPointer<ReplyingInterceptor> replying = QSharedPointer<ReplyingInterceptor>(
+		new ReplyingInterceptor(404, "{\"code\":101,\"error\":\"object not found for get\"}"));
+	PFManager::sharedManager()->networkAccessManager()->addInterceptor(replying);
+
+	PFObjectPtr object = PFObject::objectWithClassName("GameScore", "1234");
+	PFErrorPtr error;
+	QCOMPARE(object->fetch(error), false);
+	QCOMPARE(error.isNull(), false);
+	QCOMPARE(error->errorCode(), 101);
+	QCOMPARE(replying->_lastRequest.url().path(), QString("/1/classes/GameScore/1234"));
+}
+
+void TestPFNetworkAccessManager::test_retryTransientFailure()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(2, 500, "{\"code\":1,\"error\":\"internal error\"}"));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(createRetryPolicy());
+	networkAccessManager.addInterceptor(flaky);
+	QSignalSpy spy(&networkAccessManager, SIGNAL(finished(QNetworkReply*)));
+
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore/1234")));
+	waitForReply(reply);
+
+	// The failed attempts stay hidden behind the reply
+	QCOMPARE(flaky->_requestCount, 3);
+	QCOMPARE(flaky->_attemptCount, 3);
+	QCOMPARE(PFNetworkAccessManager::isAttemptReply(reply), false);
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+	QCOMPARE(reply->readAll(), QByteArray("{\"objectId\":\"1234\"}"));
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(spy.first().first().value<QNetworkReply*>(), reply);
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_retryGivesUp()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(10, 500, "{\"code\":124,\"error\":\"timed out\"}"));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(createRetryPolicy());
+	networkAccessManager.addInterceptor(flaky);
+
+	// The reply ends up with the error of the last attempt
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore")));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 3);
+	QCOMPARE(reply->error(), QNetworkReply::UnknownContentError);
+	QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 500);
+	QCOMPARE(reply->readAll(), QByteArray("{\"code\":124,\"error\":\"timed out\"}"));
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_noRetryForPermanentFailure()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(1, 404, "{\"code\":101,\"error\":\"object not found for get\"}"));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(createRetryPolicy());
+	networkAccessManager.addInterceptor(flaky);
+
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore/1234")));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 1);
+	QCOMPARE(reply->error(), QNetworkReply::ContentNotFoundError);
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_noRetryForNonIdempotentRequests()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(10, 503, "{\"code\":1,\"error\":\"internal error\"}"));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(createRetryPolicy());
+	networkAccessManager.addInterceptor(flaky);
+
+	// Creating an object twice would create two objects
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	QNetworkReply* reply = networkAccessManager.post(request, QByteArray("{\"score\":1}"));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 1);
+	reply->deleteLater();
+
+	// So would incrementing twice
+	request.setUrl(QUrl("https://api.parse.com/1/classes/GameScore/1234"));
+	reply = networkAccessManager.put(request, QByteArray("{\"score\":{\"__op\":\"Increment\",\"amount\":1}}"));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 2);
+	reply->deleteLater();
+
+	// Files download from their own host and resume on their own
+	reply = networkAccessManager.get(QNetworkRequest(QUrl("http://files.parse.com/tfss-image.png")));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 3);
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_retryResendsBody()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(1, 503, QByteArray()));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(createRetryPolicy());
+	networkAccessManager.addInterceptor(flaky);
+
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore/1234"));
+	QNetworkReply* reply = networkAccessManager.put(request, QByteArray("{\"score\":1}"));
+	waitForReply(reply);
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(flaky->_bodies, QList<QByteArray>() << "{\"score\":1}" << "{\"score\":1}");
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_abortDuringBackoff()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(10, 503, QByteArray()));
+	PFRetryPolicy retryPolicy = createRetryPolicy();
+	retryPolicy.setInitialBackoff(60000);
+	retryPolicy.setMaximumBackoff(60000);
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(retryPolicy);
+	networkAccessManager.addInterceptor(flaky);
+
+	QNetworkReply* reply = networkAccessManager.get(QNetworkRequest(QUrl("https://api.parse.com/1/classes/GameScore")));
+	QCOMPARE(flaky->_requestCount, 1);
+	QTest::qWait(50);
+	QCOMPARE(reply->isFinished(), false);
+
+	reply->abort();
+	QCOMPARE(reply->isFinished(), true);
+	QCOMPARE(reply->error(), QNetworkReply::OperationCanceledError);
+	QTest::qWait(50);
+	QCOMPARE(flaky->_requestCount, 1);
+
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_circuitOpensAndFailsFast()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(
+		new FlakyInterceptor(4, 503, QByteArray()));
+	PFRetryPolicy retryPolicy = createRetryPolicy();
+	retryPolicy.setMaximumAttempts(1);
+	retryPolicy.setCircuitBreakerEnabled(true);
+	retryPolicy.setMinimumRequestCount(4);
+	retryPolicy.setOpenDuration(200);
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(retryPolicy);
+	networkAccessManager.addInterceptor(flaky);
+
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	for (int i = 0; i < 4; ++i)
+	{
+		QNetworkReply* reply = networkAccessManager.get(request);
+		waitForReply(reply);
+		reply->deleteLater();
+	}
+	QCOMPARE(networkAccessManager.circuitStateForHost("api.parse.com"), PFCircuitBreaker::Open);
+
+	// Requests fail with a connection error right away, without reaching the interceptors
+	QSignalSpy spy(&networkAccessManager, SIGNAL(finished(QNetworkReply*)));
+	QNetworkReply* reply = networkAccessManager.post(request, QByteArray("{\"score\":1}"));
+	waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 4);
+	QCOMPARE(reply->error(), QNetworkReply::TemporaryNetworkFailureError);
+	QCOMPARE(QJsonDocument::fromJson(reply->readAll()).object().value("code").toInt(), kPFErrorConnectionFailed);
+	QCOMPARE(spy.count(), 1);
+	reply->deleteLater();
+
+	// Once the open duration passed the trial request closes the circuit again
+	QTest::qWait(250);
+	QCOMPARE(networkAccessManager.circuitStateForHost("api.parse.com"), PFCircuitBreaker::HalfOpen);
+	reply = networkAccessManager.get(request);
+	waitForReply(reply);
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(flaky->_requestCount, 5);
+	QCOMPARE(networkAccessManager.circuitStateForHost("api.parse.com"), PFCircuitBreaker::Closed);
+	reply->deleteLater();
+}
+
+void TestPFNetworkAccessManager::test_identicalGetsShareRequest()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(new FlakyInterceptor(0, 200, QByteArray()));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(flaky);
+	QSignalSpy spy(&networkAccessManager, SIGNAL(finished(QNetworkReply*)));
+
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore/1234"));
+	QList<QNetworkReply*> replies;
+	for (int i = 0; i < 3; ++i)
+		replies.append(networkAccessManager.get(request));
+	foreach (QNetworkReply* reply, replies)
+		waitForReply(reply);
+
+	// One request goes out and every caller reads the whole response from a reply of its own
+	QCOMPARE(flaky->_requestCount, 1);
+	QCOMPARE(spy.count(), 3);
+	foreach (QNetworkReply* reply, replies)
+	{
+		QCOMPARE(reply->error(), QNetworkReply::NoError);
+		QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+		QCOMPARE(reply->readAll(), QByteArray("{\"objectId\":\"1234\"}"));
+	}
+	qDeleteAll(replies);
+
+	// Requests that finished aren't in flight anymore, writes are never shared
+	replies.clear();
+	replies.append(networkAccessManager.get(request));
+	waitForReply(replies.first());
+	QCOMPARE(flaky->_requestCount, 2);
+	delete replies.takeFirst();
+	for (int i = 0; i < 2; ++i)
+		replies.append(networkAccessManager.put(request, QByteArray("{\"score\":1}")));
+	foreach (QNetworkReply* reply, replies)
+		waitForReply(reply);
+	QCOMPARE(flaky->_requestCount, 4);
+	qDeleteAll(replies);
+}
+
+void TestPFNetworkAccessManager::test_sessionsDontShareRequest()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(new FlakyInterceptor(0, 200, QByteArray()));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(flaky);
+
+	// Users can see different objects through the same url
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	request.setRawHeader("X-Parse-Session-Token", "first");
+	QNetworkReply* firstReply = networkAccessManager.get(request);
+	QNetworkReply* sharedReply = networkAccessManager.get(request);
+	request.setRawHeader("X-Parse-Session-Token", "second");
+	QNetworkReply* secondReply = networkAccessManager.get(request);
+	waitForReply(firstReply);
+	waitForReply(sharedReply);
+	waitForReply(secondReply);
+	QCOMPARE(flaky->_requestCount, 2);
+
+	delete firstReply;
+	delete sharedReply;
+	delete secondReply;
+}
+
+void TestPFNetworkAccessManager::test_abortSharedRequest()
+{
+	QSharedPointer<FlakyInterceptor> flaky = QSharedPointer<FlakyInterceptor>(new FlakyInterceptor(0, 200, QByteArray()));
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(flaky);
+	PFRequestScheduler* requestScheduler = networkAccessManager.requestScheduler();
+
+	// A caller giving up leaves the others with the response
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore/1234"));
+	QNetworkReply* abortedReply = networkAccessManager.get(request);
+	QNetworkReply* reply = networkAccessManager.get(request);
+	abortedReply->abort();
+	QCOMPARE(abortedReply->error(), QNetworkReply::OperationCanceledError);
+	waitForReply(reply);
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(flaky->_requestCount, 1);
+	delete abortedReply;
+	delete reply;
+
+	// Once every caller gave up the request is dropped before it goes out
+	requestScheduler->pause(60000);
+	abortedReply = networkAccessManager.get(request);
+	QNetworkReply* secondAbortedReply = networkAccessManager.get(request);
+	QCOMPARE(requestScheduler->queuedCount(), 1);
+	abortedReply->abort();
+	secondAbortedReply->abort();
+	QTest::qWait(50);
+	QCOMPARE(flaky->_requestCount, 1);
+	delete abortedReply;
+	delete secondAbortedReply;
+}
+
+void TestPFNetworkAccessManager::test_interceptorChainBenchmark_data()
+{
+	QTest::addColumn<int>("interceptorCount");
+	QTest::newRow("0 pass-through interceptors") << 0;
+	QTest::newRow("8 pass-through interceptors") << 8;
+}
+
+void TestPFNetworkAccessManager::test_interceptorChainBenchmark()
+{
+	// Measures the overhead of the chain itself, every request gets answered by the last interceptor
+	QFETCH(int, interceptorCount);
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRequestDeduplicationEnabled(false);
+	for (int i = 0; i < interceptorCount; ++i)
+		networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new PFNetworkInterceptor()));
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new ReplyingInterceptor(200, "{}")));
+
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	QBENCHMARK
+	{
+		QList<QNetworkReply*> replies;
+		for (int i = 0; i < 1000; ++i)
+			replies.append(networkAccessManager.get(request));
+		waitForReply(replies.last());
+		qDeleteAll(replies);
+	}
+}
+
+DECLARE_TEST(TestPFNetworkAccessManager)
+#include "TestPFNetworkAccessManager.moc"
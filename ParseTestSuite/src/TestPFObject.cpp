@@ -130,6 +130,8 @@ private slots:
 	void test_removeObjectFromListForKey();
 	void test_removeObjectFromListForKeyWithSerializable();
 	void test_removeObjectsFromListForKey();
+	void test_listForKeyDuplicates();
+	void test_listForKeyLargeListBenchmark();
 
 	// ACL Accessor Methods
 	void test_setACL();
@@ -1435,6 +1437,58 @@ void TestPFObject::test_removeObjectsFromListForKey()
 	QCOMPARE(chess->deleteObject(), true);
 }
 
+void TestPFObject::test_listForKeyDuplicates()
+{
+	// Duplicates within the objects being added should only be added once
+	PFObjectPtr chess = PFObject::objectWithClassName("Game");
+	chess->setObjectForKey(QVariantList() << QString("King"), "piecesRemaining");
+	chess->addUniqueObjectsToListForKey(QVariantList() << QString("Pawn") << QString("Pawn") << QString("King"), "piecesRemaining");
+	QCOMPARE(chess->objectForKey("piecesRemaining").toList().count(), 2);
+	QCOMPARE(chess->objectForKey("piecesRemaining").toList().at(1).toString(), QString("Pawn"));
+
+	// Strings and numbers with the same text are different values
+	chess->addUniqueObjectsToListForKey(QVariantList() << QString("1") << 1 << 1.0, "piecesRemaining");
+	QCOMPARE(chess->objectForKey("piecesRemaining").toList().count(), 4);
+
+	// Saved objects match on their objectId while unsaved ones only match themselves
+	PFObjectPtr king = PFObject::objectWithClassName("ChessPiece", "kingId");
+	PFObjectPtr unsavedQueen1 = PFObject::objectWithClassName("ChessPiece");
+	PFObjectPtr unsavedQueen2 = PFObject::objectWithClassName("ChessPiece");
+	QVariantList pieces;
+	pieces << PFObject::toVariant(king) << PFObject::toVariant(unsavedQueen1) << PFObject::toVariant(unsavedQueen2);
+	chess->setObjectForKey(pieces, "pieces");
+	chess->addUniqueObjectToListForKey(PFObject::objectWithClassName("ChessPiece", "kingId"), "pieces");
+	chess->addUniqueObjectToListForKey(unsavedQueen1, "pieces");
+	QCOMPARE(chess->objectForKey("pieces").toList().count(), 3);
+
+	// Removing takes out every equal object
+	chess->setObjectForKey(QVariantList() << QString("Pawn") << QString("Rook") << QString("Pawn"), "piecesRemaining");
+	chess->removeObjectsFromListForKey(QVariantList() << QString("Pawn") << QString("Pawn"), "piecesRemaining");
+	QCOMPARE(chess->objectForKey("piecesRemaining").toList(), QVariantList() << QString("Rook"));
+	chess->removeObjectFromListForKey(PFObject::objectWithClassName("ChessPiece", "kingId"), "pieces");
+	QCOMPARE(chess->objectForKey("pieces").toList().count(), 2);
+}
+
+void TestPFObject::test_listForKeyLargeListBenchmark()
+{
+	// Build a long tag list and a long list of tags to add that half overlaps it
+	QVariantList tags;
+	QVariantList moreTags;
+	for (int i = 0; i < 5000; ++i)
+	{
+		tags.append(QString("tag_%1").arg(i));
+		moreTags.append(QString("tag_%1").arg(i + 2500));
+	}
+
+	QBENCHMARK
+	{
+		PFObjectPtr post = PFObject::objectWithClassName("Post");
+		post->setObjectForKey(tags, "tags");
+		post->addUniqueObjectsToListForKey(moreTags, "tags");
+		post->removeObjectsFromListForKey(moreTags, "tags");
+	}
+}
+
 void TestPFObject::test_setACL()
 {
 	// Create a level and verify the ACL is empty by default
@@ -7,13 +7,40 @@
 //
 
 #include "PFError.h"
+#include "PFManager.h"
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
 #include "PFObject.h"
 #include "PFQuery.h"
 #include "PFUser.h"
 #include "TestRunner.h"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrlQuery>
+
 using namespace parse;
 
+// Answers every request itself, recording the urls of the requests
+class LookupInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	LookupInterceptor(int statusCode, const QByteArray& data) : _statusCode(statusCode), _data(data) {}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		_urls.append(context.request.url());
+		context.reply = PFNetworkReply::replyWithData(context.request, context.operation, _statusCode, _data);
+	}
+
+	int						_statusCode;
+	QByteArray				_data;
+	QList<QUrl>				_urls;
+};
+
 class TestPFQuery : public QObject
 {
     Q_OBJECT
@@ -135,6 +162,10 @@ private slots:
 		_findObjectsError = PFErrorPtr();
 		_objectCount = -1;
 		_objectCountError = PFErrorPtr();
+
+		PFNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+		foreach (PFNetworkInterceptorPtr interceptor, networkAccessManager->interceptors())
+			networkAccessManager->removeInterceptor(interceptor);
 	}
 
 	// Creation Methods
@@ -177,6 +208,11 @@ private slots:
 	void test_getObjectWithId();
 	void test_getObjectWithIdWithError();
 	void test_getObjectWithIdInBackground();
+	void test_objectIdLookupRequests();
+	void test_getObjectWithIdMissingObject();
+
+	// Get Objects Methods
+	void test_getObjectsWithIds();
 
 	// Get User Methods
 	void test_getUserWithId();
@@ -887,6 +923,174 @@ void TestPFQuery::test_getObjectWithIdInBackground()
 	QCOMPARE(umpire->objectForKey("sport").toString(), QString("Baseball"));
 }
 
+void TestPFQuery::test_getObjectWithIdMissingObject()
+{
+	// The cloud answers the direct lookup of a missing object with an object not found error
+	QSharedPointer<LookupInterceptor> lookup = QSharedPointer<LookupInterceptor>(
+		new LookupInterceptor(404, "{\"code\":101,\"error\":\"object not found for get\"}"));
+	PFManager::sharedManager()->networkAccessManager()->addInterceptor(lookup);
+
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(getObjectEnded()), &eventLoop, SLOT(quit()));
+	for (int i = 0; i < 2; ++i)
+	{
+		// Both the cloud and the local datastore hand back a null object without an error
+		bool fromLocalDatastore = (i == 1);
+		PFQueryPtr query = PFQuery::queryWithClassName("NoSuchClass");
+		if (fromLocalDatastore)
+			query->fromLocalDatastore();
+
+		PFErrorPtr error;
+		QCOMPARE(query->getObjectWithId("missing", error).isNull(), true);
+		QCOMPARE(error.isNull(), true);
+
+		_getObject = PFObjectPtr();
+		_getObjectError = PFErrorPtr();
+		query->getObjectWithIdInBackground("missing", this, SLOT(getObjectCompleted(PFObjectPtr, PFErrorPtr)));
+		eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+		QCOMPARE(_getObject.isNull(), true);
+		QCOMPARE(_getObjectError.isNull(), true);
+	}
+
+	// Only the cloud lookups went out over the network
+	QCOMPARE(lookup->_urls.count(), 2);
+	PFManager::sharedManager()->networkAccessManager()->removeInterceptor(lookup);
+}
+
+void TestPFQuery::test_objectIdLookupRequests()
+{
+	QSharedPointer<LookupInterceptor> lookup = QSharedPointer<LookupInterceptor>(
+		new LookupInterceptor(200, "{\"objectId\":\"1234\",\"name\":\"Baseball\"}"));
+	PFManager::sharedManager()->networkAccessManager()->addInterceptor(lookup);
+
+	// Lookups by object id get the object directly and keep the include and select keys
+	PFQueryPtr query = PFQuery::queryWithClassName("Sport");
+	query->includeKey("official");
+	query->selectKeys(QStringList() << "name");
+	query->orderByAscending("name");
+	PFObjectPtr baseball = query->getObjectWithId("1234");
+	QCOMPARE(baseball.isNull(), false);
+	QCOMPARE(baseball->objectId(), QString("1234"));
+	QCOMPARE(baseball->objectForKey("name").toString(), QString("Baseball"));
+	QUrl url = lookup->_urls.last();
+	QCOMPARE(url.path(), QString("/1/classes/Sport/1234"));
+	QCOMPARE(QUrlQuery(url).queryItemValue("include"), QString("official"));
+	QCOMPARE(QUrlQuery(url).queryItemValue("keys"), QString("name"));
+	QCOMPARE(QUrlQuery(url).hasQueryItem("where"), false);
+	QCOMPARE(QUrlQuery(url).hasQueryItem("order"), false);
+
+	// So do finds constrained to an object id and nothing else
+	query = PFQuery::queryWithClassName("Sport");
+	query->whereKeyEqualTo("objectId", QString("1234"));
+	QCOMPARE(query->findObjects().count(), 1);
+	QCOMPARE(lookup->_urls.last().path(), QString("/1/classes/Sport/1234"));
+
+	// Any other constraint, skipping or counting needs the query
+	query->whereKeyEqualTo("name", QString("Baseball"));
+	query->findObjects();
+	QCOMPARE(lookup->_urls.last().path(), QString("/1/classes/Sport"));
+	QCOMPARE(QUrlQuery(lookup->_urls.last()).hasQueryItem("where"), true);
+	query = PFQuery::queryWithClassName("Sport");
+	query->whereKeyEqualTo("objectId", QString("1234"));
+	query->countObjects();
+	QCOMPARE(lookup->_urls.last().path(), QString("/1/classes/Sport"));
+
+	// Users have an endpoint of their own
+	PFQuery::getUserWithId("1234");
+	QCOMPARE(lookup->_urls.last().path(), QString("/1/users/1234"));
+
+	// Several object ids share one query
+	query = PFQuery::queryWithClassName("Sport");
+	query->getObjectsWithIds(QStringList() << "1234" << "5678" << "1234");
+	url = lookup->_urls.last();
+	QCOMPARE(url.path(), QString("/1/classes/Sport"));
+	QJsonObject where = QJsonDocument::fromJson(QUrlQuery(url).queryItemValue("where", QUrl::FullyDecoded).toUtf8()).object();
+	QCOMPARE(where["objectId"].toObject()["$in"].toArray().count(), 2);
+	QCOMPARE(QUrlQuery(url).queryItemValue("limit"), QString("2"));
+
+	// Lookups over the maximum limit get split into several queries
+	QStringList objectIds;
+	for (int i = 0; i < 2500; ++i)
+		objectIds.append(QString("id%1").arg(i));
+	int requestCount = lookup->_urls.count();
+	query = PFQuery::queryWithClassName("Sport");
+	QCOMPARE(query->getObjectsWithIds(objectIds).count(), 3);
+	QCOMPARE(lookup->_urls.count(), requestCount + 3);
+	QCOMPARE(QUrlQuery(lookup->_urls.at(requestCount)).queryItemValue("limit"), QString("1000"));
+	QCOMPARE(QUrlQuery(lookup->_urls.last()).queryItemValue("limit"), QString("500"));
+
+	// The same goes for background lookups
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(findObjectsEnded()), &eventLoop, SLOT(quit()));
+	requestCount = lookup->_urls.count();
+	query->getObjectsWithIdsInBackground(objectIds, this, SLOT(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_findObjectsError.isNull(), true);
+	QCOMPARE(_findObjects.count(), 3);
+	QCOMPARE(lookup->_urls.count(), requestCount + 3);
+	PFManager::sharedManager()->networkAccessManager()->removeInterceptor(lookup);
+
+	// Missing objects come back empty the way the query did
+	lookup = QSharedPointer<LookupInterceptor>(new LookupInterceptor(404, "{\"code\":101,\"error\":\"object not found for get\"}"));
+	PFManager::sharedManager()->networkAccessManager()->addInterceptor(lookup);
+	PFErrorPtr error;
+	query = PFQuery::queryWithClassName("Sport");
+	QCOMPARE(query->getObjectWithId("1234", error).isNull(), true);
+	QCOMPARE(error.isNull(), true);
+
+	// Queries still report the error
+	query->whereKeyEqualTo("name", QString("Baseball"));
+	QCOMPARE(query->findObjects(error).isEmpty(), true);
+	QCOMPARE(error.isNull(), false);
+	QCOMPARE(error->errorCode(), kPFErrorObjectNotFound);
+
+	// Looking up no object ids doesn't send a request at all
+	requestCount = lookup->_urls.count();
+	error = PFErrorPtr();
+	QCOMPARE(query->getObjectsWithIds(QStringList(), error).isEmpty(), true);
+	QCOMPARE(error.isNull(), true);
+	_findObjects.append(PFObject::objectWithClassName("Sport"));
+	query->getObjectsWithIdsInBackground(QStringList(), this, SLOT(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_findObjects.isEmpty(), true);
+	QCOMPARE(_findObjectsError.isNull(), true);
+	QCOMPARE(lookup->_urls.count(), requestCount);
+	PFManager::sharedManager()->networkAccessManager()->removeInterceptor(lookup);
+}
+
+void TestPFQuery::test_getObjectsWithIds()
+{
+	// Valid Case - the officials, an object id that doesn't exist and a duplicate
+	QStringList objectIds;
+	for (int i = 0; i < 3; ++i)
+		objectIds.append(_objects.at(i)->objectId());
+	objectIds << "TheresNoPossibleWayToGetMe" << _umpire->objectId();
+	PFErrorPtr error;
+	PFQueryPtr query = PFQuery::queryWithClassName("Official");
+	PFObjectList officials = query->getObjectsWithIds(objectIds, error);
+	QCOMPARE(error.isNull(), true);
+	QCOMPARE(officials.count(), 3);
+	foreach (PFObjectPtr official, officials)
+	{
+		QCOMPARE(official->className(), QString("Official"));
+		QCOMPARE(objectIds.contains(official->objectId()), true);
+	}
+
+	// Valid Case - a single object id
+	officials = query->getObjectsWithIds(QStringList() << _umpire->objectId(), error);
+	QCOMPARE(error.isNull(), true);
+	QCOMPARE(officials.count(), 1);
+	QCOMPARE(officials.first()->objectForKey("name").toString(), QString("Umpire"));
+
+	// Valid Case - in the background
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(findObjectsEnded()), &eventLoop, SLOT(quit()));
+	query->getObjectsWithIdsInBackground(objectIds, this, SLOT(findObjectsCompleted(PFObjectList, PFErrorPtr)));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_findObjectsError.isNull(), true);
+	QCOMPARE(_findObjects.count(), 3);
+}
+
 void TestPFQuery::test_getUserWithId()
 {
 	// Create a test user
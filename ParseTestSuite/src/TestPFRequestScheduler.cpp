@@ -0,0 +1,189 @@
+//
+//  TestPFRequestScheduler.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
+#include "PFRequestScheduler.h"
+#include "TestRunner.h"
+
+#include <QElapsedTimer>
+#include <QStringList>
+
+using namespace parse;
+
+// Answers every request with the status, recording the order they were sent in
+class SendOrderInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	SendOrderInterceptor(QStringList* sendOrder, int firstStatusCode = 200) :
+		_sendOrder(sendOrder), _firstStatusCode(firstStatusCode) {}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		int statusCode = _sendOrder->isEmpty() ? _firstStatusCode : 200;
+		_sendOrder->append(context.request.url().path());
+		context.reply = PFNetworkReply::replyWithData(context.request, context.operation, statusCode, "{}");
+	}
+
+	QStringList*		_sendOrder;
+	int					_firstStatusCode;
+};
+
+class TestPFRequestScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Token Bucket Methods
+	void test_unlimitedByDefault();
+	void test_tokenBucket();
+
+	// Priority Methods
+	void test_priorityForRequest();
+	void test_queuesShareTokensByWeight();
+
+	// Rejection Methods
+	void test_rejectedRequestPausesQueue();
+
+private:
+
+	// Helper Methods
+	static void waitForReplies(const QList<QNetworkReply*>& replies);
+};
+
+void TestPFRequestScheduler::waitForReplies(const QList<QNetworkReply*>& replies)
+{
+	foreach (QNetworkReply* reply, replies)
+	{
+		QEventLoop eventLoop;
+		QObject::connect(reply, SIGNAL(finished()), &eventLoop, SLOT(quit()));
+		if (!reply->isFinished())
+			eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	}
+}
+
+void TestPFRequestScheduler::test_unlimitedByDefault()
+{
+	PFRequestScheduler requestScheduler;
+	QCOMPARE(requestScheduler.requestsPerSecond(), 0.0);
+	for (int i = 0; i < 1000; ++i)
+		QCOMPARE(requestScheduler.tryAcquire(), true);
+}
+
+void TestPFRequestScheduler::test_tokenBucket()
+{
+	PFRequestScheduler requestScheduler;
+	requestScheduler.setRequestsPerSecond(10.0);
+	QCOMPARE(requestScheduler.burstSize(), 10);
+	requestScheduler.setBurstSize(3);
+
+	// The bucket starts out full and refills at the rate
+	QCOMPARE(requestScheduler.tryAcquire(), true);
+	QCOMPARE(requestScheduler.tryAcquire(), true);
+	QCOMPARE(requestScheduler.tryAcquire(), true);
+	QCOMPARE(requestScheduler.tryAcquire(), false);
+	QTest::qWait(150);
+	QCOMPARE(requestScheduler.tryAcquire(), true);
+	QCOMPARE(requestScheduler.tryAcquire(), false);
+
+	// Nothing goes out while the requests are held
+	requestScheduler.setRequestsPerSecond(0.0);
+	requestScheduler.pause(100);
+	QCOMPARE(requestScheduler.tryAcquire(), false);
+	QTest::qWait(150);
+	QCOMPARE(requestScheduler.tryAcquire(), true);
+}
+
+void TestPFRequestScheduler::test_priorityForRequest()
+{
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore/1234"));
+	QCOMPARE(PFRequestScheduler::priorityForRequest(request), PFRequestScheduler::Interactive);
+	request.setUrl(QUrl("https://api.parse.com/1/batch"));
+	QCOMPARE(PFRequestScheduler::priorityForRequest(request), PFRequestScheduler::Bulk);
+	request.setUrl(QUrl("https://api.parse.com/1/files/image.png"));
+	QCOMPARE(PFRequestScheduler::priorityForRequest(request), PFRequestScheduler::Background);
+
+	// An explicit priority wins
+	PFRequestScheduler::setPriorityForRequest(request, PFRequestScheduler::Interactive);
+	QCOMPARE(PFRequestScheduler::priorityForRequest(request), PFRequestScheduler::Interactive);
+}
+
+void TestPFRequestScheduler::test_queuesShareTokensByWeight()
+{
+	QStringList sendOrder;
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new SendOrderInterceptor(&sendOrder)));
+	networkAccessManager.requestScheduler()->setRequestsPerSecond(50.0);
+	networkAccessManager.requestScheduler()->setBurstSize(1);
+
+	// The first request takes the only token, a saveAll worth of batches queues up before the fetches
+	QList<QNetworkReply*> replies;
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore/first"));
+	replies.append(networkAccessManager.get(request));
+	request.setUrl(QUrl("https://api.parse.com/1/batch"));
+	for (int i = 0; i < 6; ++i)
+		replies.append(networkAccessManager.post(request, QByteArray("{\"requests\":[]}")));
+	for (int i = 0; i < 3; ++i)
+	{
+		request.setUrl(QUrl(QString("https://api.parse.com/1/classes/GameScore/%1").arg(i)));
+		replies.append(networkAccessManager.get(request));
+	}
+	QCOMPARE(sendOrder.count(), 1);
+	QCOMPARE(networkAccessManager.requestScheduler()->queuedCount(), 9);
+
+	waitForReplies(replies);
+	QCOMPARE(sendOrder.count(), 10);
+
+	// The fetches get 4 of every 5 tokens while the batches keep moving
+	QStringList queuedOrder = sendOrder.mid(1);
+	int lastFetchIndex = queuedOrder.lastIndexOf(QRegExp("/1/classes/GameScore/\\d"));
+	QCOMPARE(lastFetchIndex, 3);
+	QCOMPARE(queuedOrder.indexOf("/1/batch") < lastFetchIndex, true);
+
+	qDeleteAll(replies);
+}
+
+void TestPFRequestScheduler::test_rejectedRequestPausesQueue()
+{
+	QStringList sendOrder;
+	PFNetworkAccessManager networkAccessManager;
+	networkAccessManager.setRetryPolicy(PFRetryPolicy::noRetryPolicy());
+	networkAccessManager.addInterceptor(PFNetworkInterceptorPtr(new SendOrderInterceptor(&sendOrder, 429)));
+
+	QNetworkRequest request(QUrl("https://api.parse.com/1/classes/GameScore"));
+	QNetworkReply* rejectedReply = networkAccessManager.post(request, QByteArray("{\"score\":1}"));
+	waitForReplies(QList<QNetworkReply*>() << rejectedReply);
+	QCOMPARE(rejectedReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 429);
+
+	// The next request waits out the second the server didn't say anything else about
+	QElapsedTimer timer;
+	timer.start();
+	QNetworkReply* reply = networkAccessManager.post(request, QByteArray("{\"score\":2}"));
+	QCOMPARE(sendOrder.count(), 1);
+	waitForReplies(QList<QNetworkReply*>() << reply);
+	QCOMPARE(reply->error(), QNetworkReply::NoError);
+	QCOMPARE(sendOrder.count(), 2);
+	QVERIFY(timer.elapsed() >= 900);
+
+	delete rejectedReply;
+	delete reply;
+}
+
+DECLARE_TEST(TestPFRequestScheduler)
+#include "TestPFRequestScheduler.moc"
@@ -0,0 +1,151 @@
+//
+//  TestPFRetryPolicy.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFError.h"
+#include "PFRetryPolicy.h"
+#include "TestRunner.h"
+
+using namespace parse;
+
+class TestPFRetryPolicy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup() {}
+
+	// Settings Methods
+	void test_defaults();
+	void test_noRetryPolicy();
+	void test_settingsAreClamped();
+
+	// Backoff Methods
+	void test_backoffGrowsExponentially();
+	void test_backoffJitter();
+
+	// Classification Methods
+	void test_isIdempotent();
+	void test_isTransientFailure();
+};
+
+void TestPFRetryPolicy::test_defaults()
+{
+	PFRetryPolicy retryPolicy;
+	QCOMPARE(retryPolicy.maximumAttempts(), 3);
+	QCOMPARE(retryPolicy.initialBackoff(), 200);
+	QCOMPARE(retryPolicy.maximumBackoff(), 5000);
+	QCOMPARE(retryPolicy.backoffMultiplier(), 2.0);
+	QCOMPARE(retryPolicy.jitter(), 0.5);
+	QCOMPARE(retryPolicy.circuitBreakerEnabled(), true);
+	QCOMPARE(retryPolicy.failureRateThreshold(), 0.5);
+	QCOMPARE(retryPolicy.failureWindowSize(), 20);
+	QCOMPARE(retryPolicy.minimumRequestCount(), 10);
+	QCOMPARE(retryPolicy.openDuration(), 30000);
+}
+
+void TestPFRetryPolicy::test_noRetryPolicy()
+{
+	PFRetryPolicy retryPolicy = PFRetryPolicy::noRetryPolicy();
+	QCOMPARE(retryPolicy.maximumAttempts(), 1);
+	QCOMPARE(retryPolicy.circuitBreakerEnabled(), false);
+}
+
+void TestPFRetryPolicy::test_settingsAreClamped()
+{
+	PFRetryPolicy retryPolicy;
+	retryPolicy.setMaximumAttempts(0);
+	retryPolicy.setInitialBackoff(-10);
+	retryPolicy.setBackoffMultiplier(0.5);
+	retryPolicy.setJitter(2.0);
+	retryPolicy.setFailureRateThreshold(-1.0);
+	retryPolicy.setFailureWindowSize(0);
+	QCOMPARE(retryPolicy.maximumAttempts(), 1);
+	QCOMPARE(retryPolicy.initialBackoff(), 0);
+	QCOMPARE(retryPolicy.backoffMultiplier(), 1.0);
+	QCOMPARE(retryPolicy.jitter(), 1.0);
+	QCOMPARE(retryPolicy.failureRateThreshold(), 0.0);
+	QCOMPARE(retryPolicy.failureWindowSize(), 1);
+}
+
+void TestPFRetryPolicy::test_backoffGrowsExponentially()
+{
+	PFRetryPolicy retryPolicy;
+	retryPolicy.setJitter(0.0);
+	QCOMPARE(retryPolicy.backoffForAttempt(1, 0.5), 200);
+	QCOMPARE(retryPolicy.backoffForAttempt(2, 0.5), 400);
+	QCOMPARE(retryPolicy.backoffForAttempt(3, 0.5), 800);
+	QCOMPARE(retryPolicy.backoffForAttempt(5, 0.5), 3200);
+
+	// Capped at the maximum backoff
+	QCOMPARE(retryPolicy.backoffForAttempt(6, 0.5), 5000);
+	QCOMPARE(retryPolicy.backoffForAttempt(60, 0.5), 5000);
+}
+
+void TestPFRetryPolicy::test_backoffJitter()
+{
+	// The jitter takes up to its share off the backoff
+	PFRetryPolicy retryPolicy;
+	QCOMPARE(retryPolicy.backoffForAttempt(2, 0.0), 400);
+	QCOMPARE(retryPolicy.backoffForAttempt(2, 0.5), 300);
+	QCOMPARE(retryPolicy.backoffForAttempt(2, 0.999), 200);
+
+	retryPolicy.setJitter(1.0);
+	QCOMPARE(retryPolicy.backoffForAttempt(2, 0.75), 100);
+}
+
+void TestPFRetryPolicy::test_isIdempotent()
+{
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::GetOperation, QByteArray()), true);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::HeadOperation, QByteArray()), true);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::DeleteOperation, QByteArray()), true);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PostOperation, QByteArray("{\"score\":1}")), false);
+
+	// Updates are only idempotent when they set values rather than add to them
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PutOperation, QByteArray("{\"score\":1}")), true);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PutOperation,
+										 QByteArray("{\"tags\":{\"__op\":\"AddUnique\",\"objects\":[\"chess\"]}}")), true);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PutOperation,
+										 QByteArray("{\"score\":{\"__op\":\"Increment\",\"amount\":1}}")), false);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PutOperation,
+										 QByteArray("{\"tags\":{\"__op\":\"Add\",\"objects\":[\"chess\"]}}")), false);
+	QCOMPARE(PFRetryPolicy::isIdempotent(QNetworkAccessManager::PutOperation,
+										 QByteArray("{\"score\":{\"__op\":\"Batch\",\"ops\":[{\"__op\":\"Increment\",\"amount\":1}]}}")), false);
+}
+
+void TestPFRetryPolicy::test_isTransientFailure()
+{
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::NoError, 200), false);
+
+	// Network errors
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::TimeoutError, 0), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::RemoteHostClosedError, 0), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::TemporaryNetworkFailureError, 0), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::OperationCanceledError, 0), false);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::SslHandshakeFailedError, 0), false);
+
+	// Http statuses
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::UnknownContentError, 503), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::UnknownContentError, 429), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::ContentNotFoundError, 404), false);
+
+	// Parse errors win over the status
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::UnknownContentError, 500, kPFErrorInternalServer), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::ProtocolInvalidOperationError, 400, kPFErrorTimeout), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::ProtocolInvalidOperationError, 400, kPFErrorConnectionFailed), true);
+	QCOMPARE(PFRetryPolicy::isTransientFailure(QNetworkReply::UnknownContentError, 500, kPFErrorObjectNotFound), false);
+}
+
+DECLARE_TEST(TestPFRetryPolicy)
+#include "TestPFRetryPolicy.moc"
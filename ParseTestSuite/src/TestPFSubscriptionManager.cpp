@@ -0,0 +1,230 @@
+//
+//  TestPFSubscriptionManager.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFError.h"
+#include "PFObject.h"
+#include "PFQuery.h"
+#include "PFSubscriptionManager.h"
+#include "TestRunner.h"
+
+using namespace parse;
+
+class TestPFSubscriptionManager : public QObject
+{
+    Q_OBJECT
+
+public slots:
+
+	void resultsChanged(PFObjectList created, PFObjectList updated, QStringList deletedObjectIds)
+	{
+		_created = created;
+		_updated = updated;
+		_deletedObjectIds = deletedObjectIds;
+		++_notificationCount;
+		emit resultsEnded();
+	}
+
+signals:
+
+	void resultsEnded();
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		// Poll quickly so the tests don't take forever
+		PFSubscriptionManager::sharedManager()->setPollingIntervals(500, 2000);
+
+		// Create some players to watch
+		QStringList names;
+		names << "Pitcher" << "Catcher";
+		foreach (const QString& name, names)
+		{
+			PFObjectPtr player = PFObject::objectWithClassName("SubscriptionPlayer");
+			player->setObjectForKey(name, "position");
+			_objects.append(player);
+		}
+
+		QCOMPARE(PFObject::saveAll(_objects), true);
+	}
+
+	void cleanupTestCase()
+	{
+		PFSubscriptionManager::sharedManager()->unsubscribeAll(this);
+		PFObject::deleteAllObjects(_objects);
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		_created.clear();
+		_updated.clear();
+		_deletedObjectIds.clear();
+		_notificationCount = 0;
+	}
+
+	void cleanup()
+	{
+		PFSubscriptionManager::sharedManager()->unsubscribeAll(this);
+	}
+
+	// Creation Methods
+	void test_sharedManager();
+
+	// Subscription Methods
+	void test_subscribe();
+	void test_subscribeDeduplicatesQueries();
+	void test_unsubscribe();
+	void test_subscriberDestroyed();
+
+	// Diffing
+	void test_resultsChanged();
+
+private:
+
+	// Instance members
+	PFObjectList	_objects;
+
+	// Instance members for callbacks
+	PFObjectList	_created;
+	PFObjectList	_updated;
+	QStringList		_deletedObjectIds;
+	int				_notificationCount;
+};
+
+void TestPFSubscriptionManager::test_sharedManager()
+{
+	PFSubscriptionManager* manager1 = PFSubscriptionManager::sharedManager();
+	PFSubscriptionManager* manager2 = PFSubscriptionManager::sharedManager();
+	QCOMPARE(manager1, manager2);
+	QCOMPARE(manager1->minimumInterval(), 500);
+	QCOMPARE(manager1->maximumInterval(), 2000);
+}
+
+void TestPFSubscriptionManager::test_subscribe()
+{
+	PFSubscriptionManager* manager = PFSubscriptionManager::sharedManager();
+	PFQueryPtr query = PFQuery::queryWithClassName("SubscriptionPlayer");
+
+	// Invalid Cases
+	QCOMPARE(manager->subscribe(PFQueryPtr(), this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), false);
+	QCOMPARE(manager->subscribe(query, NULL, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), false);
+
+	// Valid Case
+	QCOMPARE(manager->subscribe(query, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), true);
+	QCOMPARE(manager->subscriptionCount(), 1);
+
+	// Invalid Case - already subscribed
+	QCOMPARE(manager->subscribe(query, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), false);
+
+	// The first notification contains all the current results
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(resultsEnded()), &eventLoop, SLOT(quit()));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_created.count(), 2);
+	QCOMPARE(_updated.count(), 0);
+	QCOMPARE(_deletedObjectIds.count(), 0);
+}
+
+void TestPFSubscriptionManager::test_subscribeDeduplicatesQueries()
+{
+	PFSubscriptionManager* manager = PFSubscriptionManager::sharedManager();
+	QTimer otherSubscriber;
+
+	// Build the same query twice with the constraints added in a different order
+	PFQueryPtr query1 = PFQuery::queryWithClassName("SubscriptionPlayer");
+	query1->includeKey("team");
+	query1->includeKey("league");
+	query1->whereKeyExists("position");
+	PFQueryPtr query2 = PFQuery::queryWithClassName("SubscriptionPlayer");
+	query2->whereKeyExists("position");
+	query2->includeKey("league");
+	query2->includeKey("team");
+	QCOMPARE(query1->serializedQuery(), query2->serializedQuery());
+
+	// Both subscribers should share a single subscription
+	QCOMPARE(manager->subscribe(query1, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), true);
+	QCOMPARE(manager->subscribe(query2, &otherSubscriber, SLOT(stop())), true);
+	QCOMPARE(manager->subscriptionCount(), 1);
+
+	// A different query gets its own subscription
+	PFQueryPtr query3 = PFQuery::queryWithClassName("SubscriptionPlayer");
+	query3->whereKeyEqualTo("position", QString("Pitcher"));
+	QCOMPARE(manager->subscribe(query3, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList))), true);
+	QCOMPARE(manager->subscriptionCount(), 2);
+
+	manager->unsubscribeAll(&otherSubscriber);
+}
+
+void TestPFSubscriptionManager::test_unsubscribe()
+{
+	PFSubscriptionManager* manager = PFSubscriptionManager::sharedManager();
+	PFQueryPtr query = PFQuery::queryWithClassName("SubscriptionPlayer");
+	QTimer otherSubscriber;
+
+	manager->subscribe(query, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList)));
+	manager->subscribe(query, &otherSubscriber, SLOT(stop()));
+	QCOMPARE(manager->subscriptionCount(), 1);
+
+	// The subscription should stay around until the last subscriber leaves
+	manager->unsubscribe(query, this);
+	QCOMPARE(manager->subscriptionCount(), 1);
+	manager->unsubscribe(query, &otherSubscriber);
+	QCOMPARE(manager->subscriptionCount(), 0);
+}
+
+void TestPFSubscriptionManager::test_subscriberDestroyed()
+{
+	PFSubscriptionManager* manager = PFSubscriptionManager::sharedManager();
+	PFQueryPtr query = PFQuery::queryWithClassName("SubscriptionPlayer");
+
+	QObject* subscriber = new QObject();
+	manager->subscribe(query, subscriber, SLOT(deleteLater()));
+	QCOMPARE(manager->subscriptionCount(), 1);
+
+	delete subscriber;
+	QCOMPARE(manager->subscriptionCount(), 0);
+}
+
+void TestPFSubscriptionManager::test_resultsChanged()
+{
+	PFSubscriptionManager* manager = PFSubscriptionManager::sharedManager();
+	PFQueryPtr query = PFQuery::queryWithClassName("SubscriptionPlayer");
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(resultsEnded()), &eventLoop, SLOT(quit()));
+
+	// Wait for the initial results
+	manager->subscribe(query, this, SLOT(resultsChanged(PFObjectList, PFObjectList, QStringList)));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_created.count(), 2);
+
+	// Update a player and make sure only the update comes through
+	PFObjectPtr pitcher = _objects.at(0);
+	pitcher->setObjectForKey(QString("Relief Pitcher"), "position");
+	QCOMPARE(pitcher->save(), true);
+	manager->refresh(query);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_created.count(), 0);
+	QCOMPARE(_updated.count(), 1);
+	QCOMPARE(_updated.at(0)->objectId(), pitcher->objectId());
+	QCOMPARE(_deletedObjectIds.count(), 0);
+
+	// Delete a player and make sure the deletion comes through
+	PFObjectPtr catcher = _objects.takeLast();
+	QString catcherObjectId = catcher->objectId();
+	QCOMPARE(catcher->deleteObject(), true);
+	manager->refresh(query);
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_created.count(), 0);
+	QCOMPARE(_updated.count(), 0);
+	QCOMPARE(_deletedObjectIds, QStringList() << catcherObjectId);
+}
+
+DECLARE_TEST(TestPFSubscriptionManager)
+#include "TestPFSubscriptionManager.moc"
@@ -0,0 +1,320 @@
+//
+//  TestPFSyncEngine.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFDateTime.h"
+#include "PFError.h"
+#include "PFManager.h"
+#include "PFNetworkAccessManager.h"
+#include "PFNetworkInterceptor.h"
+#include "PFNetworkReply.h"
+#include "PFObject.h"
+#include "PFSyncEngine.h"
+#include "TestRunner.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrlQuery>
+
+using namespace parse;
+
+// Answers the delta queries out of a class of its own, every three objects share an updatedAt so the pages
+// split objects with the same timestamp
+class PagingServerInterceptor : public PFNetworkInterceptor
+{
+public:
+
+	PagingServerInterceptor(int objectCount) : _requestCount(0)
+	{
+		QDateTime startDateTime = QDateTime(QDate(2014, 1, 1), QTime(0, 0), Qt::UTC);
+		for (int i = 0; i < objectCount; ++i)
+		{
+			_objectIds.append(QString("obj%1").arg(i, 5, 10, QChar('0')));
+			_updatedAts.append(startDateTime.addMSecs(i / 3));
+		}
+	}
+
+	// Updates the object, which moves it to the end of the updatedAt order
+	void touchObject(int index)
+	{
+		QDateTime updatedAt = _updatedAts.last().addMSecs(1);
+		_objectIds.append(_objectIds.takeAt(index));
+		_updatedAts.removeAt(index);
+		_updatedAts.append(updatedAt);
+	}
+
+	virtual void willSendRequest(PFNetworkContext& context)
+	{
+		// Only the updatedAt constraint, ordering and paging the sync engine sends
+		QUrlQuery urlQuery(context.request.url());
+		QJsonObject where = QJsonDocument::fromJson(urlQuery.queryItemValue("where", QUrl::FullyDecoded).toUtf8()).object();
+		QJsonObject updatedAtConstraint = where["updatedAt"].toObject();
+		bool isInclusive = updatedAtConstraint.contains("$gte");
+		QString iso = updatedAtConstraint[isInclusive ? "$gte" : "$gt"].toObject()["iso"].toString();
+		QDateTime watermark = iso.isEmpty() ? QDateTime() : PFDateTime::dateTimeFromParseString(iso)->dateTime();
+		int skip = urlQuery.queryItemValue("skip").toInt();
+		int limit = urlQuery.queryItemValue("limit").toInt();
+
+		QJsonArray results;
+		for (int i = 0; i < _objectIds.count() && results.count() < limit; ++i)
+		{
+			const QDateTime& updatedAt = _updatedAts.at(i);
+			if (watermark.isValid() && (updatedAt < watermark || (!isInclusive && updatedAt == watermark)))
+				continue;
+			if (skip > 0)
+			{
+				--skip;
+				continue;
+			}
+
+			QJsonObject result;
+			result["objectId"] = _objectIds.at(i);
+			result["createdAt"] = PFDateTime::dateTimeFromDateTime(_updatedAts.first())->toParseString();
+			result["updatedAt"] = PFDateTime::dateTimeFromDateTime(updatedAt)->toParseString();
+			results.append(result);
+		}
+
+		QJsonObject rootObject;
+		rootObject["results"] = results;
+		context.reply = PFNetworkReply::replyWithData(context.request, context.operation, 200, QJsonDocument(rootObject).toJson());
+
+		// The object changes while the sync is still paging
+		if (_requestCount++ == 0)
+			touchObject(5);
+	}
+
+	QStringList				_objectIds;
+	QList<QDateTime>		_updatedAts;
+	int						_requestCount;
+};
+
+class TestPFSyncEngine : public QObject
+{
+    Q_OBJECT
+
+public slots:
+
+	void syncCompleted(bool succeeded, PFErrorPtr error)
+	{
+		_syncSucceeded = succeeded;
+		_syncError = error;
+		emit syncEnded();
+	}
+
+signals:
+
+	void syncEnded();
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		// Create some teams to sync
+		QStringList names;
+		names << "Broncos" << "Patriots" << "Seahawks";
+		foreach (const QString& name, names)
+		{
+			PFObjectPtr team = PFObject::objectWithClassName("SyncTeam");
+			team->setObjectForKey(name, "name");
+			_objects.append(team);
+		}
+
+		QCOMPARE(PFObject::saveAll(_objects), true);
+	}
+
+	void cleanupTestCase()
+	{
+		PFObject::deleteAllObjects(_objects);
+		PFSyncEngine::syncEngineWithClassName("SyncTeam")->reset();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		// Start every test with an empty store
+		PFSyncEngine::syncEngineWithClassName("SyncTeam")->reset();
+
+		// Reset the callback flags
+		_syncSucceeded = false;
+		_syncError = PFErrorPtr();
+		this->disconnect();
+	}
+
+	void cleanup() {}
+
+	// Creation Methods
+	void test_syncEngineWithClassName();
+
+	// Sync Methods
+	void test_sync();
+	void test_syncInBackground();
+	void test_syncDetectsDeletions();
+	void test_syncPagesThroughChanges();
+
+	// Local Store Methods
+	void test_persistence();
+	void test_reset();
+
+private:
+
+	// Instance members
+	PFObjectList	_objects;
+
+	// Instance members for sync callbacks
+	bool			_syncSucceeded;
+	PFErrorPtr		_syncError;
+};
+
+void TestPFSyncEngine::test_syncEngineWithClassName()
+{
+	// Invalid Case - empty class name
+	PFSyncEnginePtr invalidSyncEngine = PFSyncEngine::syncEngineWithClassName("");
+	QCOMPARE(invalidSyncEngine.isNull(), true);
+
+	// Valid Case
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	QCOMPARE(syncEngine.isNull(), false);
+	QCOMPARE(syncEngine->className(), QString("SyncTeam"));
+	QCOMPARE(syncEngine->watermark().isNull(), true);
+	QCOMPARE(syncEngine->count(), 0);
+	QCOMPARE(syncEngine->reconciliationInterval(), 10);
+}
+
+void TestPFSyncEngine::test_sync()
+{
+	// Initial sync pulls everything down
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	PFErrorPtr error;
+	QCOMPARE(syncEngine->sync(error), true);
+	QCOMPARE(error.isNull(), true);
+	QCOMPARE(syncEngine->count(), 3);
+	QCOMPARE(syncEngine->addedObjects().count(), 3);
+	QCOMPARE(syncEngine->changedObjects().count(), 0);
+	QCOMPARE(syncEngine->watermark().isNull(), false);
+	QCOMPARE(syncEngine->objectWithId(_objects.at(0)->objectId())->objectForKey("name").toString(), QString("Broncos"));
+
+	// Nothing changed so nothing should come down
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->addedObjects().count(), 0);
+	QCOMPARE(syncEngine->changedObjects().count(), 0);
+
+	// Update a team and make sure only that one comes down
+	PFObjectPtr broncos = _objects.at(0);
+	broncos->setObjectForKey(QString("Denver Broncos"), "name");
+	QCOMPARE(broncos->save(), true);
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->addedObjects().count(), 0);
+	QCOMPARE(syncEngine->changedObjects().count(), 1);
+	QCOMPARE(syncEngine->objectWithId(broncos->objectId())->objectForKey("name").toString(), QString("Denver Broncos"));
+	QCOMPARE(syncEngine->count(), 3);
+
+	// Put the name back
+	broncos->setObjectForKey(QString("Broncos"), "name");
+	QCOMPARE(broncos->save(), true);
+}
+
+void TestPFSyncEngine::test_syncInBackground()
+{
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(syncEnded()), &eventLoop, SLOT(quit()));
+
+	// Valid Case
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	QCOMPARE(syncEngine->syncInBackground(this, SLOT(syncCompleted(bool, PFErrorPtr))), true);
+
+	// Invalid Case - already syncing
+	QCOMPARE(syncEngine->syncInBackground(this, SLOT(syncCompleted(bool, PFErrorPtr))), false);
+
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_syncSucceeded, true);
+	QCOMPARE(_syncError.isNull(), true);
+	QCOMPARE(syncEngine->count(), 3);
+}
+
+void TestPFSyncEngine::test_syncDetectsDeletions()
+{
+	// Sync everything and check for deletions on every sync
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	syncEngine->setReconciliationInterval(1);
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->count(), 3);
+
+	// Delete one of the teams and make sure the reconciliation removes it
+	PFObjectPtr seahawks = _objects.takeLast();
+	QString seahawksObjectId = seahawks->objectId();
+	QCOMPARE(seahawks->deleteObject(), true);
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->count(), 2);
+	QCOMPARE(syncEngine->removedObjectIds(), QStringList() << seahawksObjectId);
+	QCOMPARE(syncEngine->objectWithId(seahawksObjectId).isNull(), true);
+}
+
+void TestPFSyncEngine::test_syncPagesThroughChanges()
+{
+	// More than two pages of changes without a network
+	QSharedPointer<PagingServerInterceptor> server = QSharedPointer<PagingServerInterceptor>(new PagingServerInterceptor(2500));
+	PFNetworkAccessManager* networkAccessManager = PFManager::sharedManager()->networkAccessManager();
+	networkAccessManager->addInterceptor(server);
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncPagingTeam");
+	syncEngine->reset();
+	syncEngine->setReconciliationInterval(0);
+
+	// Every object comes down once, the one changed while paging comes down again
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->count(), 2500);
+	QCOMPARE(syncEngine->addedObjects().count(), 2500);
+	QCOMPARE(syncEngine->changedObjects().count(), 1);
+	QCOMPARE(syncEngine->changedObjects().first()->objectId(), QString("obj00005"));
+	QCOMPARE(syncEngine->watermark()->dateTime(), server->_updatedAts.last());
+
+	// Nothing changed so nothing should come down
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->addedObjects().count(), 0);
+	QCOMPARE(syncEngine->changedObjects().count(), 0);
+
+	networkAccessManager->removeInterceptor(server);
+	syncEngine->reset();
+}
+
+void TestPFSyncEngine::test_persistence()
+{
+	// Sync then create a new engine which should load the persisted store
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	QCOMPARE(syncEngine->sync(), true);
+	PFSyncEnginePtr loadedSyncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	QCOMPARE(loadedSyncEngine->count(), syncEngine->count());
+	QCOMPARE(loadedSyncEngine->watermark()->toParseString(), syncEngine->watermark()->toParseString());
+
+	// Make sure the properties and instance members survived the round trip
+	PFObjectPtr loadedObject = loadedSyncEngine->objectWithId(_objects.at(0)->objectId());
+	QCOMPARE(loadedObject.isNull(), false);
+	QCOMPARE(loadedObject->className(), QString("SyncTeam"));
+	QCOMPARE(loadedObject->objectForKey("name").toString(), QString("Broncos"));
+	QCOMPARE(loadedObject->createdAt().isNull(), false);
+	QCOMPARE(loadedObject->updatedAt().isNull(), false);
+
+	// The loaded store is up to date so nothing should come down
+	QCOMPARE(loadedSyncEngine->sync(), true);
+	QCOMPARE(loadedSyncEngine->addedObjects().count(), 0);
+}
+
+void TestPFSyncEngine::test_reset()
+{
+	PFSyncEnginePtr syncEngine = PFSyncEngine::syncEngineWithClassName("SyncTeam");
+	QCOMPARE(syncEngine->sync(), true);
+	QCOMPARE(syncEngine->count() > 0, true);
+
+	syncEngine->reset();
+	QCOMPARE(syncEngine->count(), 0);
+	QCOMPARE(syncEngine->watermark().isNull(), true);
+	QCOMPARE(PFSyncEngine::syncEngineWithClassName("SyncTeam")->count(), 0);
+}
+
+DECLARE_TEST(TestPFSyncEngine)
+#include "TestPFSyncEngine.moc"
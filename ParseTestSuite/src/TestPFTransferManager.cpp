@@ -0,0 +1,233 @@
+//
+//  TestPFTransferManager.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFError.h"
+#include "PFFile.h"
+#include "PFManager.h"
+#include "PFTransferManager.h"
+#include "TestRunner.h"
+
+#include <QUuid>
+
+using namespace parse;
+
+class TestPFTransferManager : public QObject
+{
+    Q_OBJECT
+
+public slots:
+
+	void saveCompleted(bool succeeded, PFErrorPtr error)
+	{
+		Q_UNUSED(error);
+		PFFile* file = qobject_cast<PFFile*>(sender());
+		if (succeeded && file)
+			_completedNames.append(file->name());
+		if (++_completedCount == _expectedCount)
+			emit saveEnded();
+	}
+
+	void saveProgressUpdated(double percentDone)
+	{
+		Q_UNUSED(percentDone);
+		++_progressCount;
+	}
+
+signals:
+
+	void saveEnded();
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		_maximumConcurrentUploads = PFTransferManager::sharedManager()->maximumConcurrentUploads();
+		_data = QByteArrayPtr(new QByteArray(QString("Some sample data to test the transfer manager with").toUtf8()));
+	}
+
+	void cleanupTestCase()
+	{
+		PFTransferManager::sharedManager()->setMaximumConcurrentUploads(_maximumConcurrentUploads);
+		_data = QByteArrayPtr();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		_completedNames.clear();
+		_completedCount = 0;
+		_expectedCount = 0;
+		_progressCount = 0;
+	}
+
+	void cleanup()
+	{
+		PFTransferManager::sharedManager()->setMaximumConcurrentUploads(_maximumConcurrentUploads);
+	}
+
+	// Creation Methods
+	void test_sharedManager();
+
+	// Concurrency Methods
+	void test_maximumConcurrentUploads();
+	void test_priority();
+
+	// Group Methods
+	void test_cancelGroup();
+
+	// Progress Methods
+	void test_progressInterval();
+
+private:
+
+	// Helper Methods
+	QByteArrayPtr uniqueData()
+	{
+		// Identical contents would be deduplicated rather than uploaded which skips the scheduling we're testing
+		QByteArray data = *_data + QUuid::createUuid().toByteArray();
+		return QByteArrayPtr(new QByteArray(data));
+	}
+
+	// Instance members
+	QByteArrayPtr	_data;
+	int				_maximumConcurrentUploads;
+
+	// Instance members for callbacks
+	QStringList		_completedNames;
+	int				_completedCount;
+	int				_expectedCount;
+	int				_progressCount;
+};
+
+void TestPFTransferManager::test_sharedManager()
+{
+	PFTransferManager* manager1 = PFTransferManager::sharedManager();
+	PFTransferManager* manager2 = PFTransferManager::sharedManager();
+	QCOMPARE(manager1, manager2);
+	QCOMPARE(manager1->maximumConcurrentUploads(), 4);
+	QCOMPARE(manager1->maximumConcurrentDownloads(), 6);
+	QCOMPARE(manager1->progressInterval(), 100);
+}
+
+void TestPFTransferManager::test_maximumConcurrentUploads()
+{
+	PFTransferManager* manager = PFTransferManager::sharedManager();
+	manager->setMaximumConcurrentUploads(1);
+
+	// Queue up a few uploads
+	QList<PFFilePtr> files;
+	for (int i = 0; i < 3; ++i)
+	{
+		PFFilePtr file = PFFile::fileWithNameAndData(QString("transfer_%1.txt").arg(i), uniqueData());
+		QCOMPARE(file->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr))), true);
+		files.append(file);
+	}
+
+	// Nothing starts until we get back to the event loop, then only a single upload runs at a time
+	QCOMPARE(manager->queuedCount(), 3);
+	QCOMPARE(manager->activeCount(), 0);
+	QCoreApplication::processEvents();
+	QCOMPARE(manager->queuedCount(), 2);
+	QCOMPARE(manager->activeCount(), 1);
+
+	// Wait for them all to finish
+	_expectedCount = 3;
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(saveEnded()), &eventLoop, SLOT(quit()));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_completedNames.count(), 3);
+	QCOMPARE(manager->queuedCount(), 0);
+	QCOMPARE(manager->activeCount(), 0);
+}
+
+void TestPFTransferManager::test_priority()
+{
+	PFTransferManager::sharedManager()->setMaximumConcurrentUploads(1);
+
+	// Queue the files up in one order with different priorities
+	PFFilePtr normalFile = PFFile::fileWithNameAndData("normal.txt", uniqueData());
+	PFFilePtr prefetchFile = PFFile::fileWithNameAndData("prefetch.txt", uniqueData());
+	PFFilePtr visibleFile = PFFile::fileWithNameAndData("visible.txt", uniqueData());
+	PFFilePtr bumpedFile = PFFile::fileWithNameAndData("bumped.txt", uniqueData());
+	prefetchFile->setTransferPriority(PFTransferManager::PriorityPrefetch);
+	visibleFile->setTransferPriority(PFTransferManager::PriorityVisible);
+	bumpedFile->setTransferPriority(PFTransferManager::PriorityPrefetch);
+	normalFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+	prefetchFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+	visibleFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+	bumpedFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+
+	// Reprioritize one of them while it's still queued
+	bumpedFile->setTransferPriority(PFTransferManager::PriorityVisible);
+
+	// They should run from the highest to the lowest priority (first come first served within a priority)
+	_expectedCount = 4;
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(saveEnded()), &eventLoop, SLOT(quit()));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_completedNames.count(), 4);
+	QCOMPARE(_completedNames.at(0), visibleFile->name());
+	QCOMPARE(_completedNames.at(1), bumpedFile->name());
+	QCOMPARE(_completedNames.at(2), normalFile->name());
+	QCOMPARE(_completedNames.at(3), prefetchFile->name());
+}
+
+void TestPFTransferManager::test_cancelGroup()
+{
+	PFTransferManager* manager = PFTransferManager::sharedManager();
+	manager->setMaximumConcurrentUploads(1);
+
+	// Queue up a group of uploads alongside one that isn't in the group
+	QList<PFFilePtr> groupFiles;
+	for (int i = 0; i < 3; ++i)
+	{
+		PFFilePtr file = PFFile::fileWithNameAndData(QString("group_%1.txt").arg(i), uniqueData());
+		file->setTransferGroup("gallery");
+		file->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+		groupFiles.append(file);
+	}
+	PFFilePtr otherFile = PFFile::fileWithNameAndData("other.txt", uniqueData());
+	otherFile->saveInBackground(this, SLOT(saveCompleted(bool, PFErrorPtr)));
+	QCoreApplication::processEvents();
+	QCOMPARE(manager->activeCount() + manager->queuedCount(), 4);
+
+	// Cancel the group, both the running and the queued transfers should go away
+	manager->cancelGroup("gallery");
+	QCOMPARE(manager->activeCount() + manager->queuedCount(), 1);
+	foreach (PFFilePtr file, groupFiles)
+		QCOMPARE(file->isDirty(), true);
+
+	// The other file should still make it up
+	_expectedCount = 1;
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(saveEnded()), &eventLoop, SLOT(quit()));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_completedNames, QStringList() << otherFile->name());
+}
+
+void TestPFTransferManager::test_progressInterval()
+{
+	PFTransferManager* manager = PFTransferManager::sharedManager();
+	manager->setProgressInterval(50);
+	QCOMPARE(manager->progressInterval(), 50);
+
+	// Upload a file and make sure the final progress is always delivered
+	PFFilePtr file = PFFile::fileWithNameAndData("progress.txt", uniqueData());
+	file->saveInBackground(this, SLOT(saveProgressUpdated(double)), this, SLOT(saveCompleted(bool, PFErrorPtr)));
+	_expectedCount = 1;
+	QEventLoop eventLoop;
+	QObject::connect(this, SIGNAL(saveEnded()), &eventLoop, SLOT(quit()));
+	eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+	QCOMPARE(_progressCount >= 1, true);
+
+	manager->setProgressInterval(100);
+}
+
+DECLARE_TEST(TestPFTransferManager)
+#include "TestPFTransferManager.moc"
@@ -0,0 +1,246 @@
+//
+//  TestPFTypedObject.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFConversion.h"
+#include "PFDateTime.h"
+#include "PFTypedObject.h"
+#include "TestRunner.h"
+
+#include <QJsonObject>
+
+using namespace parse;
+
+class TypedGame : public PFTypedObject<TypedGame>
+{
+public:
+
+	static const char* typedClassName() { return "TypedGame"; }
+	static constexpr PFFieldDescriptor fields[] = { {"name"}, {"score"}, {"finished"}, {"startedAt"} };
+	typedef PFField<QString, 0> Name;
+	typedef PFField<int, 1> Score;
+	typedef PFField<bool, 2> Finished;
+	typedef PFField<PFDateTimePtr, 3> StartedAt;
+
+	QString name() { return valueForField<Name>(); }
+	void setName(const QString& name) { setValueForField<Name>(name); }
+	int score() { return valueForField<Score>(); }
+	void setScore(int score) { setValueForField<Score>(score); }
+	bool finished() { return valueForField<Finished>(); }
+	void setFinished(bool finished) { setValueForField<Finished>(finished); }
+	PFDateTimePtr startedAt() { return valueForField<StartedAt>(); }
+	void setStartedAt(PFDateTimePtr startedAt) { setValueForField<StartedAt>(startedAt); }
+
+protected:
+
+	friend class PFTypedObject<TypedGame>;
+	TypedGame() {}
+};
+
+constexpr PFFieldDescriptor TypedGame::fields[];
+
+typedef QSharedPointer<TypedGame> TypedGamePtr;
+
+class TestPFTypedObject : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase() {}
+	void cleanupTestCase() {}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init() {}
+	void cleanup()
+	{
+		PFObject::unregisterSubclassFactory(TypedGame::typedClassName());
+	}
+
+	// Creation Methods
+	void test_object();
+	void test_objectWithObjectId();
+
+	// Typed Field Methods
+	void test_fieldTable();
+	void test_typedFields();
+	void test_removeValueForField();
+
+	// Subclass Registration Methods
+	void test_registerSubclass();
+	void test_convertJsonToVariant();
+
+	void test_writeTypedFields();
+
+	// Benchmark Methods
+	void test_fieldAccessBenchmark_data();
+	void test_fieldAccessBenchmark();
+};
+
+void TestPFTypedObject::test_object()
+{
+	TypedGamePtr game = TypedGame::object();
+	QCOMPARE(game.isNull(), false);
+	QCOMPARE(game->className(), QString("TypedGame"));
+	QCOMPARE(game->objectId().isEmpty(), true);
+	QCOMPARE(game->allKeys().count(), 0);
+}
+
+void TestPFTypedObject::test_objectWithObjectId()
+{
+	TypedGamePtr game = TypedGame::objectWithObjectId("1234");
+	QCOMPARE(game->className(), QString("TypedGame"));
+	QCOMPARE(game->objectId(), QString("1234"));
+	QCOMPARE(TypedGame::objectWithObjectId("").isNull(), true);
+
+	// Round trip through a variant
+	QVariant variant = PFObject::toVariant(game);
+	QCOMPARE(TypedGame::objectFromVariant(variant), game);
+	QCOMPARE(TypedGame::objectFromVariant(PFObject::toVariant(PFObject::objectWithClassName("Other", "1234"))).isNull(), true);
+}
+
+void TestPFTypedObject::test_fieldTable()
+{
+	QCOMPARE(TypedGame::fieldCount(), 4);
+	QCOMPARE(TypedGame::fieldKey(TypedGame::Name::index), QString("name"));
+	QCOMPARE(TypedGame::fieldKey(TypedGame::StartedAt::index), QString("startedAt"));
+}
+
+void TestPFTypedObject::test_typedFields()
+{
+	TypedGamePtr game = TypedGame::object();
+
+	// Unset fields return default values
+	QCOMPARE(game->name(), QString());
+	QCOMPARE(game->score(), 0);
+	QCOMPARE(game->finished(), false);
+	QCOMPARE(game->startedAt().isNull(), true);
+
+	// Typed fields are ordinary properties underneath
+	PFDateTimePtr startedAt = PFDateTime::dateTimeFromParseString("2013-09-15T09:32:00.123Z");
+	game->setName("Chess");
+	game->setScore(42);
+	game->setFinished(true);
+	game->setStartedAt(startedAt);
+	QCOMPARE(game->name(), QString("Chess"));
+	QCOMPARE(game->score(), 42);
+	QCOMPARE(game->finished(), true);
+	QCOMPARE(game->startedAt(), startedAt);
+	QCOMPARE(game->objectForKey("name").toString(), QString("Chess"));
+	QCOMPARE(game->objectForKey("score").toInt(), 42);
+
+	// Numbers coming back from json are doubles and still convert
+	game->setObjectForKey(7.0, "score");
+	QCOMPARE(game->score(), 7);
+}
+
+void TestPFTypedObject::test_removeValueForField()
+{
+	TypedGamePtr game = TypedGame::object();
+	QCOMPARE(game->removeValueForField<TypedGame::Score>(), false);
+	game->setScore(1);
+	QCOMPARE(game->removeValueForField<TypedGame::Score>(), true);
+	QCOMPARE(game->allKeys().count(), 0);
+}
+
+void TestPFTypedObject::test_writeTypedFields()
+{
+	// Typed values only reach the properties once something reads them generically
+	TypedGamePtr game = TypedGame::objectWithObjectId("1234");
+	game->setScore(3);
+	game->setName("Go");
+	QJsonObject jsonObject;
+	QCOMPARE(game->toObjectJson(jsonObject), true);
+	QCOMPARE(jsonObject["score"].toDouble(), 3.0);
+	QCOMPARE(jsonObject["name"].toString(), QString("Go"));
+
+	// Generic changes show up in the typed accessors and the last write wins
+	game->setScore(4);
+	game->incrementKey("score");
+	QCOMPARE(game->score(), 5);
+	game->setObjectForKey(QString("Chess"), "name");
+	QCOMPARE(game->name(), QString("Chess"));
+	game->setName("Shogi");
+	QCOMPARE(game->objectForKey("name").toString(), QString("Shogi"));
+	QCOMPARE(game->allKeys().count(), 2);
+}
+
+void TestPFTypedObject::test_registerSubclass()
+{
+	// Not registered
+	PFObjectPtr object = PFObject::objectWithClassName(TypedGame::typedClassName());
+	QCOMPARE(object.dynamicCast<TypedGame>().isNull(), true);
+
+	// Registered
+	TypedGame::registerSubclass();
+	object = PFObject::objectWithClassName(TypedGame::typedClassName());
+	QCOMPARE(object.dynamicCast<TypedGame>().isNull(), false);
+	QCOMPARE(object->className(), QString("TypedGame"));
+	object = PFObject::objectWithClassName(TypedGame::typedClassName(), "1234");
+	QCOMPARE(object.dynamicCast<TypedGame>().isNull(), false);
+	QCOMPARE(object->objectId(), QString("1234"));
+
+	// Other classes are unaffected
+	QCOMPARE(PFObject::objectWithClassName("Other").dynamicCast<TypedGame>().isNull(), true);
+}
+
+void TestPFTypedObject::test_convertJsonToVariant()
+{
+	TypedGame::registerSubclass();
+
+	QJsonObject jsonObject;
+	jsonObject["__type"] = QString("Object");
+	jsonObject["className"] = QString("TypedGame");
+	jsonObject["objectId"] = QString("1234");
+	jsonObject["name"] = QString("Chess");
+	jsonObject["score"] = 12.0;
+
+	TypedGamePtr game = TypedGame::objectFromVariant(PFConversion::convertJsonToVariant(jsonObject));
+	QCOMPARE(game.isNull(), false);
+	QCOMPARE(game->objectId(), QString("1234"));
+	QCOMPARE(game->name(), QString("Chess"));
+	QCOMPARE(game->score(), 12);
+}
+
+void TestPFTypedObject::test_fieldAccessBenchmark_data()
+{
+	QTest::addColumn<bool>("typed");
+	QTest::newRow("typed") << true;
+	QTest::newRow("objectForKey") << false;
+}
+
+void TestPFTypedObject::test_fieldAccessBenchmark()
+{
+	QFETCH(bool, typed);
+	TypedGamePtr game = TypedGame::object();
+	game->setName("Chess");
+	game->setScore(42);
+
+	// Reads both fields and writes one of them back, the way a game loop or a list model would
+	int total = 0;
+	QBENCHMARK
+	{
+		for (int i = 0; i < 10000; ++i)
+		{
+			if (typed)
+			{
+				total += game->score() + game->name().size();
+				game->setScore(i);
+			}
+			else
+			{
+				total += game->objectForKey("score").toInt() + game->objectForKey("name").toString().size();
+				game->setObjectForKey(i, "score");
+			}
+		}
+	}
+	QVERIFY(total > 0);
+}
+
+DECLARE_TEST(TestPFTypedObject)
+#include "TestPFTypedObject.moc"
@@ -0,0 +1,163 @@
+//
+//  TestPFUploadIndex.cpp
+//  ParseTestSuite
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "PFUploadIndex.h"
+#include "TestRunner.h"
+
+#include <QBuffer>
+
+using namespace parse;
+
+class TestPFUploadIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+	// Class init and cleanup methods
+	void initTestCase()
+	{
+		_directory = QDir::temp();
+		_directory.mkdir("TestPFUploadIndex");
+		_directory.cd("TestPFUploadIndex");
+	}
+
+	void cleanupTestCase()
+	{
+		_directory.removeRecursively();
+	}
+
+	// Function init and cleanup methods (called before/after each test)
+	void init()
+	{
+		_uploadIndex = PFUploadIndex::uploadIndexWithDirectory(_directory);
+	}
+
+	void cleanup()
+	{
+		_uploadIndex->clear();
+		_uploadIndex = PFUploadIndexPtr();
+	}
+
+	// Creation Methods
+	void test_uploadIndexWithDirectory();
+	void test_hashForData();
+	void test_hashForDevice();
+
+	// Entry Methods
+	void test_lookup();
+	void test_lookupOtherApplication();
+	void test_removeUrl();
+
+	// Index Methods
+	void test_saveIndex();
+
+private:
+
+	// Instance members
+	QDir				_directory;
+	PFUploadIndexPtr	_uploadIndex;
+};
+
+void TestPFUploadIndex::test_uploadIndexWithDirectory()
+{
+	QCOMPARE(_uploadIndex.isNull(), false);
+	QCOMPARE(_uploadIndex->count(), 0);
+}
+
+void TestPFUploadIndex::test_hashForData()
+{
+	// SHA-256 of "abc"
+	QString hash = PFUploadIndex::hashForData(QByteArray("abc"));
+	QCOMPARE(hash, QString("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+	QCOMPARE(PFUploadIndex::hashForData(QByteArray("abd")) == hash, false);
+}
+
+void TestPFUploadIndex::test_hashForDevice()
+{
+	// Streaming the contents should give the same hash as hashing them all at once
+	QByteArray data(200 * 1024, 'x');
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::ReadOnly);
+	QCOMPARE(PFUploadIndex::hashForDevice(&buffer), PFUploadIndex::hashForData(data));
+}
+
+void TestPFUploadIndex::test_lookup()
+{
+	QString hash = PFUploadIndex::hashForData(QByteArray("lookup"));
+	QString name;
+	QString url;
+	QCOMPARE(_uploadIndex->lookup("app1", hash, "text/plain", name, url), false);
+
+	_uploadIndex->insert("app1", hash, "text/plain", "1234-lookup.txt", "http://files.parse.com/app/1234-lookup.txt");
+	QCOMPARE(_uploadIndex->lookup("app1", hash, "text/plain", name, url), true);
+	QCOMPARE(name, QString("1234-lookup.txt"));
+	QCOMPARE(url, QString("http://files.parse.com/app/1234-lookup.txt"));
+
+	// The same contents uploaded with another mime type aren't interchangeable
+	QCOMPARE(_uploadIndex->lookup("app1", hash, "application/json", name, url), false);
+}
+
+void TestPFUploadIndex::test_lookupOtherApplication()
+{
+	QString hash = PFUploadIndex::hashForData(QByteArray("application"));
+	QString name;
+	QString url;
+	_uploadIndex->insert("app1", hash, "text/plain", "1234-application.txt", "http://files.parse.com/app1/1234-application.txt");
+
+	// After switching apps the upload made by the first one isn't reused
+	QCOMPARE(_uploadIndex->lookup("app2", hash, "text/plain", name, url), false);
+	QCOMPARE(name.isEmpty(), true);
+	QCOMPARE(url.isEmpty(), true);
+
+	// Each app keeps its own upload of the same contents
+	_uploadIndex->insert("app2", hash, "text/plain", "5678-application.txt", "http://files.parse.com/app2/5678-application.txt");
+	QCOMPARE(_uploadIndex->count(), 2);
+	QCOMPARE(_uploadIndex->lookup("app2", hash, "text/plain", name, url), true);
+	QCOMPARE(url, QString("http://files.parse.com/app2/5678-application.txt"));
+	QCOMPARE(_uploadIndex->lookup("app1", hash, "text/plain", name, url), true);
+	QCOMPARE(url, QString("http://files.parse.com/app1/1234-application.txt"));
+
+	// Switching back and forth survives a reload as well
+	_uploadIndex->saveIndex();
+	PFUploadIndexPtr reloadedIndex = PFUploadIndex::uploadIndexWithDirectory(_directory);
+	QCOMPARE(reloadedIndex->lookup("app2", hash, "text/plain", name, url), true);
+	QCOMPARE(url, QString("http://files.parse.com/app2/5678-application.txt"));
+	QCOMPARE(reloadedIndex->lookup("app3", hash, "text/plain", name, url), false);
+}
+
+void TestPFUploadIndex::test_removeUrl()
+{
+	QString hash = PFUploadIndex::hashForData(QByteArray("remove"));
+	_uploadIndex->insert("app1", hash, "text/plain", "1234-remove.txt", "http://files.parse.com/app/1234-remove.txt");
+	QCOMPARE(_uploadIndex->count(), 1);
+
+	_uploadIndex->removeUrl("http://files.parse.com/app/1234-remove.txt");
+	QCOMPARE(_uploadIndex->count(), 0);
+	QString name;
+	QString url;
+	QCOMPARE(_uploadIndex->lookup("app1", hash, "text/plain", name, url), false);
+}
+
+void TestPFUploadIndex::test_saveIndex()
+{
+	QString hash = PFUploadIndex::hashForData(QByteArray("save"));
+	_uploadIndex->insert("app1", hash, "text/plain", "1234-save.txt", "http://files.parse.com/app/1234-save.txt");
+	_uploadIndex->saveIndex();
+
+	// A new index on the same directory should pick the entry back up
+	PFUploadIndexPtr reloadedIndex = PFUploadIndex::uploadIndexWithDirectory(_directory);
+	QString name;
+	QString url;
+	QCOMPARE(reloadedIndex->count(), 1);
+	QCOMPARE(reloadedIndex->lookup("app1", hash, "text/plain", name, url), true);
+	QCOMPARE(url, QString("http://files.parse.com/app/1234-save.txt"));
+}
+
+DECLARE_TEST(TestPFUploadIndex)
+#include "TestPFUploadIndex.moc"